@@ -0,0 +1,213 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Color used as the key of the mask benchmark
+///
+////////////////////////////////////////////////////////////
+const sf::Color maskColor(85, 170, 0, 255);
+
+
+////////////////////////////////////////////////////////////
+/// Scalar alpha blending, as Image::copy used to do it
+///
+////////////////////////////////////////////////////////////
+void referenceBlend(std::vector<sf::Uint8>& pixels, const sf::Uint8* source, unsigned int width, unsigned int height)
+{
+    for (std::size_t i = 0; i < width * height; ++i)
+    {
+        const sf::Uint8* src = source + i * 4;
+        sf::Uint8*       dst = &pixels[i * 4];
+
+        sf::Uint8 alpha = src[3];
+        dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
+        dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
+        dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
+        dst[3] = alpha + dst[3] * (255 - alpha) / 255;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Scalar color keying, as Image::createMaskFromColor used to do it
+///
+////////////////////////////////////////////////////////////
+void referenceMask(std::vector<sf::Uint8>& pixels, const sf::Uint8*, unsigned int, unsigned int)
+{
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        sf::Uint8* ptr = &pixels[i];
+        if ((ptr[0] == maskColor.r) && (ptr[1] == maskColor.g) && (ptr[2] == maskColor.b) && (ptr[3] == maskColor.a))
+            ptr[3] = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Scalar horizontal flip, as Image::flipHorizontally used to do it
+///
+////////////////////////////////////////////////////////////
+void referenceFlipHorizontally(std::vector<sf::Uint8>& pixels, const sf::Uint8*, unsigned int width, unsigned int height)
+{
+    std::size_t rowSize = width * 4;
+
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        std::vector<sf::Uint8>::iterator left = pixels.begin() + y * rowSize;
+        std::vector<sf::Uint8>::iterator right = pixels.begin() + (y + 1) * rowSize - 4;
+
+        for (std::size_t x = 0; x < width / 2; ++x)
+        {
+            std::swap_ranges(left, left + 4, right);
+
+            left += 4;
+            right -= 4;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Scalar vertical flip, as Image::flipVertically used to do it
+///
+////////////////////////////////////////////////////////////
+void referenceFlipVertically(std::vector<sf::Uint8>& pixels, const sf::Uint8*, unsigned int width, unsigned int height)
+{
+    std::size_t rowSize = width * 4;
+
+    std::vector<sf::Uint8>::iterator top = pixels.begin();
+    std::vector<sf::Uint8>::iterator bottom = pixels.end() - rowSize;
+
+    for (std::size_t y = 0; y < height / 2; ++y)
+    {
+        std::swap_ranges(top, top + rowSize, bottom);
+
+        top += rowSize;
+        bottom -= rowSize;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// The same operations through sf::Image
+///
+////////////////////////////////////////////////////////////
+void imageBlend(sf::Image& image, const sf::Image& source)
+{
+    image.copy(source, 0, 0, sf::IntRect(), true);
+}
+
+void imageMask(sf::Image& image, const sf::Image&)
+{
+    image.createMaskFromColor(maskColor);
+}
+
+void imageFlipHorizontally(sf::Image& image, const sf::Image&)
+{
+    image.flipHorizontally();
+}
+
+void imageFlipVertically(sf::Image& image, const sf::Image&)
+{
+    image.flipVertically();
+}
+
+
+////////////////////////////////////////////////////////////
+/// Fill an image with pseudo-random pixels
+///
+/// Components are restricted to a few values if \a palette
+/// is true, so that some pixels match the mask color.
+///
+////////////////////////////////////////////////////////////
+void fillImage(sf::Image& image, unsigned int size, bool palette)
+{
+    std::vector<sf::Uint8> pixels(size * size * 4);
+    for (std::size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = static_cast<sf::Uint8>(palette ? (std::rand() % 4) * 85 : std::rand() % 256);
+
+    // Opaque destination pixels
+    if (palette)
+    {
+        for (std::size_t i = 3; i < pixels.size(); i += 4)
+            pixels[i] = 255;
+    }
+
+    image.create(size, size, &pixels[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Measures the throughput of the sf::Image pixel operations
+/// against the scalar loops they replaced, and checks that
+/// both produce the same pixels.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    typedef void (*ReferenceFunction)(std::vector<sf::Uint8>&, const sf::Uint8*, unsigned int, unsigned int);
+    typedef void (*ImageFunction)(sf::Image&, const sf::Image&);
+
+    const char*       names[]      = {"copy with alpha", "createMaskFromColor", "flipHorizontally", "flipVertically"};
+    ReferenceFunction references[] = {referenceBlend, referenceMask, referenceFlipHorizontally, referenceFlipVertically};
+    ImageFunction     functions[]  = {imageBlend, imageMask, imageFlipHorizontally, imageFlipVertically};
+    const unsigned int sizes[]     = {256, 1024, 4096};
+
+    bool identical = true;
+
+    for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+    {
+        unsigned int size = sizes[s];
+        std::size_t pixelCount = size * size;
+        int repeatCount = static_cast<int>(std::max<std::size_t>(64 * 1024 * 1024 / pixelCount, 4));
+
+        sf::Image source;
+        sf::Image destination;
+        fillImage(source, size, false);
+        fillImage(destination, size, true);
+
+        std::cout << size << "x" << size << " pixels, " << repeatCount << " runs" << std::endl;
+
+        for (std::size_t f = 0; f < sizeof(names) / sizeof(*names); ++f)
+        {
+            // Run the scalar loop on a copy of the pixels
+            std::vector<sf::Uint8> pixels(destination.getPixelsPtr(), destination.getPixelsPtr() + pixelCount * 4);
+            sf::Clock clock;
+            for (int i = 0; i < repeatCount; ++i)
+                references[f](pixels, source.getPixelsPtr(), size, size);
+            float referenceTime = clock.getElapsedTime().asSeconds();
+
+            // Run the same operation on a copy of the image
+            sf::Image image(destination);
+            clock.restart();
+            for (int i = 0; i < repeatCount; ++i)
+                functions[f](image, source);
+            float imageTime = clock.getElapsedTime().asSeconds();
+
+            bool same = std::memcmp(&pixels[0], image.getPixelsPtr(), pixels.size()) == 0;
+            identical = identical && same;
+
+            float megapixels = pixelCount * repeatCount / 1000000.f;
+            std::cout << "  " << names[f] << ": "
+                      << megapixels / referenceTime << " Mpx/s before, "
+                      << megapixels / imageTime << " Mpx/s now (x"
+                      << referenceTime / imageTime << ")"
+                      << (same ? "" : " - results differ!") << std::endl;
+        }
+    }
+
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
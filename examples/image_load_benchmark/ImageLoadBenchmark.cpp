@@ -0,0 +1,126 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Number of times each set of files is loaded, the fastest
+/// run being kept
+///
+////////////////////////////////////////////////////////////
+const int runCount = 5;
+
+
+////////////////////////////////////////////////////////////
+/// Get the size of a file
+///
+////////////////////////////////////////////////////////////
+std::size_t getFileSize(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios_base::binary | std::ios_base::ate);
+    return file ? static_cast<std::size_t>(file.tellg()) : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Load all the files of a list, and return the time taken
+/// by the fastest of several runs
+///
+////////////////////////////////////////////////////////////
+float loadFiles(const std::vector<std::string>& filenames, std::vector<sf::Image>& images)
+{
+    float bestTime = 0.f;
+    for (int run = 0; run < runCount; ++run)
+    {
+        sf::Clock clock;
+        for (std::size_t i = 0; i < filenames.size(); ++i)
+            images[i].loadFromFile(filenames[i]);
+        float time = clock.getElapsedTime().asSeconds();
+
+        if ((run == 0) || (time < bestTime))
+            bestTime = time;
+    }
+
+    return bestTime;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Converts the image files given on the command line to
+/// QOI, then compares the time taken to load the original
+/// files and their QOI versions, and checks that both give
+/// the same pixels.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: image_load_benchmark image1.png [image2.png ...]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Convert the images to QOI, in the working directory
+    std::vector<std::string> originals;
+    std::vector<std::string> converted;
+    std::size_t originalSize = 0;
+    std::size_t convertedSize = 0;
+    std::size_t pixelCount = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        sf::Image image;
+        if (!image.loadFromFile(argv[i]))
+            return EXIT_FAILURE;
+
+        std::ostringstream name;
+        name << "image_load_benchmark_" << i << ".qoi";
+        if (!image.saveToFile(name.str()))
+            return EXIT_FAILURE;
+
+        originals.push_back(argv[i]);
+        converted.push_back(name.str());
+        originalSize += getFileSize(argv[i]);
+        convertedSize += getFileSize(name.str());
+        pixelCount += image.getSize().x * image.getSize().y;
+    }
+
+    // Load both sets of files
+    std::vector<sf::Image> originalImages(originals.size());
+    std::vector<sf::Image> convertedImages(converted.size());
+    float originalTime = loadFiles(originals, originalImages);
+    float convertedTime = loadFiles(converted, convertedImages);
+
+    bool identical = true;
+    for (std::size_t i = 0; i < originals.size(); ++i)
+    {
+        const sf::Vector2u size = originalImages[i].getSize();
+        identical = identical && (convertedImages[i].getSize() == size) &&
+                    (std::memcmp(originalImages[i].getPixelsPtr(), convertedImages[i].getPixelsPtr(), size.x * size.y * 4) == 0);
+
+        std::remove(converted[i].c_str());
+    }
+
+    float megapixels = pixelCount / 1000000.f;
+    std::cout << originals.size() << " files, " << megapixels << " Mpx, best of " << runCount << " runs" << std::endl;
+    std::cout << "  original: " << originalSize / 1024 << " KB, "
+              << originalTime * 1000.f << " ms (" << megapixels / originalTime << " Mpx/s)" << std::endl;
+    std::cout << "  QOI:      " << convertedSize / 1024 << " KB, "
+              << convertedTime * 1000.f << " ms (" << megapixels / convertedTime << " Mpx/s, x"
+              << originalTime / convertedTime << ")" << (identical ? "" : " - pixels differ!") << std::endl;
+
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
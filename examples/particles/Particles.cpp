@@ -0,0 +1,249 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+
+////////////////////////////////////////////////////////////
+/// Emitter spawning particles in all directions from a point
+///
+////////////////////////////////////////////////////////////
+class Fountain : public sf::ParticleEmitter
+{
+public:
+
+    Fountain(float rate) :
+    m_rate    (rate),
+    m_pending (0),
+    m_position(0, 0)
+    {
+    }
+
+    void setPosition(sf::Vector2f position)
+    {
+        m_position = position;
+    }
+
+    virtual void emit(sf::ParticleSystem& system, sf::Time elapsed)
+    {
+        // Accumulate the fractional part so that the rate doesn't depend on the frame rate
+        m_pending += m_rate * elapsed.asSeconds();
+
+        sf::ParticleSystem::Particle particle;
+        particle.position = m_position;
+        particle.size = 8;
+
+        for (; m_pending >= 1; m_pending -= 1)
+        {
+            float angle = (std::rand() % 3600) * 3.141592654f / 1800.f;
+            float speed = 50.f + std::rand() % 250;
+
+            particle.velocity = sf::Vector2f(std::cos(angle) * speed, std::sin(angle) * speed);
+            particle.rotationSpeed = static_cast<float>(std::rand() % 720 - 360);
+            particle.color = sf::Color(255, 128 + std::rand() % 128, std::rand() % 128);
+            particle.lifetime = sf::milliseconds(1000 + std::rand() % 2000);
+            system.addParticle(particle);
+        }
+    }
+
+private:
+
+    float        m_rate;
+    float        m_pending;
+    sf::Vector2f m_position;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Affector pulling the particles down
+///
+////////////////////////////////////////////////////////////
+class Gravity : public sf::ParticleAffector
+{
+public:
+
+    virtual void affect(const sf::ParticleSystem::Arrays& particles, std::size_t begin, std::size_t end, sf::Time elapsed) const
+    {
+        float delta = 200.f * elapsed.asSeconds();
+        for (std::size_t i = begin; i < end; ++i)
+            particles.velocities[i].y += delta;
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+/// Affector fading the particles out as they get older
+///
+////////////////////////////////////////////////////////////
+class FadeOut : public sf::ParticleAffector
+{
+public:
+
+    virtual void affect(const sf::ParticleSystem::Arrays& particles, std::size_t begin, std::size_t end, sf::Time) const
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            float ratio = 1.f - particles.ages[i] / particles.lifetimes[i];
+            particles.colors[i].a = static_cast<sf::Uint8>(255 * (ratio > 0 ? ratio : 0));
+        }
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+/// Measure the update throughput for several thread counts
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int benchmark()
+{
+    const std::size_t particleCount = 1000000;
+    const int updateCount = 100;
+    const unsigned int threadCounts[] = {1, 2, 4, 8, 0};
+
+    Gravity gravity;
+    FadeOut fadeOut;
+
+    std::cout << "Updating " << particleCount << " particles " << updateCount << " times" << std::endl;
+
+    for (std::size_t i = 0; i < sizeof(threadCounts) / sizeof(*threadCounts); ++i)
+    {
+        // Fill the system with particles that outlive the benchmark
+        sf::ParticleSystem system;
+        system.addAffector(gravity);
+        system.addAffector(fadeOut);
+        system.setThreadCount(threadCounts[i]);
+        system.reserve(particleCount);
+
+        sf::ParticleSystem::Particle particle;
+        particle.lifetime = sf::seconds(1000);
+        for (std::size_t j = 0; j < particleCount; ++j)
+        {
+            particle.velocity = sf::Vector2f(static_cast<float>(j % 100), static_cast<float>(j % 37));
+            system.addParticle(particle);
+        }
+
+        sf::Clock clock;
+        for (int j = 0; j < updateCount; ++j)
+            system.update(sf::milliseconds(16));
+        float milliseconds = clock.getElapsedTime().asMicroseconds() / 1000.f;
+
+        std::cout << "  ";
+        if (threadCounts[i] == 0)
+            std::cout << "one thread per processor";
+        else
+            std::cout << threadCounts[i] << (threadCounts[i] == 1 ? " thread" : " threads");
+        std::cout << ": " << static_cast<std::size_t>(particleCount * updateCount / milliseconds) << " particles/ms" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Pass --benchmark to measure the update throughput
+/// instead of opening a window.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    if ((argc > 1) && (std::strcmp(argv[1], "--benchmark") == 0))
+        return benchmark();
+
+    // Create the window of the application
+    sf::RenderWindow window(sf::VideoMode(800, 600), "SFML Particles", sf::Style::Titlebar | sf::Style::Close);
+    window.setVerticalSyncEnabled(true);
+
+    // Create a soft round texture for the particles
+    const unsigned int textureSize = 32;
+    sf::Image image;
+    image.create(textureSize, textureSize, sf::Color::White);
+    for (unsigned int y = 0; y < textureSize; ++y)
+    {
+        for (unsigned int x = 0; x < textureSize; ++x)
+        {
+            float dx = (x + 0.5f) / textureSize * 2 - 1;
+            float dy = (y + 0.5f) / textureSize * 2 - 1;
+            float alpha = 1.f - std::sqrt(dx * dx + dy * dy);
+            image.setPixel(x, y, sf::Color(255, 255, 255, static_cast<sf::Uint8>(255 * (alpha > 0 ? alpha : 0))));
+        }
+    }
+    sf::Texture texture;
+    if (!texture.loadFromImage(image))
+        return EXIT_FAILURE;
+    texture.setSmooth(true);
+
+    // Create the particle system
+    Fountain fountain(50000);
+    Gravity gravity;
+    FadeOut fadeOut;
+
+    sf::ParticleSystem particles;
+    particles.setTexture(texture);
+    particles.addEmitter(fountain);
+    particles.addAffector(gravity);
+    particles.addAffector(fadeOut);
+    particles.setThreadCount(0);
+
+    sf::Clock clock;
+    sf::Clock titleClock;
+    while (window.isOpen())
+    {
+        // Process events
+        sf::Event event;
+        while (window.pollEvent(event))
+        {
+            // Close window: exit
+            if ((event.type == sf::Event::Closed) ||
+               ((event.type == sf::Event::KeyPressed) && (event.key.code == sf::Keyboard::Escape)))
+            {
+                window.close();
+                break;
+            }
+
+            // Number keys: change the number of threads, 0 for one per processor
+            if ((event.type == sf::Event::KeyPressed) && (event.key.code >= sf::Keyboard::Num0) && (event.key.code <= sf::Keyboard::Num9))
+                particles.setThreadCount(event.key.code - sf::Keyboard::Num0);
+        }
+
+        // Move the fountain to the mouse cursor
+        fountain.setPosition(window.mapPixelToCoords(sf::Mouse::getPosition(window)));
+
+        // Update the particles and measure how long it takes
+        sf::Clock updateClock;
+        particles.update(clock.restart());
+        float milliseconds = updateClock.getElapsedTime().asMicroseconds() / 1000.f;
+
+        // Show the statistics in the title bar twice per second
+        if (titleClock.getElapsedTime() > sf::milliseconds(500))
+        {
+            std::ostringstream title;
+            title << "SFML Particles - " << particles.getParticleCount() << " particles, ";
+            if (particles.getThreadCount() == 0)
+                title << "one thread per processor";
+            else
+                title << particles.getThreadCount() << (particles.getThreadCount() == 1 ? " thread" : " threads");
+            if (milliseconds > 0)
+                title << ", " << static_cast<std::size_t>(particles.getParticleCount() / milliseconds) << " particles/ms";
+            window.setTitle(title.str());
+            titleClock.restart();
+        }
+
+        window.clear();
+        window.draw(particles, sf::BlendAdd);
+        window.display();
+    }
+
+    return EXIT_SUCCESS;
+}
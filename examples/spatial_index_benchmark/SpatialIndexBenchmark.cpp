@@ -0,0 +1,173 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Size of the square world where the objects are placed
+///
+////////////////////////////////////////////////////////////
+const float worldSize = 4096.f;
+
+
+////////////////////////////////////////////////////////////
+/// Number of queries run for each test
+///
+////////////////////////////////////////////////////////////
+const int queryCount = 10000;
+
+
+////////////////////////////////////////////////////////////
+/// Get a pseudo-random number in [0, max)
+///
+////////////////////////////////////////////////////////////
+float random(float max)
+{
+    return static_cast<float>(std::rand()) / (static_cast<float>(RAND_MAX) + 1.f) * max;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Find the rectangles intersecting a region by testing all
+/// of them, as done before sf::SpatialIndex
+///
+////////////////////////////////////////////////////////////
+void linearQuery(const std::vector<sf::FloatRect>& rects, const sf::FloatRect& region, std::vector<std::size_t>& results)
+{
+    for (std::size_t i = 0; i < rects.size(); ++i)
+    {
+        if (rects[i].intersects(region))
+            results.push_back(i);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Find the rectangles containing a point by testing all
+/// of them, as done before sf::SpatialIndex
+///
+////////////////////////////////////////////////////////////
+void linearQuery(const std::vector<sf::FloatRect>& rects, const sf::Vector2f& point, std::vector<std::size_t>& results)
+{
+    for (std::size_t i = 0; i < rects.size(); ++i)
+    {
+        if (rects[i].contains(point))
+            results.push_back(i);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Run the same queries with a linear scan and with the
+/// spatial index, print the throughput of both and return
+/// true if they found the same objects
+///
+////////////////////////////////////////////////////////////
+template <typename Q>
+bool compareQueries(const char* name, const std::vector<Q>& queries, const std::vector<sf::FloatRect>& rects,
+                    const sf::SpatialIndex<std::size_t>& index)
+{
+    std::vector<std::size_t> results;
+    std::vector<sf::SpatialIndex<std::size_t>::Id> ids;
+
+    // Linear scan, counting the objects found to check the index against it
+    std::vector<std::size_t> linearCounts(queries.size());
+    sf::Clock clock;
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        results.clear();
+        linearQuery(rects, queries[i], results);
+        linearCounts[i] = results.size();
+    }
+    float linearTime = clock.getElapsedTime().asSeconds();
+
+    // Spatial index
+    std::vector<std::size_t> indexCounts(queries.size());
+    clock.restart();
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        ids.clear();
+        index.query(queries[i], ids);
+        indexCounts[i] = ids.size();
+    }
+    float indexTime = clock.getElapsedTime().asSeconds();
+
+    // Check the objects found, outside of the timed loops
+    bool identical = linearCounts == indexCounts;
+    for (std::size_t i = 0; identical && (i < queries.size()); ++i)
+    {
+        results.clear();
+        linearQuery(rects, queries[i], results);
+
+        ids.clear();
+        index.query(queries[i], ids);
+        for (std::size_t j = 0; j < ids.size(); ++j)
+            ids[j] = index[ids[j]];
+        std::sort(ids.begin(), ids.end());
+
+        identical = results == ids;
+    }
+
+    std::cout << "  " << name << ": "
+              << queries.size() / linearTime / 1000.f << " kq/s linear, "
+              << queries.size() / indexTime / 1000.f << " kq/s indexed (x"
+              << linearTime / indexTime << ")"
+              << (identical ? "" : " - results differ!") << std::endl;
+
+    return identical;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Measures the throughput of sf::SpatialIndex region and
+/// point queries against a linear scan of all the objects,
+/// and checks that both find the same objects.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    const std::size_t objectCounts[] = {1000, 10000, 100000};
+
+    // Regions about the size of a view, and random points
+    std::vector<sf::FloatRect> regions(queryCount);
+    std::vector<sf::Vector2f> points(queryCount);
+    for (int i = 0; i < queryCount; ++i)
+    {
+        regions[i] = sf::FloatRect(random(worldSize), random(worldSize), 128.f + random(256.f), 128.f + random(256.f));
+        points[i] = sf::Vector2f(random(worldSize), random(worldSize));
+    }
+
+    bool identical = true;
+
+    for (std::size_t c = 0; c < sizeof(objectCounts) / sizeof(*objectCounts); ++c)
+    {
+        std::size_t objectCount = objectCounts[c];
+
+        // Small objects spread over the world, with a few large ones
+        std::vector<sf::FloatRect> rects(objectCount);
+        sf::SpatialIndex<std::size_t> index(sf::FloatRect(0.f, 0.f, worldSize, worldSize), 7);
+        for (std::size_t i = 0; i < objectCount; ++i)
+        {
+            float size = (i % 100 == 0) ? 256.f + random(512.f) : 4.f + random(32.f);
+            rects[i] = sf::FloatRect(random(worldSize), random(worldSize), size, size);
+            index.insert(rects[i], i);
+        }
+
+        std::cout << objectCount << " objects, " << queryCount << " queries" << std::endl;
+
+        identical = compareQueries("region queries", regions, rects, index) && identical;
+        identical = compareQueries("point queries", points, rects, index) && identical;
+    }
+
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
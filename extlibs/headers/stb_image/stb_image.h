@@ -838,8 +838,17 @@ static stbi_uc *stbi__pnm_load(stbi__context *s, int *x, int *y, int *comp, int
 static int      stbi__pnm_info(stbi__context *s, int *x, int *y, int *comp);
 #endif
 
-// this is not threadsafe
-static const char *stbi__g_failure_reason;
+// thread-local so that images can be decoded concurrently (backported from later stb_image versions)
+#ifndef STBI_THREAD_LOCAL
+   #if defined(_MSC_VER)
+      #define STBI_THREAD_LOCAL __declspec(thread)
+   #elif defined(__GNUC__) || defined(__clang__)
+      #define STBI_THREAD_LOCAL __thread
+   #else
+      #define STBI_THREAD_LOCAL
+   #endif
+#endif
+static STBI_THREAD_LOCAL const char *stbi__g_failure_reason;
 
 STBIDEF const char *stbi_failure_reason(void)
 {
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Shape.hpp>
+#include <vector>
 
 
 namespace sf
@@ -111,8 +112,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float       m_radius;     ///< Radius of the circle
-    std::size_t m_pointCount; ///< Number of points composing the circle
+    float                        m_radius;     ///< Radius of the circle
+    std::size_t                  m_pointCount; ///< Number of points composing the circle
+    const std::vector<Vector2f>* m_unitPoints; ///< Points of a circle of radius 1 centered on the origin, shared by all the circles with the same point count
 };
 
 } // namespace sf
@@ -34,7 +34,7 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
-#include <map>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -179,6 +179,101 @@ public:
     ////////////////////////////////////////////////////////////
     const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness = 0) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the signed distance field version of a glyph
+    ///
+    /// Distance field glyphs are rendered once, at the reference
+    /// size returned by getDistanceFieldSize, and can then be
+    /// displayed at any size with a shader that thresholds the
+    /// distance to the glyph edges (this is what sf::Text does
+    /// when its distance field mode is enabled).
+    ///
+    /// The alpha channel of the glyph pixels holds the distance
+    /// to the nearest edge: 0.5 on the edge, growing to 1 inside
+    /// the glyph and falling to 0 outside, over a distance of
+    /// getDistanceFieldSpread() pixels. Both the texture rectangle
+    /// and the bounds of the returned glyph include a margin of
+    /// this size around the glyph, so that outlines and shadows
+    /// can be derived from the field.
+    ///
+    /// All the metrics of the returned glyph are expressed in
+    /// pixels at the reference size.
+    ///
+    /// \param codePoint Unicode code point of the character to get
+    /// \param bold      Retrieve the bold version or the regular one?
+    ///
+    /// \return The distance field glyph corresponding to \a codePoint
+    ///
+    /// \see getDistanceFieldSize, getDistanceFieldSpread
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& getDistanceFieldGlyph(Uint32 codePoint, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size at which distance field glyphs are rendered
+    ///
+    /// \return Reference character size of the distance field glyphs, in pixels
+    ///
+    /// \see getDistanceFieldGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getDistanceFieldSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the range of the distances stored in distance field glyphs
+    ///
+    /// \return Distance, in pixels at the reference size, over which the field goes from the glyph edge to 0
+    ///
+    /// \see getDistanceFieldGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    float getDistanceFieldSpread() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs into the texture in advance
+    ///
+    /// This function renders the glyphs of all the characters in
+    /// \a characters, at all the sizes in \a sizes, so that texts
+    /// using them don't have to load them one by one while they
+    /// are being displayed (typically during the first frames).
+    ///
+    /// Glyphs are rasterized in parallel on \a threadCount threads,
+    /// each one using its own copy of the font face, and then
+    /// packed into the glyph texture, which is updated only once.
+    /// Fonts loaded from a stream can't be opened again by the
+    /// worker threads; their glyphs are rasterized on the calling
+    /// thread, but still uploaded in a single texture update.
+    ///
+    /// Glyphs which are already in the texture are skipped.
+    ///
+    /// \param characters       Characters to load
+    /// \param sizes            Array of character sizes to load the characters at
+    /// \param sizeCount        Number of elements in \a sizes
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    /// \param threadCount      Number of threads to use (0 to use one per processor)
+    ///
+    /// \see preloadDistanceField, getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preload(const String& characters, const unsigned int* sizes, std::size_t sizeCount, bool bold = false, float outlineThickness = 0, unsigned int threadCount = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of distance field glyphs into the texture in advance
+    ///
+    /// This function works like preload, but for the glyphs
+    /// returned by getDistanceFieldGlyph, which are much more
+    /// expensive to compute than regular glyphs.
+    ///
+    /// \param characters  Characters to load
+    /// \param bold        Load the bold version or the regular one?
+    /// \param threadCount Number of threads to use (0 to use one per processor)
+    ///
+    /// \see preload, getDistanceFieldGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadDistanceField(const String& characters, bool bold = false, unsigned int threadCount = 0) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the kerning offset of two glyphs
     ///
@@ -197,6 +292,26 @@ public:
     ////////////////////////////////////////////////////////////
     float getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the kerning offsets of a whole run of characters
+    ///
+    /// This function fills \a kernings with the kerning offset
+    /// to apply before each character of the run: kernings[0]
+    /// is always 0 and kernings[i] is the kerning between
+    /// codePoints[i - 1] and codePoints[i]. It gives the same
+    /// results as calling getKerning for each pair, but is
+    /// more efficient when laying out a full line of text.
+    ///
+    /// \param codePoints    Array of Unicode code points
+    /// \param count         Number of code points in the array
+    /// \param kernings      Array of \a count floats to fill with the kerning offsets
+    /// \param characterSize Reference character size
+    ///
+    /// \see getKerning
+    ///
+    ////////////////////////////////////////////////////////////
+    void getKerningRun(const Uint32* codePoints, std::size_t count, float* kernings, unsigned int characterSize) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the line spacing
     ///
@@ -246,6 +361,9 @@ public:
     /// are requested, thus it is not very relevant. It is mainly
     /// used internally by sf::Text.
     ///
+    /// All the character sizes share the same texture, so the
+    /// same texture is returned whatever \a characterSize is.
+    ///
     /// \param characterSize Reference character size
     ///
     /// \return Texture containing the glyphs of the requested size
@@ -253,6 +371,103 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum amount of memory used by the glyph texture
+    ///
+    /// The glyph texture grows as new glyphs are requested. Once
+    /// it has reached this limit, glyphs that have not been used
+    /// for a while are evicted to make room for the new ones
+    /// (see setGlyphEvictionDelay). A limit of 0 (the default)
+    /// means that the texture can grow up to the maximum
+    /// texture size supported by the graphics driver
+    /// (Texture::getMaximumSize()), which may be as large as
+    /// 16384x16384 pixels, or 1 GB, for fonts used with a lot
+    /// of different characters and sizes. Set a limit if your
+    /// application renders many glyphs and memory matters.
+    ///
+    /// The font also keeps a copy of the alpha channel of the
+    /// texture in system memory, to be able to move the glyphs
+    /// around when evicting; it takes an additional byte per
+    /// pixel, which is not counted in the limit.
+    ///
+    /// The texture is always square and its size a power of
+    /// two, so the actual limit is the biggest such texture
+    /// that fits in \a bytes (but never less than 128x128).
+    ///
+    /// \param bytes Maximum size of the glyph texture, in bytes (4 bytes per pixel)
+    ///
+    /// \see getTextureMemoryLimit, setGlyphEvictionDelay
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureMemoryLimit(std::size_t bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum amount of memory used by the glyph texture
+    ///
+    /// \return Maximum size of the glyph texture, in bytes (0 means no limit)
+    ///
+    /// \see setTextureMemoryLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTextureMemoryLimit() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of frames after which an unused glyph can be evicted
+    ///
+    /// When the glyph texture is full, glyphs that have not been
+    /// requested during the last \a frames frames are removed
+    /// from it first. If this is not enough, all the glyphs not
+    /// requested during the current frame are removed. Evicted
+    /// glyphs are loaded again the next time they are requested.
+    ///
+    /// Frames are counted by calls to advanceFrame.
+    /// The default delay is 60 frames.
+    ///
+    /// \param frames Number of frames a glyph must stay unused before it can be evicted
+    ///
+    /// \see getGlyphEvictionDelay, advanceFrame
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGlyphEvictionDelay(unsigned int frames);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames after which an unused glyph can be evicted
+    ///
+    /// \return Number of frames a glyph must stay unused before it can be evicted
+    ///
+    /// \see setGlyphEvictionDelay
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getGlyphEvictionDelay() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell the font that a new frame starts
+    ///
+    /// The font uses the frame count to know which glyphs have
+    /// not been used recently. Call this function once per
+    /// frame if you use a texture memory limit; otherwise
+    /// calling it is harmless but unnecessary.
+    ///
+    /// \see setGlyphEvictionDelay
+    ///
+    ////////////////////////////////////////////////////////////
+    void advanceFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current generation of the glyph texture
+    ///
+    /// The generation changes every time glyphs are evicted from
+    /// the texture, which moves the remaining glyphs and
+    /// invalidates their previous texture rectangles. Classes
+    /// that store texture coordinates of glyphs, like sf::Text,
+    /// compare it with the value they had when they built their
+    /// geometry to know whether they must rebuild it.
+    ///
+    /// \return Generation of the glyph texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getTextureGeneration() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -266,22 +481,148 @@ public:
 private:
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
+    /// \brief Structure defining a horizontal segment of the skyline
+    ///
+    /// The skyline is the top outline of the glyphs packed into the
+    /// texture; its segments cover the whole texture width, from
+    /// left to right.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SkylineNode
+    {
+        SkylineNode(unsigned int nodeX, unsigned int nodeY, unsigned int nodeWidth) : x(nodeX), y(nodeY), width(nodeWidth) {}
+
+        unsigned int x;     ///< Left position of the segment
+        unsigned int y;     ///< Height of the skyline over the segment
+        unsigned int width; ///< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a glyph stored in the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CachedGlyph
+    {
+        CachedGlyph() : lastUse(0), resident(false) {}
+
+        Glyph  glyph;    ///< The glyph itself
+        Uint64 lastUse;  ///< Last frame during which the glyph was requested
+        bool   resident; ///< Is the glyph loaded in the texture? (false if it was evicted or never loaded)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open-addressing hash table with stable value storage
+    ///
+    /// Keys live in a flat, linearly probed slot array; values
+    /// are stored in a deque so that references returned to
+    /// the user stay valid when the table grows.
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    class HashTable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        HashTable();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Find the index of the value stored under a key
+        ///
+        /// \param key Key to look for
+        ///
+        /// \return Index of the value, or NotFound
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t find(Uint64 key) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Insert a new value (the key must not already exist)
+        ///
+        /// \param key   Key of the new value
+        /// \param value Value to store
+        ///
+        /// \return Index of the inserted value
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t insert(Uint64 key, const T& value);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Remove all the values
+        ///
+        ////////////////////////////////////////////////////////////
+        void clear();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Swap the contents with another table
+        ///
+        /// \param other Table to swap with
+        ///
+        ////////////////////////////////////////////////////////////
+        void swap(HashTable& other);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the number of values stored in the table
+        ///
+        /// Valid indices are in range [0, getSize()).
+        ///
+        /// \return Number of values
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t getSize() const {return m_values.size();}
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Access a value by its index
+        ///
+        /// \param index Index returned by find or insert
+        ///
+        /// \return Reference to the value
+        ///
+        ////////////////////////////////////////////////////////////
+        T& operator [](std::size_t index) {return m_values[index];}
+        const T& operator [](std::size_t index) const {return m_values[index];}
+
+        static const std::size_t NotFound = static_cast<std::size_t>(-1); ///< Value returned by find when the key doesn't exist
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Double the number of slots and re-insert the keys
+        ///
+        ////////////////////////////////////////////////////////////
+        void grow();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        std::vector<Uint64> m_keys;    ///< Key stored in each slot
+        std::vector<Uint32> m_slots;   ///< Index + 1 of the value stored in each slot (0 means empty)
+        std::deque<T>       m_values;  ///< Stored values, in insertion order
+        unsigned int        m_shift;   ///< Shift applied to the hashed key to get a slot (64 - log2(slot count))
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Dense table of Latin-1 glyphs for a given style
     ///
     ////////////////////////////////////////////////////////////
-    struct Row
+    struct Latin1Glyphs
     {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
+        Latin1Glyphs(bool glyphsBold, float glyphsOutlineThickness);
 
-        unsigned int width;  ///< Current width of the row
-        unsigned int top;    ///< Y position of the row into the texture
-        unsigned int height; ///< Height of the row
+        bool   bold;             ///< Bold flag of the glyphs
+        float  outlineThickness; ///< Outline thickness of the glyphs
+        Uint32 indices[256];     ///< Index + 1 of the glyph of each code point in the glyph table (0 means not loaded yet)
     };
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint64, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    typedef HashTable<CachedGlyph> GlyphTable;   ///< Table mapping a codepoint to its glyph
+    typedef HashTable<float>       KerningTable; ///< Table mapping a pair of codepoints to their kerning
+    typedef HashTable<Uint32>      IndexTable;   ///< Table mapping a codepoint to its glyph index in the face
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -289,12 +630,9 @@ private:
     ////////////////////////////////////////////////////////////
     struct Page
     {
-        Page();
-
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        Texture          texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        GlyphTable                glyphs;   ///< Table mapping code points to their corresponding glyph
+        std::vector<Latin1Glyphs> latin1;   ///< Direct-indexed glyphs below U+0100, one table per (bold, outline) combination
+        KerningTable              kernings; ///< Table mapping pairs of code points to their kerning offset
     };
 
     ////////////////////////////////////////////////////////////
@@ -303,6 +641,41 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page of glyphs of a character size, creating it if needed
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page corresponding to \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getPage(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of a character in the font face, using the cache
+    ///
+    /// \param codePoint Unicode code point of the character
+    ///
+    /// \return Glyph index of \a codePoint (0 if the face doesn't contain it)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getCharIndex(Uint32 codePoint) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a cached glyph as used, loading it first if needed
+    ///
+    /// \param cached           Cache entry of the glyph
+    /// \param codePoint        Unicode code point of the character
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    /// \param distanceField    Is it a distance field glyph?
+    ///
+    /// \return The glyph stored in \a cached
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& useGlyph(CachedGlyph& cached, Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness, bool distanceField = false) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
@@ -310,23 +683,88 @@ private:
     /// \param characterSize    Reference character size
     /// \param bold             Retrieve the bold version or the regular one?
     /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    /// \param distanceField    Render a signed distance field instead of the glyph coverage?
     ///
     /// \return The glyph corresponding to \a codePoint and \a characterSize
     ///
     ////////////////////////////////////////////////////////////
-    Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
+    Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness, bool distanceField = false) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs into the texture, with parallel rasterization
+    ///
+    /// \param characters       Characters to load
+    /// \param sizes            Array of character sizes to load the characters at
+    /// \param sizeCount        Number of elements in \a sizes
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    /// \param distanceField    Load distance field glyphs?
+    /// \param threadCount      Number of threads to use (0 to use one per processor)
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphs(const String& characters, const unsigned int* sizes, std::size_t sizeCount, bool bold, float outlineThickness, bool distanceField, unsigned int threadCount) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate a rectangle for a rasterized glyph and copy its pixels there
+    ///
+    /// \param glyph  Glyph whose texture rectangle (and distance field bounds) to set
+    /// \param pixels RGBA pixels of the glyph, padding included
+    /// \param width  Width of the pixels
+    /// \param height Height of the pixels
+    /// \param upload Update the texture now? (otherwise only the copy of its pixels is updated)
+    ///
+    ////////////////////////////////////////////////////////////
+    void placeGlyph(Glyph& glyph, const Uint8* pixels, unsigned int width, unsigned int height, bool upload) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
     ///
-    /// \param page   Page of glyphs to search in
+    /// The texture is enlarged, or old glyphs are evicted,
+    /// if there's not enough free space for the rectangle.
+    ///
     /// \param width  Width of the rectangle
     /// \param height Height of the rectangle
     ///
     /// \return Found rectangle within the texture
     ///
     ////////////////////////////////////////////////////////////
-    IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
+    IntRect findGlyphRect(unsigned int width, unsigned int height) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate a rectangle on the skyline, without enlarging the texture
+    ///
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param rect   Receives the allocated rectangle
+    ///
+    /// \return True if the rectangle was allocated, false if there's not enough space
+    ///
+    ////////////////////////////////////////////////////////////
+    bool packRect(unsigned int width, unsigned int height, IntRect& rect) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the glyph texture if it doesn't exist yet
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enlarge the glyph texture, keeping the glyphs at their position
+    ///
+    /// \param size New width and height of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void resizeTexture(unsigned int size) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evict the glyphs last used before a given frame and repack the others
+    ///
+    /// \param frame Glyphs whose last use is older than this frame are evicted
+    ///
+    /// \return True if at least one glyph was evicted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool evictGlyphs(Uint64 frame) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
@@ -341,21 +779,33 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef HashTable<Page> PageTable; ///< Table mapping a character size to its page (texture)
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    void*                      m_library;     ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
-    void*                      m_face;        ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
-    void*                      m_streamRec;   ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
-    void*                      m_stroker;     ///< Pointer to the stroker (it is typeless to avoid exposing implementation details)
-    int*                       m_refCount;    ///< Reference counter used by implicit sharing
-    Info                       m_info;        ///< Information about the font
-    mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    void*                            m_library;            ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
+    void*                            m_face;               ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
+    void*                            m_streamRec;          ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
+    void*                            m_stroker;            ///< Pointer to the stroker (it is typeless to avoid exposing implementation details)
+    std::string                      m_sourceFile;         ///< Path of the font file, to open it again on other threads (empty if not loaded from a file)
+    const void*                      m_sourceData;         ///< Font file in memory, to open it again on other threads (NULL if not loaded from memory)
+    std::size_t                      m_sourceSize;         ///< Size of the font file in memory, in bytes
+    int*                             m_refCount;           ///< Reference counter used by implicit sharing
+    Info                             m_info;               ///< Information about the font
+    mutable PageTable                m_pages;              ///< Table containing the glyphs pages by character size
+    mutable Page                     m_distanceFieldPage;  ///< Page containing the distance field glyphs
+    mutable IndexTable               m_charIndices;        ///< Table caching the glyph index of each code point
+    mutable std::vector<Uint8>       m_pixelBuffer;        ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    mutable Texture                  m_texture;            ///< Texture containing the pixels of the glyphs of all sizes
+    mutable std::vector<Uint8>       m_texturePixels;      ///< Copy of the alpha channel of the texture (its color is always white), used to move glyphs around when evicting
+    mutable std::vector<SkylineNode> m_skyline;            ///< Top outline of the glyphs packed into the texture
+    mutable Uint64                   m_textureGeneration;  ///< Number incremented every time glyphs move in the texture
+    std::size_t                      m_memoryLimit;        ///< Maximum size of the texture, in bytes (0 means no limit)
+    unsigned int                     m_evictionDelay;      ///< Number of frames a glyph must stay unused before it can be evicted
+    Uint64                           m_frame;              ///< Current frame, incremented by advanceFrame
     #ifdef SFML_SYSTEM_ANDROID
-    void*                      m_stream; ///< Asset file streamer (if loaded from file)
+    void*                            m_stream;             ///< Asset file streamer (if loaded from file)
     #endif
 };
 
@@ -47,6 +47,71 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Formats of the pixels of an image
+    ///
+    /// Components are stored in the order of the name. Packed
+    /// formats (RGB565, RGBA4444) and half floats (R16F, RGBA16F)
+    /// are stored as 16-bit values in the native byte order,
+    /// with the first component in the most significant bits.
+    /// Components missing from a format read as 0 for green
+    /// and blue and as 255 for alpha, like in OpenGL.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum PixelFormat
+    {
+        RGBA8,    ///< 8-bit red, green, blue and alpha (4 bytes per pixel, default)
+        R8,       ///< 8-bit red (1 byte per pixel), for masks and heightmaps
+        RG8,      ///< 8-bit red and green (2 bytes per pixel)
+        RGB8,     ///< 8-bit red, green and blue (3 bytes per pixel)
+        RGB565,   ///< 5-bit red, 6-bit green and 5-bit blue (2 bytes per pixel)
+        RGBA4444, ///< 4-bit red, green, blue and alpha (2 bytes per pixel)
+        R16F,     ///< Half float red (2 bytes per pixel)
+        RGBA16F,  ///< Half float red, green, blue and alpha (8 bytes per pixel)
+        RGBA32F   ///< Float red, green, blue and alpha (16 bytes per pixel)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters available to resize an image
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ResizeFilter
+    {
+        Nearest,  ///< Take the closest source pixel, fastest but blocky
+        Bilinear, ///< Linear interpolation, averaging the covered pixels when shrinking
+        Box,      ///< Average of the covered source pixels, ideal for halving
+        Lanczos   ///< 3-lobed Lanczos, sharpest result but slowest
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Settings of the encoders used by saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SaveSettings
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// \param quality     Quality of JPEG files, from 0 to 100
+        /// \param compression Compression level of PNG files, from 0 to 9
+        /// \param threads     Maximum number of threads encoding PNG files, 0 for one per processor
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit SaveSettings(unsigned int quality = 90, unsigned int compression = 6, unsigned int threads = 0) :
+        jpegQuality     (quality),
+        compressionLevel(compression),
+        threadCount     (threads)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int jpegQuality;      ///< Quality of JPEG files, from 0 (smallest) to 100 (best)
+        unsigned int compressionLevel; ///< Compression level of PNG files, from 0 (stored, fastest) to 9 (smallest, slowest)
+        unsigned int threadCount;      ///< Maximum number of threads encoding PNG files, 0 for one per processor
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -55,12 +120,30 @@ public:
     ////////////////////////////////////////////////////////////
     Image();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Image(const Image& copy);
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
     ////////////////////////////////////////////////////////////
     ~Image();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& operator =(const Image& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the image and fill it with a unique color
     ///
@@ -86,12 +169,43 @@ public:
     ////////////////////////////////////////////////////////////
     void create(unsigned int width, unsigned int height, const Uint8* pixels);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image with a pixel format and fill it with a unique color
+    ///
+    /// The color is converted to the pixel format, dropping
+    /// the components that the format doesn't have.
+    ///
+    /// \param width  Width of the image
+    /// \param height Height of the image
+    /// \param format Format of the pixels
+    /// \param color  Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(unsigned int width, unsigned int height, PixelFormat format, const Color& color = Color(0, 0, 0));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image from an array of pixels of a given format
+    ///
+    /// The \a pixel array is assumed to contain
+    /// width * height * getPixelSize(format) bytes. If not,
+    /// this is an undefined behavior.
+    /// If \a pixels is null, an empty image is created.
+    ///
+    /// \param width  Width of the image
+    /// \param height Height of the image
+    /// \param pixels Array of pixels to copy to the image
+    /// \param format Format of the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(unsigned int width, unsigned int height, const void* pixels, PixelFormat format);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not supported,
+    /// like progressive jpeg. QOI files are recognized by their
+    /// content and decode several times faster than PNG files.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -107,8 +221,9 @@ public:
     /// \brief Load the image from a file in memory
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not supported,
+    /// like progressive jpeg. QOI files are recognized by their
+    /// content and decode several times faster than PNG files.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -125,8 +240,9 @@ public:
     /// \brief Load the image from a custom stream
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not supported,
+    /// like progressive jpeg. QOI files are recognized by their
+    /// content and decode several times faster than PNG files.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -143,17 +259,25 @@ public:
     ///
     /// The format of the image is automatically deduced from
     /// the extension. The supported image formats are bmp, png,
-    /// tga and jpg. The destination file is overwritten
+    /// tga, jpg and qoi. The destination file is overwritten
     /// if it already exists. This function fails if the image is empty.
+    /// Images of other pixel formats than RGBA8 are saved
+    /// as RGBA8.
+    ///
+    /// PNG files are compressed in bands of rows on several
+    /// threads; the file doesn't depend on the number of threads.
+    /// To save without blocking the calling thread, use
+    /// sf::ImageSaveQueue.
     ///
     /// \param filename Path of the file to save
+    /// \param settings Settings of the encoder of the file format
     ///
     /// \return True if saving was successful
     ///
     /// \see create, loadFromFile, loadFromMemory
     ///
     ////////////////////////////////////////////////////////////
-    bool saveToFile(const std::string& filename) const;
+    bool saveToFile(const std::string& filename, const SaveSettings& settings = SaveSettings()) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
@@ -163,12 +287,52 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format of the pixels of the image
+    ///
+    /// Loaded images are always RGBA8.
+    ///
+    /// \return Pixel format of the image
+    ///
+    /// \see convert
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat getPixelFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the pixels of the image to another format
+    ///
+    /// Components that the new format doesn't have are
+    /// dropped, and components are rounded to the nearest
+    /// value that the new format can represent; float
+    /// components are clamped to [0, 1] when converted to
+    /// a normalized format. Large images are converted by
+    /// several threads.
+    ///
+    /// \param format New format of the pixels
+    ///
+    /// \see getPixelFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    void convert(PixelFormat format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a pixel of a given format
+    ///
+    /// \param format Pixel format
+    ///
+    /// \return Size of a pixel, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getPixelSize(PixelFormat format);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create a transparency mask from a specified color-key
     ///
     /// This function sets the alpha value of every pixel matching
     /// the given color to \a alpha (0 by default), so that they
-    /// become transparent.
+    /// become transparent. It does nothing if the pixel format
+    /// of the image has no alpha.
     ///
     /// \param color Color to make transparent
     /// \param alpha Alpha value to assign to transparent pixels
@@ -187,7 +351,13 @@ public:
     /// If \a sourceRect is empty, the whole image is copied.
     /// If \a applyAlpha is set to true, the transparency of
     /// source pixels is applied. If it is false, the pixels are
-    /// copied unchanged with their alpha value.
+    /// copied unchanged with their alpha value. Large areas
+    /// are blended by several threads, each one processing a
+    /// band of rows.
+    ///
+    /// The source pixels are converted to the pixel format of
+    /// this image. When either image isn't RGBA8, blending
+    /// is done with 8 bits per component.
     ///
     /// \param source     Source image to copy
     /// \param destX      X coordinate of the destination position
@@ -203,7 +373,8 @@ public:
     ///
     /// This function doesn't check the validity of the pixel
     /// coordinates, using out-of-range values will result in
-    /// an undefined behavior.
+    /// an undefined behavior. The color is converted to the
+    /// pixel format of the image.
     ///
     /// \param x     X coordinate of pixel to change
     /// \param y     Y coordinate of pixel to change
@@ -219,7 +390,8 @@ public:
     ///
     /// This function doesn't check the validity of the pixel
     /// coordinates, using out-of-range values will result in
-    /// an undefined behavior.
+    /// an undefined behavior. Components missing from the
+    /// pixel format of the image are 0, except alpha which is 255.
     ///
     /// \param x X coordinate of pixel to get
     /// \param y Y coordinate of pixel to get
@@ -234,9 +406,11 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Get a read-only pointer to the array of pixels
     ///
-    /// The returned value points to an array of RGBA pixels made of
-    /// 8 bits integers components. The size of the array is
-    /// width * height * 4 (getSize().x * getSize().y * 4).
+    /// The returned value points to an array of pixels in the
+    /// format of the image, which are RGBA pixels made of 8 bits
+    /// integers components unless another format was chosen.
+    /// The size of the array is width * height * pixel size
+    /// (getSize().x * getSize().y * getPixelSize(getPixelFormat())).
     /// Warning: the returned pointer may become invalid if you
     /// modify the image, so you should never store it for too long.
     /// If the image is empty, a null pointer is returned.
@@ -258,15 +432,81 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the image, resampling its pixels
+    ///
+    /// Except with the Nearest filter, colors are averaged with
+    /// their alpha as weight, so that transparent pixels don't
+    /// darken their neighbours. If \a sRgb is true, the color
+    /// components are considered sRGB-encoded (which is the case
+    /// for most images) and are averaged in linear space; pass
+    /// false for images that hold other kinds of data. Large
+    /// images are filtered by several threads.
+    ///
+    /// Images of other pixel formats than RGBA8 are resampled
+    /// with 8 bits per component, which clamps float components
+    /// to [0, 1]; the image keeps its format.
+    ///
+    /// Resizing to a width or height of 0 empties the image.
+    ///
+    /// \param width  New width of the image
+    /// \param height New height of the image
+    /// \param filter Filter to use
+    /// \param sRgb   Are the color components sRGB-encoded?
+    ///
+    /// \see generateMipChain
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int width, unsigned int height, ResizeFilter filter = Bilinear, bool sRgb = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the mipmap levels of the image
+    ///
+    /// Each level halves the size of the previous one (rounding
+    /// down, with a minimum of 1), starting from the image itself,
+    /// until a 1x1 level is reached. The image itself is not part
+    /// of the returned levels, so an empty chain is returned for
+    /// a 1x1 or empty image. Levels are resampled as with resize,
+    /// and have the pixel format of the image.
+    ///
+    /// The result can be uploaded with Texture::updateMipmap,
+    /// which doesn't require any OpenGL extension, contrary
+    /// to Texture::generateMipmap.
+    ///
+    /// \param filter Filter to use
+    /// \param sRgb   Are the color components sRGB-encoded?
+    ///
+    /// \return Levels of the mipmap, from the largest to the 1x1 one
+    ///
+    /// \see resize, Texture::updateMipmap
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<Image> generateMipChain(ResizeFilter filter = Box, bool sRgb = true) const;
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the pixels of the image
+    ///
+    /// The image takes ownership of \a pixels, which must have
+    /// been allocated with std::malloc so that decoded images
+    /// can be adopted without a copy.
+    ///
+    /// \param pixels New array of pixels, or NULL for an empty image
+    /// \param size   New size of the image
+    /// \param format New format of the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPixels(Uint8* pixels, const Vector2u& size, PixelFormat format);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u           m_size;   ///< Image size
-    std::vector<Uint8> m_pixels; ///< Pixels of the image
+    Vector2u    m_size;   ///< Image size
+    PixelFormat m_format; ///< Format of the pixels
+    Uint8*      m_pixels; ///< Pixels of the image, allocated with std::malloc
     #ifdef SFML_SYSTEM_ANDROID
-    void*              m_stream; ///< Asset file streamer (if loaded from file)
+    void*       m_stream; ///< Asset file streamer (if loaded from file)
     #endif
 };
 
@@ -285,14 +525,17 @@ private:
 /// functions to load, read, write and save pixels, as well
 /// as many other useful functions.
 ///
-/// sf::Image can handle a unique internal representation of
-/// pixels, which is RGBA 32 bits. This means that a pixel
-/// must be composed of 8 bits red, green, blue and alpha
-/// channels -- just like a sf::Color.
-/// All the functions that return an array of pixels follow
-/// this rule, and all parameters that you pass to sf::Image
-/// functions (such as loadFromMemory) must use this
-/// representation as well.
+/// The default internal representation of pixels is RGBA
+/// 32 bits. This means that a pixel is composed of 8 bits
+/// red, green, blue and alpha channels -- just like a sf::Color.
+/// Loaded images use this representation, as do the arrays of
+/// pixels passed to create unless another format is given.
+///
+/// Images that don't need all of it can be stored in a more
+/// compact format (see sf::Image::PixelFormat), for example
+/// a grayscale mask in R8 takes 4 times less memory, and
+/// uploads 4 times faster to a texture of the same format.
+/// Float formats hold data beyond [0, 1], like HDR lightmaps.
 ///
 /// A sf::Image can be copied, but it is a heavy resource and
 /// if possible you should always use [const] references to
@@ -320,6 +563,11 @@ private:
 /// // Save the image to a file
 /// if (!image.saveToFile("result.png"))
 ///     return -1;
+///
+/// // Store a fog of war mask with one byte per pixel
+/// sf::Image fog;
+/// fog.create(1024, 1024, sf::Image::R8, sf::Color::Black);
+/// fog.setPixel(512, 512, sf::Color::Red);
 /// \endcode
 ///
 /// \see sf::Texture
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGELOADQUEUE_HPP
+#define SFML_IMAGELOADQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+class Thread;
+
+////////////////////////////////////////////////////////////
+/// \brief Decodes a list of image files on worker threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageLoadQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start decoding a list of image files
+    ///
+    /// The workers start right away, each one decoding the next
+    /// file of the list that no other worker has taken yet.
+    ///
+    /// \param filenames   Paths of the image files to load
+    /// \param threadCount Maximum number of worker threads, 0 for one per processor
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ImageLoadQueue(const std::vector<std::string>& filenames, unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Files that no worker has started decoding yet are
+    /// skipped, the destructor only waits for the images
+    /// being decoded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageLoadQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of files of the queue
+    ///
+    /// \return Number of files given to the constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFileCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images not returned yet
+    ///
+    /// \return Number of images that waitNext will still return
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getRemainingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the next image is decoded
+    ///
+    /// Images are returned in the order they finish decoding,
+    /// which is not necessarily the order of the files. An image
+    /// that failed to load is returned empty, after the error
+    /// was written to sf::err(). The returned image stays valid
+    /// until the next call to waitNext or pollNext, which
+    /// releases it.
+    ///
+    /// \param index Receives the index of the image's file in the list
+    ///
+    /// \return Decoded image, or NULL if all the images were already returned
+    ///
+    /// \see pollNext
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image* waitNext(std::size_t& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next decoded image, if there is one
+    ///
+    /// This function is the non-blocking version of waitNext,
+    /// which lets the calling thread do something else (like
+    /// drawing a loading screen) while the workers are busy.
+    ///
+    /// \param index Receives the index of the image's file in the list
+    ///
+    /// \return Decoded image, or NULL if no image is ready
+    ///
+    /// \see waitNext
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image* pollNext(std::size_t& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload every remaining image to a texture
+    ///
+    /// Each image is uploaded as soon as it is decoded, so the
+    /// uploads overlap with the decoding of the next images.
+    /// \a textures is resized to the number of files, and the
+    /// texture of each image is at the index of its file. This
+    /// function must be called from the thread that uploads
+    /// textures, usually the main one.
+    ///
+    /// \param textures Textures to load, indexed like the files
+    ///
+    /// \return True if all the images were loaded to their texture
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadTextures(std::vector<Texture>& textures);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode files until there are none left
+    ///
+    /// This function is the entry point of the workers.
+    ///
+    ////////////////////////////////////////////////////////////
+    void decodeImages();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the next decoded image, if there is one
+    ///
+    /// \param index Receives the index of the image's file in the list
+    /// \param done  Receives whether all the images were already returned
+    ///
+    /// \return Decoded image, or NULL if no image is ready
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image* takeNext(std::size_t& index, bool& done);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<std::string> m_filenames; ///< Paths of the files to decode
+    std::vector<Image>       m_images;    ///< Decoded images, indexed like the files
+    std::deque<std::size_t>  m_ready;     ///< Indices of the decoded images not returned yet
+    std::vector<Thread*>     m_threads;   ///< Worker threads
+    mutable Mutex            m_mutex;     ///< Mutex protecting the state shared with the workers
+    std::size_t              m_nextFile;  ///< Index of the next file to decode
+    std::size_t              m_returned;  ///< Number of images returned so far
+    std::size_t              m_current;   ///< Index of the last returned image
+    bool                     m_cancelled; ///< Should the workers stop?
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGELOADQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageLoadQueue
+/// \ingroup graphics
+///
+/// Decoding image files is mostly CPU work: loading the
+/// hundreds of images of a game level one after another with
+/// sf::Image::loadFromFile or sf::Texture::loadFromFile leaves
+/// all the processors but one idle. sf::ImageLoadQueue decodes
+/// a list of files on a bounded number of worker threads and
+/// hands the images out as they are ready.
+///
+/// Uploading the images to textures has to stay on the thread
+/// that renders, but doesn't have to wait for all the images:
+/// the loop below uploads each image while the workers decode
+/// the next ones (which is what loadTextures does).
+///
+/// Usage example:
+/// \code
+/// std::vector<std::string> files;
+/// files.push_back("background.png");
+/// files.push_back("tiles.png");
+/// files.push_back("player.png");
+///
+/// sf::ImageLoadQueue queue(files);
+/// std::vector<sf::Texture> textures(files.size());
+///
+/// std::size_t index;
+/// while (const sf::Image* image = queue.waitNext(index))
+/// {
+///     if (image->getSize().x > 0)
+///         textures[index].loadFromImage(*image);
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
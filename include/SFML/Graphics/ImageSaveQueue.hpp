@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGESAVEQUEUE_HPP
+#define SFML_IMAGESAVEQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
+#include <string>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Saves images to files on a worker thread
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageSaveQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The worker thread only runs while there are images
+    /// to save.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageSaveQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The destructor waits until all the queued images
+    /// are saved.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageSaveQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue an image to be saved to a file
+    ///
+    /// The image is copied, so it can be modified or destroyed
+    /// as soon as the function returns. The file is written by
+    /// the worker thread, with Image::saveToFile; images are
+    /// saved in the order they were queued.
+    ///
+    /// \param image    Image to save
+    /// \param filename Path of the file to save
+    /// \param settings Settings of the encoder of the file format
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void save(const Image& image, const std::string& filename, const Image::SaveSettings& settings = Image::SaveSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images not saved yet
+    ///
+    /// \return Number of queued images, including the one being saved
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the queued images are saved
+    ///
+    /// The errors of the images that failed to save are
+    /// written to sf::err() as they happen.
+    ///
+    /// \return True if all the images saved since the previous call to wait were saved successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Image queued to be saved
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Request
+    {
+        Image               image;    ///< Copy of the image to save
+        std::string         filename; ///< Path of the file to save
+        Image::SaveSettings settings; ///< Settings of the encoder
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save queued images until there are none left
+    ///
+    /// This function is the entry point of the worker.
+    ///
+    ////////////////////////////////////////////////////////////
+    void saveImages();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Request*> m_requests; ///< Images not saved yet, the first one being saved
+    Thread               m_thread;   ///< Worker thread
+    mutable Mutex        m_mutex;    ///< Mutex protecting the state shared with the worker
+    bool                 m_running;  ///< Is the worker running?
+    bool                 m_failed;   ///< Did an image fail to save since the last call to wait?
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGESAVEQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageSaveQueue
+/// \ingroup graphics
+///
+/// Encoding a large image, especially to PNG, takes long
+/// enough to make a game skip frames when it's done from the
+/// game loop. sf::ImageSaveQueue copies the images to save
+/// and writes them to their files on a worker thread, one
+/// after the other, while the calling thread goes on.
+///
+/// Usage example:
+/// \code
+/// sf::ImageSaveQueue screenshots;
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     if (screenshotRequested)
+///     {
+///         // Returns right away, the file is written in the background
+///         sf::Texture texture;
+///         texture.create(window.getSize().x, window.getSize().y);
+///         texture.update(window);
+///         screenshots.save(texture.copyToImage(), "screenshot.png");
+///     }
+///     ...
+/// }
+///
+/// // The destructor waits for the last screenshots to be saved
+/// \endcode
+///
+/// \see sf::Image, sf::ImageLoadQueue
+///
+////////////////////////////////////////////////////////////
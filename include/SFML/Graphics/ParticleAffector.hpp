@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PARTICLEAFFECTOR_HPP
+#define SFML_PARTICLEAFFECTOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for objects modifying living particles
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleAffector
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~ParticleAffector() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Modify a range of particles
+    ///
+    /// This function may be called concurrently from several
+    /// threads, each with a different range of particles; it
+    /// must only modify the particles in [begin, end).
+    ///
+    /// \param particles Attributes of all the particles
+    /// \param begin     Index of the first particle to modify
+    /// \param end       One past the index of the last particle to modify
+    /// \param elapsed   Duration of the update
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void affect(const ParticleSystem::Arrays& particles, std::size_t begin, std::size_t end, Time elapsed) const = 0;
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLEAFFECTOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleAffector
+/// \ingroup graphics
+///
+/// Derive from sf::ParticleAffector and override affect to
+/// implement forces, color fades, size changes and the like.
+/// Loops over plain arrays of floats and vectors are easy for
+/// the compiler to vectorize, so prefer processing one
+/// attribute at a time over the whole range.
+///
+/// \code
+/// class FadeOut : public sf::ParticleAffector
+/// {
+/// public:
+///
+///     virtual void affect(const sf::ParticleSystem::Arrays& particles, std::size_t begin, std::size_t end, sf::Time) const
+///     {
+///         for (std::size_t i = begin; i < end; ++i)
+///             particles.colors[i].a = static_cast<sf::Uint8>(255 * (1 - particles.ages[i] / particles.lifetimes[i]));
+///     }
+/// };
+/// \endcode
+///
+/// \see sf::ParticleSystem, sf::ParticleEmitter
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PARTICLEEMITTER_HPP
+#define SFML_PARTICLEEMITTER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+class ParticleSystem;
+
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for objects creating particles
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleEmitter
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~ParticleEmitter() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the particles of an update
+    ///
+    /// This function is called by the particle system at the
+    /// beginning of each update, from the updating thread.
+    /// Call ParticleSystem::addParticle to create particles.
+    ///
+    /// \param system  Particle system being updated
+    /// \param elapsed Duration of the update
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void emit(ParticleSystem& system, Time elapsed) = 0;
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLEEMITTER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleEmitter
+/// \ingroup graphics
+///
+/// Derive from sf::ParticleEmitter and override emit to define
+/// how and where new particles appear. The emitter usually keeps
+/// track of fractional emission counts between updates so that
+/// the emission rate doesn't depend on the frame rate.
+///
+/// \see sf::ParticleSystem, sf::ParticleAffector
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PARTICLESYSTEM_HPP
+#define SFML_PARTICLESYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class ParticleAffector;
+class ParticleEmitter;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Large set of short-lived textured quads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleSystem : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Initial state of a new particle
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Particle
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates a white, motionless particle of size 1 that
+        /// lives for one second.
+        ///
+        ////////////////////////////////////////////////////////////
+        Particle();
+
+        Vector2f position;      ///< Position of the center of the particle
+        Vector2f velocity;      ///< Velocity, in units per second
+        float    rotation;      ///< Orientation, in degrees
+        float    rotationSpeed; ///< Angular velocity, in degrees per second
+        float    size;          ///< Length of the sides of the particle
+        Color    color;         ///< Color of the particle
+        Time     lifetime;      ///< Total duration of the particle
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Direct access to the attributes of the particles
+    ///
+    /// Each member points to an array holding one attribute of
+    /// every particle; the attributes of a particle share the
+    /// same index in all the arrays.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Arrays
+    {
+        Vector2f* positions;      ///< Position of each particle
+        Vector2f* velocities;     ///< Velocity of each particle, in units per second
+        float*    rotations;      ///< Orientation of each particle, in degrees
+        float*    rotationSpeeds; ///< Angular velocity of each particle, in degrees per second
+        float*    sizes;          ///< Size of each particle
+        Color*    colors;         ///< Color of each particle
+        float*    ages;           ///< Time elapsed since the creation of each particle, in seconds
+        float*    lifetimes;      ///< Total duration of each particle, in seconds
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty particle system without texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture of the particles
+    ///
+    /// All the particles display the same rectangle of the same
+    /// texture. The texture must exist as long as the particle
+    /// system uses it.
+    ///
+    /// \param texture     New texture
+    /// \param textureRect Sub-rectangle of the texture to display; an empty rectangle selects the whole texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture, const IntRect& textureRect = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an emitter
+    ///
+    /// Emitters are called at the beginning of every update to
+    /// create new particles. The particle system doesn't own
+    /// the emitter, it must remain alive until it is removed.
+    ///
+    /// \param emitter Emitter to add
+    ///
+    /// \see removeEmitter
+    ///
+    ////////////////////////////////////////////////////////////
+    void addEmitter(ParticleEmitter& emitter);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an emitter
+    ///
+    /// \param emitter Emitter to remove
+    ///
+    /// \see addEmitter
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeEmitter(ParticleEmitter& emitter);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an affector
+    ///
+    /// Affectors modify the living particles at every update,
+    /// after their position and rotation have been integrated.
+    /// The particle system doesn't own the affector, it must
+    /// remain alive until it is removed.
+    ///
+    /// \param affector Affector to add
+    ///
+    /// \see removeAffector
+    ///
+    ////////////////////////////////////////////////////////////
+    void addAffector(const ParticleAffector& affector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an affector
+    ///
+    /// \param affector Affector to remove
+    ///
+    /// \see addAffector
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeAffector(const ParticleAffector& affector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new particle
+    ///
+    /// This function is typically called by emitters.
+    ///
+    /// \param particle Initial state of the particle
+    ///
+    ////////////////////////////////////////////////////////////
+    void addParticle(const Particle& particle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for a given number of particles
+    ///
+    /// \param count Number of particles to allocate memory for
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of living particles
+    ///
+    /// \return Number of particles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParticleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads used to update the particles
+    ///
+    /// A value of 0 uses one thread per processor. The default
+    /// is 1, which updates the particles in the calling thread
+    /// only.
+    ///
+    /// \param count Maximum number of threads
+    ///
+    /// \see getThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads used to update the particles
+    ///
+    /// \return Maximum number of threads, 0 meaning one per processor
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the simulation
+    ///
+    /// Runs the emitters, removes the particles that reached
+    /// the end of their lifetime, moves the others, applies the
+    /// affectors and regenerates the geometry. Everything but
+    /// the emitters runs on up to getThreadCount() threads.
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the particles to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the particles that won't survive an update
+    ///
+    /// \param elapsed Duration of the update, in seconds
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeDeadParticles(float elapsed);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vector2f>                m_positions;      ///< Position of each particle
+    std::vector<Vector2f>                m_velocities;     ///< Velocity of each particle
+    std::vector<float>                   m_rotations;      ///< Orientation of each particle
+    std::vector<float>                   m_rotationSpeeds; ///< Angular velocity of each particle
+    std::vector<float>                   m_sizes;          ///< Size of each particle
+    std::vector<Color>                   m_colors;         ///< Color of each particle
+    std::vector<float>                   m_ages;           ///< Age of each particle, in seconds
+    std::vector<float>                   m_lifetimes;      ///< Lifetime of each particle, in seconds
+    std::vector<Vertex>                  m_vertices;       ///< Two triangles per particle, regenerated at each update
+    std::vector<ParticleEmitter*>        m_emitters;       ///< Emitters creating new particles
+    std::vector<const ParticleAffector*> m_affectors;      ///< Affectors modifying the living particles
+    const Texture*                       m_texture;        ///< Texture of the particles
+    IntRect                              m_textureRect;    ///< Rectangle of the texture displayed by the particles
+    unsigned int                         m_threadCount;    ///< Maximum number of threads used to update the particles
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLESYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleSystem
+/// \ingroup graphics
+///
+/// sf::ParticleSystem simulates and draws many small quads
+/// (sparks, smoke, debris...) that live for a limited time.
+///
+/// The attributes of the particles are stored in separate
+/// contiguous arrays (one for positions, one for velocities,
+/// etc.) so that the update loops touch only the memory they
+/// need and can be vectorized by the compiler. Updates can be
+/// spread over several threads with setThreadCount, and the
+/// vertices are written directly into a single array drawn
+/// with one draw call.
+///
+/// New particles are created by sf::ParticleEmitter objects and
+/// the living ones are modified by sf::ParticleAffector objects.
+///
+/// Usage example:
+/// \code
+/// class Fountain : public sf::ParticleEmitter
+/// {
+/// public:
+///
+///     virtual void emit(sf::ParticleSystem& system, sf::Time elapsed)
+///     {
+///         sf::ParticleSystem::Particle particle;
+///         particle.lifetime = sf::seconds(2);
+///         for (int i = 0; i < 1000 * elapsed.asSeconds(); ++i)
+///         {
+///             particle.velocity = sf::Vector2f(std::rand() % 100 - 50.f, -200.f);
+///             system.addParticle(particle);
+///         }
+///     }
+/// };
+///
+/// class Gravity : public sf::ParticleAffector
+/// {
+/// public:
+///
+///     virtual void affect(const sf::ParticleSystem::Arrays& particles, std::size_t begin, std::size_t end, sf::Time elapsed) const
+///     {
+///         for (std::size_t i = begin; i < end; ++i)
+///             particles.velocities[i].y += 100.f * elapsed.asSeconds();
+///     }
+/// };
+///
+/// Fountain fountain;
+/// Gravity gravity;
+///
+/// sf::ParticleSystem particles;
+/// particles.setTexture(texture);
+/// particles.addEmitter(fountain);
+/// particles.addAffector(gravity);
+/// particles.setThreadCount(0);
+///
+/// // ...
+///
+/// particles.update(clock.restart());
+/// window.draw(particles);
+/// \endcode
+///
+/// \see sf::ParticleEmitter, sf::ParticleAffector
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,335 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_POLYGONSHAPE_HPP
+#define SFML_POLYGONSHAPE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Filled polygon that may be concave and have holes
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PolygonShape : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param pointCount Number of points of the outer boundary
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PolygonShape(std::size_t pointCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of points of the outer boundary
+    ///
+    /// \a count must be greater than 2 to define a valid polygon.
+    ///
+    /// \param count New number of points of the outer boundary
+    ///
+    /// \see getPointCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPointCount(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of points of the outer boundary
+    ///
+    /// \return Number of points of the outer boundary
+    ///
+    /// \see setPointCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPointCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a point of the outer boundary
+    ///
+    /// The points must be ordered along the boundary, either
+    /// clockwise or counter-clockwise, and the boundary must not
+    /// intersect itself. The result is undefined if \a index is
+    /// out of the valid range.
+    ///
+    /// \param index Index of the point to change, in range [0 .. getPointCount() - 1]
+    /// \param point New position of the point
+    ///
+    /// \see getPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPoint(std::size_t index, const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a point of the outer boundary
+    ///
+    /// The result is undefined if \a index is out of the valid range.
+    ///
+    /// \param index Index of the point to get, in range [0 .. getPointCount() - 1]
+    ///
+    /// \return Position of the index-th point of the outer boundary
+    ///
+    /// \see setPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getPoint(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cut a hole in the polygon
+    ///
+    /// The points of the hole must be ordered along its boundary,
+    /// in any direction. Holes must lie strictly inside the outer
+    /// boundary and must not intersect each other.
+    ///
+    /// \param points Points of the boundary of the hole
+    ///
+    /// \return Index of the new hole
+    ///
+    /// \see clearHoles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addHole(const std::vector<Vector2f>& points);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of holes
+    ///
+    /// \return Number of holes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getHoleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the points of a hole
+    ///
+    /// The result is undefined if \a index is out of the valid range.
+    ///
+    /// \param index Index of the hole, in range [0 .. getHoleCount() - 1]
+    ///
+    /// \return Points of the boundary of the hole
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Vector2f>& getHole(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the holes
+    ///
+    /// \see addHole
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearHoles();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the triangulation of the polygon
+    ///
+    /// The result is a list of triangles, as three consecutive
+    /// indices per triangle. Indices refer to the points of the
+    /// outer boundary first (0 to getPointCount() - 1), then to
+    /// the points of each hole in order.
+    ///
+    /// The triangulation is computed in O(n log n) only when
+    /// the points change, and kept until then.
+    ///
+    /// \return Indices of the vertices of the triangles
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<unsigned int>& getTriangles() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the polygon
+    ///
+    /// \a texture can be NULL to disable texturing. The texture
+    /// is mapped on the bounding rectangle of the polygon. It
+    /// must exist as long as the polygon uses it.
+    ///
+    /// \param texture   New texture
+    /// \param resetRect Should the texture rect be reset to the size of the new texture?
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sub-rectangle of the texture that the polygon will display
+    ///
+    /// \param rect Rectangle defining the region of the texture to display
+    ///
+    /// \see getTextureRect, setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the fill color of the polygon
+    ///
+    /// \param color New color of the polygon
+    ///
+    /// \see getFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFillColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of the polygon
+    ///
+    /// \return Pointer to the polygon's texture
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture displayed by the polygon
+    ///
+    /// \return Texture rectangle of the polygon
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fill color of the polygon
+    ///
+    /// \return Fill color of the polygon
+    ///
+    /// \see setFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getFillColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the polygon
+    ///
+    /// \return Local bounding rectangle of the polygon
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the polygon
+    ///
+    /// \return Global bounding rectangle of the polygon
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the polygon to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the triangulation if the points changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureTriangulation() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the vertices if anything changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vector2f>               m_points;                  ///< Points of the outer boundary
+    std::vector<std::vector<Vector2f> > m_holes;                   ///< Points of the boundaries of the holes
+    const Texture*                      m_texture;                 ///< Texture of the polygon
+    IntRect                             m_textureRect;             ///< Rectangle defining the area of the source texture to display
+    Color                               m_fillColor;               ///< Fill color
+    mutable std::vector<unsigned int>   m_triangles;               ///< Indices of the triangles, three per triangle
+    mutable VertexArray                 m_vertices;                ///< Vertex array containing the triangles
+    mutable FloatRect                   m_bounds;                  ///< Bounding rectangle of the polygon
+    mutable bool                        m_triangulationNeedUpdate; ///< Must the triangulation be recomputed?
+    mutable bool                        m_geometryNeedUpdate;      ///< Must the vertices be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_POLYGONSHAPE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PolygonShape
+/// \ingroup graphics
+///
+/// sf::PolygonShape draws simple polygons of any form: unlike
+/// sf::ConvexShape, which is drawn as a fan of triangles around
+/// its center, it supports concave boundaries and holes.
+///
+/// The polygon is split into triangles with a sweep-line
+/// algorithm in O(n log n). The triangulation is cached and
+/// only recomputed after the points change; it is available
+/// as an indexed triangle list with getTriangles, for example
+/// to feed a physics engine or a custom renderer.
+///
+/// The outer boundary and the holes must be simple (not
+/// self-intersecting), holes must lie inside the outer boundary
+/// and must not overlap each other.
+///
+/// Usage example:
+/// \code
+/// sf::PolygonShape polygon(4);
+/// polygon.setPoint(0, sf::Vector2f(0, 0));
+/// polygon.setPoint(1, sf::Vector2f(100, 0));
+/// polygon.setPoint(2, sf::Vector2f(100, 100));
+/// polygon.setPoint(3, sf::Vector2f(0, 100));
+///
+/// std::vector<sf::Vector2f> hole;
+/// hole.push_back(sf::Vector2f(25, 25));
+/// hole.push_back(sf::Vector2f(75, 25));
+/// hole.push_back(sf::Vector2f(50, 75));
+/// polygon.addHole(hole);
+///
+/// polygon.setFillColor(sf::Color::Green);
+/// window.draw(polygon);
+/// \endcode
+///
+/// \see sf::ConvexShape
+///
+////////////////////////////////////////////////////////////
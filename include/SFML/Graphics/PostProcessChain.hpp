@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_POSTPROCESSCHAIN_HPP
+#define SFML_POSTPROCESSCHAIN_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Sequence of fullscreen shader passes applied to a texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PostProcessChain : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty chain.
+    ///
+    ////////////////////////////////////////////////////////////
+    PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a pass to the chain
+    ///
+    /// The shader reads the output of the previous pass (or the
+    /// source texture, for the first enabled pass) through the
+    /// texture bound as sf::Shader::CurrentTexture. The chain
+    /// doesn't own the shader, it must remain alive as long as
+    /// the chain uses it.
+    ///
+    /// \a scale is the size of the pass output relative to the
+    /// source texture; use 0.5 to run a pass at half resolution.
+    /// It is ignored for the last enabled pass, which always
+    /// draws to the final target.
+    ///
+    /// \param shader Shader to apply
+    /// \param scale  Size of the output of the pass, relative to the source texture
+    ///
+    /// \return Index of the new pass
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addPass(const Shader& shader, float scale = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable a pass
+    ///
+    /// Disabled passes are skipped entirely, the next enabled
+    /// pass reads the output of the previous enabled one.
+    /// Passes are enabled by default.
+    ///
+    /// \param index   Index of the pass
+    /// \param enabled True to enable the pass, false to disable it
+    ///
+    /// \see isPassEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPassEnabled(std::size_t index, bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a pass is enabled
+    ///
+    /// \param index Index of the pass
+    ///
+    /// \return True if the pass is enabled
+    ///
+    /// \see setPassEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPassEnabled(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the output scale of a pass
+    ///
+    /// \param index Index of the pass
+    /// \param scale Size of the output of the pass, relative to the source texture
+    ///
+    /// \see addPass
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPassScale(std::size_t index, float scale);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of passes in the chain
+    ///
+    /// \return Number of passes, enabled or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPassCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the passes and free the intermediate targets
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the chain on a texture and draw the result
+    ///
+    /// Each enabled pass draws a single fullscreen triangle.
+    /// Intermediate passes render into render-textures that are
+    /// recycled from one call to the next, and at most two of
+    /// them are in use at any time. The last enabled pass draws
+    /// directly to \a target, covering it entirely; if no pass
+    /// is enabled, \a source is simply drawn to \a target.
+    ///
+    /// \param source    Texture to process, typically the scene rendered to a sf::RenderTexture
+    /// \param target    Render target to draw the result to
+    /// \param blendMode Blend mode used to draw the result to \a target
+    ///
+    ////////////////////////////////////////////////////////////
+    void apply(const Texture& source, RenderTarget& target, const BlendMode& blendMode = BlendNone);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shader pass
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Pass
+    {
+        const Shader* shader;  ///< Shader applied by the pass
+        float         scale;   ///< Output size relative to the source
+        bool          enabled; ///< Is the pass enabled?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Pass> m_passes; ///< Passes of the chain, in application order
+    RenderTexturePool m_pool;   ///< Intermediate render-textures
+};
+
+} // namespace sf
+
+
+#endif // SFML_POSTPROCESSCHAIN_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PostProcessChain
+/// \ingroup graphics
+///
+/// sf::PostProcessChain applies a sequence of fragment shaders
+/// to a texture, typically a scene rendered into a
+/// sf::RenderTexture, and draws the result to a render target.
+///
+/// It takes care of the intermediate render-textures (sized
+/// according to the scale of each pass and recycled between
+/// frames), skips disabled passes without any extra copy and
+/// covers the targets with a single triangle rather than a quad
+/// to avoid shading the diagonal twice.
+///
+/// Shaders read their input through the current texture:
+/// \code
+/// uniform sampler2D texture;
+///
+/// void main()
+/// {
+///     gl_FragColor = gl_Color * texture2D(texture, gl_TexCoord[0].xy);
+/// }
+/// \endcode
+///
+/// Usage example:
+/// \code
+/// brightPass.setUniform("texture", sf::Shader::CurrentTexture);
+/// blur.setUniform("texture", sf::Shader::CurrentTexture);
+/// tonemap.setUniform("texture", sf::Shader::CurrentTexture);
+///
+/// sf::PostProcessChain chain;
+/// chain.addPass(brightPass, 0.5f); // half resolution
+/// chain.addPass(blur, 0.5f);
+/// std::size_t tonemapPass = chain.addPass(tonemap);
+///
+/// // ...
+///
+/// scene.display();
+/// chain.setPassEnabled(tonemapPass, hdrEnabled);
+/// chain.apply(scene.getTexture(), window);
+/// \endcode
+///
+/// \see sf::Shader, sf::RenderTexture, sf::RenderTexturePool
+///
+////////////////////////////////////////////////////////////
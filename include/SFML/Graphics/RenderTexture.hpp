@@ -31,6 +31,8 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#include <vector>
 
 
 namespace sf
@@ -85,6 +87,59 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(unsigned int width, unsigned int height, bool depthBuffer = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture with advanced settings
+    ///
+    /// This overload gives control over the attachments of the
+    /// render-texture: a non-zero \a settings.depthBits requests
+    /// a depth buffer, and a non-zero \a settings.antialiasingLevel
+    /// requests multisample anti-aliasing. Other members of the
+    /// structure are ignored.
+    ///
+    /// When anti-aliasing is enabled, drawing happens into
+    /// multisampled buffers which are resolved into the target
+    /// textures every time display() is called. If the requested
+    /// level exceeds getMaximumAntialiasingLevel(), the maximum
+    /// supported level is used instead.
+    ///
+    /// The \a attachmentCount parameter sets the number of
+    /// target textures written simultaneously (multiple render
+    /// targets). A fragment shader writes to the texture at
+    /// index \em i through gl_FragData[i]; without a shader, only
+    /// the first texture receives the drawn pixels.
+    ///
+    /// \param width           Width of the render-texture
+    /// \param height          Height of the render-texture
+    /// \param settings        Additional settings for the underlying OpenGL attachments
+    /// \param attachmentCount Number of target textures, between 1 and getMaximumAttachmentCount()
+    ///
+    /// \return True if creation has been successful
+    ///
+    /// \see getMaximumAntialiasingLevel, getMaximumAttachmentCount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, const ContextSettings& settings, unsigned int attachmentCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum anti-aliasing level supported by the system
+    ///
+    /// \return The maximum anti-aliasing level supported by the system
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAntialiasingLevel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of target textures supported by the system
+    ///
+    /// This is the largest value that can be passed as the
+    /// \a attachmentCount parameter of create. It is 1 if the
+    /// system doesn't support multiple render targets.
+    ///
+    /// \return The maximum number of simultaneous target textures
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture smoothing
     ///
@@ -187,7 +242,7 @@ public:
     virtual Vector2u getSize() const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Get a read-only reference to the target texture
+    /// \brief Get a read-only reference to a target texture
     ///
     /// After drawing to the render-texture and calling Display,
     /// you can retrieve the updated texture using this function,
@@ -197,18 +252,31 @@ public:
     /// once and keep a reference to the texture even after it is
     /// modified.
     ///
+    /// \param index Index of the color attachment, must be lower than getAttachmentCount()
+    ///
     /// \return Const reference to the texture
     ///
+    /// \see getAttachmentCount
+    ///
     ////////////////////////////////////////////////////////////
-    const Texture& getTexture() const;
+    const Texture& getTexture(unsigned int index = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of target textures
+    ///
+    /// \return Number of color attachments the render-texture draws to
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getAttachmentCount() const;
 
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::RenderTextureImpl* m_impl;    ///< Platform/hardware specific implementation
-    Texture                  m_texture; ///< Target texture to draw on
+    priv::RenderTextureImpl* m_impl;        ///< Platform/hardware specific implementation
+    Texture                  m_texture;     ///< Target texture to draw on
+    std::vector<Texture*>    m_attachments; ///< Additional target textures, for multiple render targets
 };
 
 } // namespace sf
@@ -278,6 +346,16 @@ private:
 /// and regular SFML drawing commands. If you need a depth buffer for
 /// 3D rendering, don't forget to request it when calling RenderTexture::create.
 ///
-/// \see sf::RenderTarget, sf::RenderWindow, sf::View, sf::Texture
+/// Anti-aliased off-screen rendering is available through the
+/// sf::ContextSettings overload of create: the multisampled contents
+/// are resolved into the target texture by display(). The same
+/// overload can attach several target textures that a fragment
+/// shader fills in a single pass (see getTexture(unsigned int)).
+///
+/// Creating a render-texture allocates several OpenGL objects;
+/// if you need temporary render-textures every frame, consider
+/// recycling them with sf::RenderTexturePool.
+///
+/// \see sf::RenderTarget, sf::RenderWindow, sf::View, sf::Texture, sf::RenderTexturePool
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERTEXTUREPOOL_HPP
+#define SFML_RENDERTEXTUREPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Recycles render-textures of identical size and settings
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderTexturePool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroys all the render-textures owned by the pool,
+    /// including the ones that have not been released.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a render-texture from the pool
+    ///
+    /// If a released render-texture with the same size and
+    /// settings is available, it is handed out again; otherwise
+    /// a new one is created. A recycled render-texture is reset
+    /// to its default view and has smoothing and repeating
+    /// disabled, but its contents are left as they were: clear
+    /// it before drawing.
+    ///
+    /// The returned render-texture is owned by the pool and
+    /// must be given back with release once it is not needed
+    /// anymore.
+    ///
+    /// \param width           Width of the render-texture
+    /// \param height          Height of the render-texture
+    /// \param settings        Settings of the render-texture (see RenderTexture::create)
+    /// \param attachmentCount Number of target textures of the render-texture
+    ///
+    /// \return Pointer to the render-texture, or NULL if it couldn't be created
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* acquire(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings(), unsigned int attachmentCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a render-texture back to the pool
+    ///
+    /// The render-texture becomes available for future calls
+    /// to acquire. Passing a pointer that wasn't obtained from
+    /// this pool has no effect.
+    ///
+    /// \param renderTexture Render-texture to release
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(RenderTexture* renderTexture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the render-textures that are not in use
+    ///
+    /// Call this function when the set of effects changes
+    /// (for example after a resize of the window) to free the
+    /// render-textures that will not be requested again.
+    ///
+    ////////////////////////////////////////////////////////////
+    void shrink();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total number of render-textures owned by the pool
+    ///
+    /// \return Number of render-textures, in use or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render-textures available for recycling
+    ///
+    /// \return Number of released render-textures
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getAvailableCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render-texture owned by the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        RenderTexture*  renderTexture;   ///< The render-texture
+        unsigned int    width;           ///< Width it was created with
+        unsigned int    height;          ///< Height it was created with
+        ContextSettings settings;        ///< Settings it was created with
+        unsigned int    attachmentCount; ///< Number of target textures it was created with
+        bool            inUse;           ///< Has it been handed out?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Entry> m_entries; ///< All the render-textures owned by the pool
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTEXTUREPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderTexturePool
+/// \ingroup graphics
+///
+/// Creating a sf::RenderTexture is expensive: it allocates a
+/// texture, a frame buffer object, optional depth and multisample
+/// buffers and an OpenGL context. Effects that need temporary
+/// render-textures every frame should not create them over and
+/// over again; sf::RenderTexturePool keeps them alive and hands
+/// them out again to any request with the same size and settings.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+///
+/// while (window.isOpen())
+/// {
+///     // Get a 4x anti-aliased intermediate target
+///     sf::RenderTexture* target = pool.acquire(800, 600, sf::ContextSettings(0, 0, 4));
+///     target->clear();
+///     target->draw(scene);
+///     target->display();
+///
+///     window.draw(sf::Sprite(target->getTexture()), &effect);
+///
+///     // Give it back, the next frame will reuse it
+///     pool.release(target);
+/// }
+/// \endcode
+///
+/// \see sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,412 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SCENENODE_HPP
+#define SFML_SCENENODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Node of a hierarchy of transformed drawables
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SceneNode : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Drawable and its final transform, as produced by flatten
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DrawItem
+    {
+        const Drawable* drawable;  ///< Drawable to draw
+        Transform       transform; ///< World transform of the node holding the drawable
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a node with no parent, no children and no drawable.
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The node is detached from its parent and its children
+    /// become roots.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SceneNode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a child to the node
+    ///
+    /// If \a child already has a parent, it is detached from it
+    /// first. The node doesn't own its children: they must be
+    /// detached or destroyed by the caller. Attaching a node to
+    /// one of its own descendants is not allowed.
+    ///
+    /// \param child Node to attach
+    ///
+    /// \see detachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachChild(SceneNode& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a child from the node
+    ///
+    /// This function does nothing if \a child is not a child of
+    /// this node.
+    ///
+    /// \param child Node to detach
+    ///
+    /// \see attachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachChild(SceneNode& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of the node
+    ///
+    /// \return Pointer to the parent, NULL if the node is a root
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode* getParent() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of children of the node
+    ///
+    /// \return Number of children
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChildCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a child of the node
+    ///
+    /// The result is undefined if \a index is out of range.
+    ///
+    /// \param index Index of the child, in range [0 .. getChildCount() - 1]
+    ///
+    /// \return Reference to the child
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode& getChild(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the drawable displayed by the node
+    ///
+    /// The drawable is drawn with the world transform of the
+    /// node, combined with its own transform if it has one.
+    /// \a drawable can be NULL for nodes that only group other
+    /// nodes. It must exist as long as the node uses it.
+    ///
+    /// \param drawable Drawable to display
+    ///
+    /// \see getDrawable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDrawable(const Drawable* drawable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the drawable displayed by the node
+    ///
+    /// \return Pointer to the drawable, NULL if there's none
+    ///
+    /// \see setDrawable
+    ///
+    ////////////////////////////////////////////////////////////
+    const Drawable* getDrawable() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Show or hide the node and its descendants
+    ///
+    /// Hidden subtrees are skipped when drawing and flattening.
+    /// Nodes are visible by default.
+    ///
+    /// \param visible True to show the node, false to hide it
+    ///
+    /// \see isVisible
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVisible(bool visible);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the node is visible
+    ///
+    /// \return True if the node is visible
+    ///
+    /// \see setVisible
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isVisible() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of the node relative to its parent
+    ///
+    /// \param x X coordinate of the new position
+    /// \param y Y coordinate of the new position
+    ///
+    /// \see Transformable::setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(float x, float y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of the node relative to its parent
+    ///
+    /// \param position New position
+    ///
+    /// \see Transformable::setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the orientation of the node relative to its parent
+    ///
+    /// \param angle New rotation, in degrees
+    ///
+    /// \see Transformable::setRotation
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of the node relative to its parent
+    ///
+    /// \param factorX New horizontal scale factor
+    /// \param factorY New vertical scale factor
+    ///
+    /// \see Transformable::setScale
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(float factorX, float factorY);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of the node relative to its parent
+    ///
+    /// \param factors New scale factors
+    ///
+    /// \see Transformable::setScale
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(const Vector2f& factors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of the node
+    ///
+    /// \param x X coordinate of the new origin
+    /// \param y Y coordinate of the new origin
+    ///
+    /// \see Transformable::setOrigin
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(float x, float y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of the node
+    ///
+    /// \param origin New origin
+    ///
+    /// \see Transformable::setOrigin
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the node by a given offset
+    ///
+    /// \param offsetX X offset
+    /// \param offsetY Y offset
+    ///
+    /// \see Transformable::move
+    ///
+    ////////////////////////////////////////////////////////////
+    void move(float offsetX, float offsetY);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the node by a given offset
+    ///
+    /// \param offset Offset
+    ///
+    /// \see Transformable::move
+    ///
+    ////////////////////////////////////////////////////////////
+    void move(const Vector2f& offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rotate the node
+    ///
+    /// \param angle Angle of rotation, in degrees
+    ///
+    /// \see Transformable::rotate
+    ///
+    ////////////////////////////////////////////////////////////
+    void rotate(float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scale the node
+    ///
+    /// \param factorX Horizontal scale factor
+    /// \param factorY Vertical scale factor
+    ///
+    /// \see Transformable::scale
+    ///
+    ////////////////////////////////////////////////////////////
+    void scale(float factorX, float factorY);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scale the node
+    ///
+    /// \param factor Scale factors
+    ///
+    /// \see Transformable::scale
+    ///
+    ////////////////////////////////////////////////////////////
+    void scale(const Vector2f& factor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the combined transform of the node and all its ancestors
+    ///
+    /// The world transform is cached, and only recomputed after
+    /// the node or one of its ancestors moved.
+    ///
+    /// \return World transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    const Transform& getWorldTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append the drawables of the subtree to a list
+    ///
+    /// The visible nodes holding a drawable are appended in
+    /// drawing order (parents before their children, children
+    /// in the order they were attached) with their world
+    /// transform. The list can then be sorted or batched before
+    /// being drawn.
+    ///
+    /// \param items List to append to
+    ///
+    ////////////////////////////////////////////////////////////
+    void flatten(std::vector<DrawItem>& items) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the subtree to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Invalidate the world transform of the subtree
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateWorldTransform();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SceneNode*              m_parent;                   ///< Parent of the node
+    std::vector<SceneNode*> m_children;                 ///< Children of the node, in drawing order
+    const Drawable*         m_drawable;                 ///< Drawable displayed by the node
+    bool                    m_visible;                  ///< Is the subtree drawn?
+    mutable Transform       m_worldTransform;           ///< Combined transform of the node and its ancestors
+    mutable bool            m_worldTransformNeedUpdate; ///< Does the world transform need to be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SCENENODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SceneNode
+/// \ingroup graphics
+///
+/// sf::SceneNode organizes drawables in a tree, where each
+/// node is positioned relative to its parent: moving a node
+/// moves its whole subtree.
+///
+/// Each node caches its world transform (the product of the
+/// transforms of its ancestors and its own). Changing a node's
+/// transform only marks the subtree below it as outdated, and
+/// world transforms are recomputed lazily when needed, so
+/// drawing a tree where nothing moved doesn't do any matrix
+/// multiplication.
+///
+/// Nodes don't own their children nor their drawable; they only
+/// keep pointers to them.
+///
+/// sf::SceneNode hides the setters of sf::Transformable with its
+/// own versions, which invalidate the cached world transforms.
+/// Always modify a node through a sf::SceneNode reference, not
+/// through a sf::Transformable reference, otherwise the change
+/// will go unnoticed.
+///
+/// Usage example:
+/// \code
+/// sf::Sprite body(bodyTexture);
+/// sf::Sprite arm(armTexture);
+///
+/// sf::SceneNode character;
+/// character.setDrawable(&body);
+///
+/// sf::SceneNode shoulder;
+/// shoulder.setDrawable(&arm);
+/// shoulder.setPosition(20, 10);
+/// character.attachChild(shoulder);
+///
+/// character.move(5, 0);   // the arm follows
+/// shoulder.rotate(30);    // only the arm rotates
+///
+/// window.draw(character);
+///
+/// // Or collect the drawables to batch them
+/// std::vector<sf::SceneNode::DrawItem> items;
+/// character.flatten(items);
+/// \endcode
+///
+/// \see sf::Transformable
+///
+////////////////////////////////////////////////////////////
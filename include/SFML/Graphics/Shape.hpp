@@ -262,6 +262,11 @@ protected:
     /// the shape's points change (i.e. the result of either
     /// getPointCount or getPoint is different).
     ///
+    /// The geometry is not recomputed immediately: it is rebuilt
+    /// the next time the shape is drawn or its bounds are
+    /// requested, so calling this function several times in a
+    /// row is cheap.
+    ///
     ////////////////////////////////////////////////////////////
     void update();
 
@@ -276,44 +281,57 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the parts of the geometry that changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the fill vertices' position and the inside bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePoints() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' color
     ///
     ////////////////////////////////////////////////////////////
-    void updateFillColors();
+    void updateFillColors() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' texture coordinates
     ///
     ////////////////////////////////////////////////////////////
-    void updateTexCoords();
+    void updateTexCoords() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' position
     ///
     ////////////////////////////////////////////////////////////
-    void updateOutline();
+    void updateOutline() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' color
     ///
     ////////////////////////////////////////////////////////////
-    void updateOutlineColors();
+    void updateOutlineColors() const;
 
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Texture* m_texture;          ///< Texture of the shape
-    IntRect        m_textureRect;      ///< Rectangle defining the area of the source texture to display
-    Color          m_fillColor;        ///< Fill color
-    Color          m_outlineColor;     ///< Outline color
-    float          m_outlineThickness; ///< Thickness of the shape's outline
-    VertexArray    m_vertices;         ///< Vertex array containing the fill geometry
-    VertexArray    m_outlineVertices;  ///< Vertex array containing the outline geometry
-    FloatRect      m_insideBounds;     ///< Bounding rectangle of the inside (fill)
-    FloatRect      m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    const Texture*       m_texture;          ///< Texture of the shape
+    IntRect              m_textureRect;      ///< Rectangle defining the area of the source texture to display
+    Color                m_fillColor;        ///< Fill color
+    Color                m_outlineColor;     ///< Outline color
+    float                m_outlineThickness; ///< Thickness of the shape's outline
+    mutable VertexArray  m_vertices;         ///< Vertex array containing the fill geometry
+    mutable VertexArray  m_outlineVertices;  ///< Vertex array containing the outline geometry
+    mutable FloatRect    m_insideBounds;     ///< Bounding rectangle of the inside (fill)
+    mutable FloatRect    m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    mutable unsigned int m_dirty;            ///< Parts of the geometry that must be recomputed before use
 };
 
 } // namespace sf
@@ -0,0 +1,341 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPATIALINDEX_HPP
+#define SFML_SPATIALINDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Container finding the objects located in a region
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class SpatialIndex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an object stored in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::size_t Id;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The bounds define the area where objects are expected
+    /// to be; objects outside of it are still supported, but
+    /// they are always tested by queries. The number of
+    /// subdivision levels defines how small the smallest
+    /// cells are: there are 4^depth cells at the deepest level.
+    ///
+    /// \param bounds Area covered by the index
+    /// \param depth  Number of subdivision levels
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpatialIndex(const FloatRect& bounds = FloatRect(0, 0, 1024, 1024), unsigned int depth = 6);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an object
+    ///
+    /// \param rect  Bounding rectangle of the object
+    /// \param value Value to store with the object
+    ///
+    /// \return Identifier of the new object
+    ///
+    ////////////////////////////////////////////////////////////
+    Id insert(const FloatRect& rect, const T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the bounding rectangle of an object
+    ///
+    /// The result is undefined if \a id doesn't identify an
+    /// object of the index.
+    ///
+    /// \param id   Identifier of the object
+    /// \param rect New bounding rectangle of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void move(Id id, const FloatRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an object
+    ///
+    /// The identifier may be reused by objects inserted later.
+    /// The result is undefined if \a id doesn't identify an
+    /// object of the index.
+    ///
+    /// \param id Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the objects
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of objects
+    ///
+    /// \return Number of objects in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Access the value of an object
+    ///
+    /// \param id Identifier of the object
+    ///
+    /// \return Reference to the value of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    T& operator [](Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Access the value of an object (read-only)
+    ///
+    /// \param id Identifier of the object
+    ///
+    /// \return Const reference to the value of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    const T& operator [](Id id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of an object
+    ///
+    /// \param id Identifier of the object
+    ///
+    /// \return Bounding rectangle of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect& getRect(Id id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the objects intersecting a region
+    ///
+    /// The identifiers of the objects whose bounding rectangle
+    /// intersects \a region (as defined by FloatRect::intersects)
+    /// are appended to \a results, in no particular order.
+    ///
+    /// \param region  Region to search
+    /// \param results Array to append the identifiers to
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const FloatRect& region, std::vector<Id>& results) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the objects containing a point
+    ///
+    /// The identifiers of the objects whose bounding rectangle
+    /// contains \a point (as defined by FloatRect::contains)
+    /// are appended to \a results, in no particular order.
+    ///
+    /// \param point   Point to search
+    /// \param results Array to append the identifiers to
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const Vector2f& point, std::vector<Id>& results) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the area covered by the index
+    ///
+    /// All the objects are redistributed at once, which is
+    /// cheaper than removing and inserting them again. Their
+    /// identifiers don't change.
+    ///
+    /// \param bounds New area covered by the index
+    /// \param depth  New number of subdivision levels
+    ///
+    ////////////////////////////////////////////////////////////
+    void rebuild(const FloatRect& bounds, unsigned int depth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area covered by the index
+    ///
+    /// \return Area covered by the index
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect& getBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Object stored in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Item
+    {
+        T            value;    ///< Value stored with the object
+        FloatRect    rect;     ///< Bounding rectangle of the object
+        std::size_t  cell;     ///< Index of the cell containing the object
+        unsigned int level;    ///< Level of the cell containing the object
+        Id           next;     ///< Next object in the same cell
+        Id           previous; ///< Previous object in the same cell
+        bool         used;     ///< Is the item used by an object?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the cell where an object belongs
+    ///
+    /// \param rect  Bounding rectangle of the object
+    /// \param level Filled with the level of the cell
+    ///
+    /// \return Index of the cell
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findCell(const FloatRect& rect, unsigned int& level) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an item to the list of the cell where it belongs
+    ///
+    /// \param id Identifier of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    void link(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an item from the list of its cell
+    ///
+    /// \param id Identifier of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlink(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Test the objects of a cell against a region
+    ///
+    /// \param cell    Index of the cell
+    /// \param region  Region to search
+    /// \param results Array to append the identifiers to
+    ///
+    ////////////////////////////////////////////////////////////
+    void queryCell(std::size_t cell, const FloatRect& region, std::vector<Id>& results) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Test the objects of a cell against a point
+    ///
+    /// \param cell    Index of the cell
+    /// \param point   Point to search
+    /// \param results Array to append the identifiers to
+    ///
+    ////////////////////////////////////////////////////////////
+    void queryCell(std::size_t cell, const Vector2f& point, std::vector<Id>& results) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Visit the cells whose loose bounds overlap an area
+    ///
+    /// \param left    Left coordinate of the area
+    /// \param top     Top coordinate of the area
+    /// \param right   Right coordinate of the area
+    /// \param bottom  Bottom coordinate of the area
+    /// \param tester  Region or point to test the objects against
+    /// \param results Array to append the identifiers to
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename U>
+    void queryCells(float left, float top, float right, float bottom, const U& tester, std::vector<Id>& results) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FloatRect                m_bounds;      ///< Area covered by the index
+    unsigned int             m_depth;       ///< Number of subdivision levels
+    std::vector<Item>        m_items;       ///< Storage of the objects, indexed by identifier
+    std::vector<Id>          m_freeIds;     ///< Identifiers of the unused items
+    std::vector<Id>          m_cells;       ///< First object of each cell, level by level, plus one cell for the objects that fit nowhere
+    std::vector<std::size_t> m_levelCounts; ///< Number of objects at each level, to skip the empty ones
+    std::size_t              m_size;        ///< Number of objects
+};
+
+#include <SFML/Graphics/SpatialIndex.inl>
+
+} // namespace sf
+
+
+#endif // SFML_SPATIALINDEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpatialIndex
+/// \ingroup graphics
+///
+/// sf::SpatialIndex stores objects along with their bounding
+/// rectangle, and quickly finds the ones that overlap a region
+/// or contain a point. Typical uses are mouse picking, collision
+/// broad phases and culling the objects outside of a view.
+///
+/// It is implemented as a loose quadtree: the area covered by
+/// the index is recursively split in 4, and each object is
+/// stored in a single cell, at the level whose cells are as big
+/// as the object, in the cell that contains its center. Cells
+/// are considered twice as big as they really are when they are
+/// searched, so that they fully enclose their objects. Thanks to
+/// this, inserting, moving and removing an object is done in
+/// constant time, and a query only visits the few cells of each
+/// level that overlap the searched region.
+///
+/// Usage example:
+/// \code
+/// sf::SpatialIndex<sf::Sprite*> index(sf::FloatRect(0, 0, 4096, 4096));
+///
+/// std::vector<sf::SpatialIndex<sf::Sprite*>::Id> ids;
+/// for (std::size_t i = 0; i < sprites.size(); ++i)
+///     ids.push_back(index.insert(sprites[i].getGlobalBounds(), &sprites[i]));
+///
+/// // When a sprite moves
+/// index.move(ids[i], sprites[i].getGlobalBounds());
+///
+/// // Draw only the visible sprites
+/// const sf::View& view = window.getView();
+/// sf::FloatRect visibleArea(view.getCenter() - view.getSize() / 2.f, view.getSize());
+///
+/// std::vector<sf::SpatialIndex<sf::Sprite*>::Id> visible;
+/// index.query(visibleArea, visible);
+/// for (std::size_t i = 0; i < visible.size(); ++i)
+///     window.draw(*index[visible[i]]);
+///
+/// // Find the sprites under the mouse cursor
+/// std::vector<sf::SpatialIndex<sf::Sprite*>::Id> picked;
+/// index.query(window.mapPixelToCoords(sf::Mouse::getPosition(window)), picked);
+/// \endcode
+///
+/// \see sf::Rect
+///
+////////////////////////////////////////////////////////////
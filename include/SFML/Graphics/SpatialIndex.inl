@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+template <typename T>
+SpatialIndex<T>::SpatialIndex(const FloatRect& bounds, unsigned int depth) :
+m_bounds     (),
+m_depth      (0),
+m_items      (),
+m_freeIds    (),
+m_cells      (),
+m_levelCounts(),
+m_size       (0)
+{
+    rebuild(bounds, depth);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename SpatialIndex<T>::Id SpatialIndex<T>::insert(const FloatRect& rect, const T& value)
+{
+    Id id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_items[id].value = value;
+    }
+    else
+    {
+        id = m_items.size();
+        m_items.push_back(Item());
+        m_items[id].value = value;
+    }
+
+    m_items[id].rect = rect;
+    m_items[id].used = true;
+    link(id);
+    ++m_size;
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::move(Id id, const FloatRect& rect)
+{
+    Item& item = m_items[id];
+    item.rect = rect;
+
+    // Only relink the object if it changed cell
+    unsigned int level;
+    if (findCell(rect, level) != item.cell)
+    {
+        unlink(id);
+        link(id);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::remove(Id id)
+{
+    unlink(id);
+
+    m_items[id].used = false;
+    m_items[id].value = T();
+    m_freeIds.push_back(id);
+    --m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::clear()
+{
+    m_items.clear();
+    m_freeIds.clear();
+    std::fill(m_cells.begin(), m_cells.end(), static_cast<Id>(-1));
+    std::fill(m_levelCounts.begin(), m_levelCounts.end(), 0);
+    m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpatialIndex<T>::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T& SpatialIndex<T>::operator [](Id id)
+{
+    return m_items[id].value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const T& SpatialIndex<T>::operator [](Id id) const
+{
+    return m_items[id].value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const FloatRect& SpatialIndex<T>::getRect(Id id) const
+{
+    return m_items[id].rect;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::query(const FloatRect& region, std::vector<Id>& results) const
+{
+    float left   = std::min(region.left, region.left + region.width);
+    float top    = std::min(region.top, region.top + region.height);
+    float right  = std::max(region.left, region.left + region.width);
+    float bottom = std::max(region.top, region.top + region.height);
+
+    queryCells(left, top, right, bottom, region, results);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::query(const Vector2f& point, std::vector<Id>& results) const
+{
+    queryCells(point.x, point.y, point.x, point.y, point, results);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::rebuild(const FloatRect& bounds, unsigned int depth)
+{
+    m_bounds = bounds;
+    m_depth = depth;
+
+    // Level d has 4^d cells, stored after the (4^d - 1) / 3 cells of the previous
+    // levels; the last cell holds the objects that don't fit in any level
+    std::size_t cellCount = ((std::size_t(1) << (2 * (depth + 1))) - 1) / 3;
+    m_cells.assign(cellCount + 1, static_cast<Id>(-1));
+    m_levelCounts.assign(depth + 2, 0);
+
+    for (Id id = 0; id < m_items.size(); ++id)
+    {
+        if (m_items[id].used)
+            link(id);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const FloatRect& SpatialIndex<T>::getBounds() const
+{
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpatialIndex<T>::findCell(const FloatRect& rect, unsigned int& level) const
+{
+    float width  = std::abs(rect.width);
+    float height = std::abs(rect.height);
+    float x = rect.left + rect.width / 2 - m_bounds.left;
+    float y = rect.top + rect.height / 2 - m_bounds.top;
+
+    // Objects centered outside of the bounds, or bigger than them, fit nowhere
+    if ((x < 0) || (y < 0) || (x >= m_bounds.width) || (y >= m_bounds.height) ||
+        (width > m_bounds.width) || (height > m_bounds.height))
+    {
+        level = m_depth + 1;
+        return m_cells.size() - 1;
+    }
+
+    // Go down as long as the object fits in a cell of the next level
+    float cellWidth = m_bounds.width;
+    float cellHeight = m_bounds.height;
+    level = 0;
+    while ((level < m_depth) && (width <= cellWidth / 2) && (height <= cellHeight / 2))
+    {
+        cellWidth /= 2;
+        cellHeight /= 2;
+        ++level;
+    }
+
+    // Pick the cell containing the center of the object
+    std::size_t side = std::size_t(1) << level;
+    std::size_t column = std::min(static_cast<std::size_t>(x / cellWidth), side - 1);
+    std::size_t row = std::min(static_cast<std::size_t>(y / cellHeight), side - 1);
+    std::size_t offset = ((std::size_t(1) << (2 * level)) - 1) / 3;
+
+    return offset + row * side + column;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::link(Id id)
+{
+    Item& item = m_items[id];
+    item.cell = findCell(item.rect, item.level);
+    item.previous = static_cast<Id>(-1);
+    item.next = m_cells[item.cell];
+
+    if (item.next != static_cast<Id>(-1))
+        m_items[item.next].previous = id;
+    m_cells[item.cell] = id;
+
+    ++m_levelCounts[item.level];
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::unlink(Id id)
+{
+    Item& item = m_items[id];
+
+    if (item.previous != static_cast<Id>(-1))
+        m_items[item.previous].next = item.next;
+    else
+        m_cells[item.cell] = item.next;
+
+    if (item.next != static_cast<Id>(-1))
+        m_items[item.next].previous = item.previous;
+
+    --m_levelCounts[item.level];
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::queryCell(std::size_t cell, const FloatRect& region, std::vector<Id>& results) const
+{
+    for (Id id = m_cells[cell]; id != static_cast<Id>(-1); id = m_items[id].next)
+    {
+        if (m_items[id].rect.intersects(region))
+            results.push_back(id);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::queryCell(std::size_t cell, const Vector2f& point, std::vector<Id>& results) const
+{
+    for (Id id = m_cells[cell]; id != static_cast<Id>(-1); id = m_items[id].next)
+    {
+        if (m_items[id].rect.contains(point))
+            results.push_back(id);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+template <typename U>
+void SpatialIndex<T>::queryCells(float left, float top, float right, float bottom, const U& tester, std::vector<Id>& results) const
+{
+    left   -= m_bounds.left;
+    top    -= m_bounds.top;
+    right  -= m_bounds.left;
+    bottom -= m_bounds.top;
+
+    float cellWidth = m_bounds.width;
+    float cellHeight = m_bounds.height;
+
+    for (unsigned int level = 0; level <= m_depth; ++level, cellWidth /= 2, cellHeight /= 2)
+    {
+        if (m_levelCounts[level] == 0)
+            continue;
+
+        // Objects may stick out of their cell by up to half a cell on each
+        // side; add a little more to absorb rounding errors
+        float marginX = cellWidth * 0.51f;
+        float marginY = cellHeight * 0.51f;
+        float side = static_cast<float>(std::size_t(1) << level);
+
+        float firstColumn = std::max(std::floor((left - marginX) / cellWidth), 0.f);
+        float firstRow    = std::max(std::floor((top - marginY) / cellHeight), 0.f);
+        float lastColumn  = std::min(std::floor((right + marginX) / cellWidth), side - 1);
+        float lastRow     = std::min(std::floor((bottom + marginY) / cellHeight), side - 1);
+        if ((firstColumn > lastColumn) || (firstRow > lastRow))
+            continue;
+
+        std::size_t offset = ((std::size_t(1) << (2 * level)) - 1) / 3;
+        std::size_t stride = std::size_t(1) << level;
+        for (std::size_t row = static_cast<std::size_t>(firstRow); row <= static_cast<std::size_t>(lastRow); ++row)
+        {
+            for (std::size_t column = static_cast<std::size_t>(firstColumn); column <= static_cast<std::size_t>(lastColumn); ++column)
+                queryCell(offset + row * stride + column, tester, results);
+        }
+    }
+
+    // Objects that fit nowhere are always tested
+    if (m_levelCounts[m_depth + 1] > 0)
+        queryCell(m_cells.size() - 1, tester, results);
+}
@@ -0,0 +1,405 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Container drawing large amounts of sprites efficiently
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite displaying a whole texture
+    ///
+    /// The texture must exist as long as the batch uses it.
+    ///
+    /// \param texture  Texture of the sprite
+    /// \param position Position of the sprite
+    ///
+    /// \return Identifier of the new sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Texture& texture, const Vector2f& position = Vector2f(0, 0));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite displaying a sub-rectangle of a texture
+    ///
+    /// The texture must exist as long as the batch uses it.
+    ///
+    /// \param texture     Texture of the sprite
+    /// \param textureRect Sub-rectangle of the texture to display
+    /// \param position    Position of the sprite
+    ///
+    /// \return Identifier of the new sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Texture& texture, const IntRect& textureRect, const Vector2f& position = Vector2f(0, 0));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a sprite from the batch
+    ///
+    /// The identifiers of the other sprites remain valid; the
+    /// identifier of the removed sprite may be reused by a
+    /// future call to add.
+    ///
+    /// \param sprite Identifier of the sprite to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t sprite);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sprites in the batch
+    ///
+    /// \return Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSpriteCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a sprite
+    ///
+    /// \param sprite   Identifier of the sprite
+    /// \param position New position
+    ///
+    /// \see getPosition, move
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(std::size_t sprite, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the orientation of a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    /// \param angle  New rotation, in degrees
+    ///
+    /// \see getRotation, rotate
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(std::size_t sprite, float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of a sprite
+    ///
+    /// \param sprite  Identifier of the sprite
+    /// \param factors New scale factors
+    ///
+    /// \see getScale
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(std::size_t sprite, const Vector2f& factors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    /// \param origin New origin, relative to the top-left corner of the sprite
+    ///
+    /// \see getOrigin
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(std::size_t sprite, const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sub-rectangle of the texture that a sprite displays
+    ///
+    /// \param sprite      Identifier of the sprite
+    /// \param textureRect Rectangle defining the region of the texture to display
+    ///
+    /// \see getTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(std::size_t sprite, const IntRect& textureRect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the global color of a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    /// \param color  New color of the sprite
+    ///
+    /// \see getColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(std::size_t sprite, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move a sprite by a given offset
+    ///
+    /// \param sprite Identifier of the sprite
+    /// \param offset Offset
+    ///
+    /// \see setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void move(std::size_t sprite, const Vector2f& offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rotate a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    /// \param angle  Angle of rotation, in degrees
+    ///
+    /// \see setRotation
+    ///
+    ////////////////////////////////////////////////////////////
+    void rotate(std::size_t sprite, float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    ///
+    /// \return Current position
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getPosition(std::size_t sprite) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the orientation of a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    ///
+    /// \return Current rotation, in degrees, in the range [0, 360]
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRotation(std::size_t sprite) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scale factors of a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    ///
+    /// \return Current scale factors
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getScale(std::size_t sprite) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local origin of a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    ///
+    /// \return Current origin
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getOrigin(std::size_t sprite) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture displayed by a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    ///
+    /// \return Texture rectangle of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect(std::size_t sprite) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global color of a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    ///
+    /// \return Global color of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getColor(std::size_t sprite) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of a sprite
+    ///
+    /// \param sprite Identifier of the sprite
+    ///
+    /// \return Texture of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(std::size_t sprite) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads used to update the geometry
+    ///
+    /// When many sprites change between two draws, their
+    /// vertices can be regenerated on several threads. A value
+    /// of 0 uses one thread per processor. The default is 1,
+    /// which updates the geometry in the drawing thread only.
+    ///
+    /// \param count Maximum number of threads
+    ///
+    /// \see getThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads used to update the geometry
+    ///
+    /// \return Maximum number of threads, 0 meaning one per processor
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the sprites to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark some attributes of a sprite as modified
+    ///
+    /// \param sprite Identifier of the sprite
+    /// \param flags  Combination of the attributes that changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t sprite, Uint8 flags);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sprites sharing the same texture, in structure-of-arrays form
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        const Texture*               texture;      ///< Texture shared by the sprites
+        std::vector<Vector2f>        positions;    ///< Position of each sprite
+        std::vector<float>           rotations;    ///< Rotation of each sprite, in degrees
+        std::vector<Vector2f>        scales;       ///< Scale factors of each sprite
+        std::vector<Vector2f>        origins;      ///< Local origin of each sprite
+        std::vector<IntRect>         textureRects; ///< Texture rectangle of each sprite
+        std::vector<Color>           colors;       ///< Color of each sprite
+        std::vector<std::size_t>     ids;          ///< Identifier of each sprite
+        mutable std::vector<Uint8>   dirty;        ///< Attributes of each sprite modified since the last draw
+        mutable std::vector<Vertex>  vertices;     ///< Two triangles per sprite
+        mutable bool                 needsUpdate;  ///< Does any sprite need its vertices to be updated?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of a sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Location
+    {
+        std::size_t batch; ///< Index of the batch
+        std::size_t index; ///< Index of the sprite in its batch
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Batch>       m_batches;     ///< One batch per texture
+    std::vector<Location>    m_locations;   ///< Location of each sprite, indexed by identifier
+    std::vector<std::size_t> m_freeIds;     ///< Identifiers of removed sprites, available for reuse
+    std::size_t              m_spriteCount; ///< Number of sprites in the batch
+    unsigned int             m_threadCount; ///< Maximum number of threads used to update the vertices
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch stores many sprites and draws them with a
+/// single draw call per texture, instead of one per sf::Sprite.
+///
+/// The attributes of the sprites (position, rotation, scale,
+/// origin, texture rectangle and color) are stored in separate
+/// contiguous arrays rather than in individual sf::Transformable
+/// objects, and only the vertices of the sprites that changed
+/// since the last draw are regenerated. When many sprites move
+/// every frame, this update can be split across several threads
+/// with setThreadCount.
+///
+/// Sprites are referred to by the identifier returned by add,
+/// which stays valid until the sprite is removed.
+///
+/// Usage example:
+/// \code
+/// sf::SpriteBatch batch;
+/// batch.setThreadCount(0); // one thread per processor
+///
+/// std::vector<std::size_t> bullets;
+/// for (int i = 0; i < 100000; ++i)
+///     bullets.push_back(batch.add(texture, sf::IntRect(0, 0, 8, 8), sf::Vector2f(rand() % 800, rand() % 600)));
+///
+/// // ...
+///
+/// for (std::size_t i = 0; i < bullets.size(); ++i)
+///     batch.move(bullets[i], velocity * elapsed);
+///
+/// window.draw(batch);
+/// \endcode
+///
+/// The sprites of a batch are grouped by texture: all the sprites
+/// using the first texture are drawn, then all the sprites using
+/// the second one, and so on. Within a texture, the drawing order
+/// is the creation order, except that removing a sprite moves the
+/// last one of its texture in its place. Use several batches if
+/// you need full control over the stacking order.
+///
+/// \see sf::Sprite, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
@@ -101,6 +101,10 @@ public:
     /// \endcode
     /// A text's string is empty by default.
     ///
+    /// Only the lines covered by the modified part of the string
+    /// are laid out again, so small edits in a long text (like
+    /// typing in a console) stay cheap.
+    ///
     /// \param string New string
     ///
     /// \see getString
@@ -217,6 +221,59 @@ public:
     ////////////////////////////////////////////////////////////
     void setOutlineThickness(float thickness);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable distance field rendering
+    ///
+    /// In distance field mode, the text uses the signed distance
+    /// field glyphs of its font (see Font::getDistanceFieldGlyph),
+    /// which are rendered once at a reference size and scaled to
+    /// the character size. The text stays sharp at any size and
+    /// zoom level, and all the character sizes share the same
+    /// glyphs. The outline and the shadow are computed by a
+    /// built-in shader instead of drawing extra glyphs; they are
+    /// limited to the range of the distance field (a few pixels
+    /// at the reference size), and underlines and strike-through
+    /// lines are drawn without them.
+    ///
+    /// Distance field mode requires shaders: if they are not
+    /// supported by the system, the text is rendered normally.
+    /// A shader passed in the render states is ignored in this mode.
+    ///
+    /// Distance field mode is disabled by default.
+    ///
+    /// \param enabled True to enable distance field rendering, false to disable it
+    ///
+    /// \see isDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceFieldEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the color of the text's shadow
+    ///
+    /// The shadow is only rendered in distance field mode.
+    /// By default, the text's shadow color is opaque black.
+    ///
+    /// \param color New shadow color of the text
+    ///
+    /// \see getShadowColor, setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setShadowColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the offset of the text's shadow
+    ///
+    /// The shadow is only rendered in distance field mode, and
+    /// only when its offset is not zero (which is the default).
+    ///
+    /// \param offset New shadow offset, in pixels
+    ///
+    /// \see getShadowOffset, setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setShadowOffset(const Vector2f& offset);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the text's string
     ///
@@ -314,6 +371,36 @@ public:
     ////////////////////////////////////////////////////////////
     float getOutlineThickness() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether distance field rendering is enabled or not
+    ///
+    /// \return True if distance field rendering is enabled, false if not
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceFieldEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shadow color of the text
+    ///
+    /// \return Shadow color of the text
+    ///
+    /// \see setShadowColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getShadowColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shadow offset of the text
+    ///
+    /// \return Shadow offset of the text, in pixels
+    ///
+    /// \see setShadowOffset
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getShadowOffset() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the position of the \a index-th character
     ///
@@ -324,13 +411,44 @@ public:
     /// If \a index is out of range, the position of the end of
     /// the string is returned.
     ///
+    /// The positions of the characters are computed along with
+    /// the geometry of the text and kept, so this function is
+    /// fast (logarithmic in the number of lines) as long as the
+    /// text doesn't change.
+    ///
     /// \param index Index of the character
     ///
     /// \return Position of the character
     ///
+    /// \see findCharacterIndex
+    ///
     ////////////////////////////////////////////////////////////
     Vector2f findCharacterPos(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the character at a given position
+    ///
+    /// This function is the inverse of findCharacterPos: it
+    /// returns the index of the character whose position is the
+    /// closest to \a point, on the line under \a point. It is
+    /// typically used to place a caret where the user clicked.
+    /// The returned index can be the index of the line break
+    /// that ends the line (the caret goes at the end of the
+    /// line), or the size of the string on the last line.
+    ///
+    /// \a point is in global coordinates (translation, rotation,
+    /// scale and origin are applied). Points above the first
+    /// line or below the last one give characters of these lines.
+    ///
+    /// \param point Point to test, in global coordinates
+    ///
+    /// \return Index of the character closest to \a point
+    ///
+    /// \see findCharacterPos
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findCharacterIndex(const Vector2f& point) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the local bounding rectangle of the entity
     ///
@@ -361,6 +479,24 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the layout of a line of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        std::size_t begin;              ///< Index of the first character of the line
+        std::size_t end;                ///< Index one past the last character of the line (after its line break, if any)
+        std::size_t vertexBegin;        ///< Index of the first fill vertex of the line
+        std::size_t vertexCount;        ///< Number of fill vertices of the line
+        std::size_t outlineVertexBegin; ///< Index of the first outline vertex of the line
+        std::size_t outlineVertexCount; ///< Number of outline vertices of the line
+        float       minX;               ///< Left coordinate of the line bounds
+        float       minY;               ///< Top coordinate of the line bounds
+        float       maxX;               ///< Right coordinate of the line bounds
+        float       maxY;               ///< Bottom coordinate of the line bounds
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -370,6 +506,28 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the text is currently rendered with distance field glyphs
+    ///
+    /// \return True if distance field mode is enabled and supported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool usesDistanceField() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the glyph of a character, as it must be displayed
+    ///
+    /// In distance field mode, the distance field glyph is
+    /// scaled to the character size.
+    ///
+    /// \param codePoint Unicode code point of the character
+    /// \param bold      Retrieve the bold version or the regular one?
+    ///
+    /// \return Glyph of \a codePoint, in pixels at the character size
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph getDisplayGlyph(Uint32 codePoint, bool bold) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Make sure the text's geometry is updated
     ///
@@ -379,20 +537,64 @@ private:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Lay out a range of lines of the string
+    ///
+    /// The range must start at the beginning of a line, and end
+    /// after a line break or at the end of the string.
+    ///
+    /// \param begin           Index of the first character of the range
+    /// \param end             Index one past the last character of the range
+    /// \param firstLine       Number of the first line of the range in the text
+    /// \param lines           Array to append the line layouts to
+    /// \param vertices        Vertex array to append the fill geometry to
+    /// \param outlineVertices Vertex array to append the outline geometry to
+    /// \param positions       Array to append the horizontal positions of the characters to (plus the end of the string, if the range reaches it)
+    ///
+    ////////////////////////////////////////////////////////////
+    void layoutLines(std::size_t begin, std::size_t end, std::size_t firstLine, std::vector<Line>& lines, VertexArray& vertices, VertexArray& outlineVertices, std::vector<float>& positions) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the line containing a character
+    ///
+    /// \param index Index of the character (the end of the string belongs to the last line)
+    ///
+    /// \return Index of the line in m_lines
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findLine(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the distance between two consecutive lines
+    ///
+    /// \return Line spacing, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    float getLineSpacing() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;             ///< String to display
-    const Font*         m_font;               ///< Font used to display the string
-    unsigned int        m_characterSize;      ///< Base size of characters, in pixels
-    Uint32              m_style;              ///< Text style (see Style enum)
-    Color               m_fillColor;          ///< Text fill color
-    Color               m_outlineColor;       ///< Text outline color
-    float               m_outlineThickness;   ///< Thickness of the text's outline
-    mutable VertexArray m_vertices;           ///< Vertex array containing the fill geometry
-    mutable VertexArray m_outlineVertices;    ///< Vertex array containing the outline geometry
-    mutable FloatRect   m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    String                     m_string;                ///< String to display
+    const Font*                m_font;                  ///< Font used to display the string
+    unsigned int               m_characterSize;         ///< Base size of characters, in pixels
+    Uint32                     m_style;                 ///< Text style (see Style enum)
+    Color                      m_fillColor;             ///< Text fill color
+    Color                      m_outlineColor;          ///< Text outline color
+    float                      m_outlineThickness;      ///< Thickness of the text's outline
+    bool                       m_distanceField;         ///< Is distance field rendering enabled?
+    Color                      m_shadowColor;           ///< Text shadow color
+    Vector2f                   m_shadowOffset;          ///< Offset of the text's shadow
+    mutable VertexArray        m_vertices;              ///< Vertex array containing the fill geometry
+    mutable VertexArray        m_outlineVertices;       ///< Vertex array containing the outline geometry
+    mutable FloatRect          m_bounds;                ///< Bounding rectangle of the text (in local coordinates)
+    mutable bool               m_geometryNeedUpdate;    ///< Does the geometry need to be recomputed?
+    mutable std::vector<Line>  m_lines;                 ///< Layout of the lines of the string
+    mutable std::vector<float> m_positions;             ///< Horizontal position of each character, and of the end of the string
+    mutable std::size_t        m_layoutSize;            ///< Size of the string when the lines were laid out
+    mutable std::size_t        m_unchangedPrefix;       ///< Number of characters at the beginning of the string unchanged since the lines were laid out
+    mutable std::size_t        m_unchangedSuffix;       ///< Number of characters at the end of the string unchanged since the lines were laid out
+    mutable Uint64             m_fontTextureGeneration; ///< Generation of the font texture when the geometry was computed
 };
 
 } // namespace sf
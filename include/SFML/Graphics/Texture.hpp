@@ -85,15 +85,25 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Create the texture
     ///
+    /// Compact pixel formats take less graphics memory and
+    /// upload faster than RGBA8: an R8 texture is 4 times
+    /// smaller. R8, RG8 and R16F require OpenGL 3.0 or the
+    /// ARB_texture_rg extension, float formats require OpenGL 3.0
+    /// or the ARB_texture_float (and ARB_half_float_pixel)
+    /// extensions; creation fails if they are unavailable.
+    /// Shaders sample components missing from the format
+    /// as 0 (green, blue) or 1 (alpha).
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param width  Width of the texture
     /// \param height Height of the texture
+    /// \param format Format of the pixels of the texture
     ///
     /// \return True if creation was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool create(unsigned int width, unsigned int height);
+    bool create(unsigned int width, unsigned int height, Image::PixelFormat format = Image::RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file on disk
@@ -201,6 +211,8 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// The texture takes the pixel format of the image.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param image Image to load into the texture
@@ -221,6 +233,16 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the format of the pixels of the texture
+    ///
+    /// \return Pixel format of the texture
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    Image::PixelFormat getPixelFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the texture pixels to an image
     ///
@@ -228,6 +250,7 @@ public:
     /// the texture's pixels from the graphics card and copies
     /// them to a new image, potentially applying transformations
     /// to pixels if necessary (texture may be padded or flipped).
+    /// The image has the pixel format of the texture.
     ///
     /// \return Image containing the texture's pixels
     ///
@@ -240,7 +263,8 @@ public:
     /// \brief Update the whole texture from an array of pixels
     ///
     /// The \a pixel array is assumed to have the same size as
-    /// the \a area rectangle, and to contain 32-bits RGBA pixels.
+    /// the \a area rectangle, and to contain pixels in the format
+    /// of the texture (32-bits RGBA pixels by default).
     ///
     /// No additional check is performed on the size of the pixel
     /// array, passing invalid arguments will lead to an undefined
@@ -258,7 +282,9 @@ public:
     /// \brief Update a part of the texture from an array of pixels
     ///
     /// The size of the \a pixel array must match the \a width and
-    /// \a height arguments, and it must contain 32-bits RGBA pixels.
+    /// \a height arguments, and it must contain pixels in the format
+    /// of the texture (32-bits RGBA pixels by default), with no
+    /// padding between rows.
     ///
     /// No additional check is performed on the size of the pixel
     /// array or the bounds of the area to update, passing invalid
@@ -325,6 +351,9 @@ public:
     /// passing an image bigger than the texture will lead to an
     /// undefined behavior.
     ///
+    /// The pixels of the image are converted to the format of
+    /// the texture if they have another one.
+    ///
     /// This function does nothing if the texture was not
     /// previously created.
     ///
@@ -340,6 +369,9 @@ public:
     /// passing an invalid combination of image size and offset
     /// will lead to an undefined behavior.
     ///
+    /// The pixels of the image are converted to the format of
+    /// the texture if they have another one.
+    ///
     /// This function does nothing if the texture was not
     /// previously created.
     ///
@@ -430,6 +462,7 @@ public:
     ///
     /// This option is only useful in conjunction with an sRGB capable
     /// framebuffer. This can be requested during window creation.
+    /// It only applies to textures of the RGBA8 and RGB8 formats.
     ///
     /// \param sRgb True to enable sRGB conversion, false to disable it
     ///
@@ -507,6 +540,29 @@ public:
     ////////////////////////////////////////////////////////////
     bool generateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a mipmap computed on the CPU
+    ///
+    /// This function is an alternative to generateMipmap, which
+    /// doesn't rely on any OpenGL extension and gives control over
+    /// the filtering of the levels. \a levels must hold every level
+    /// after the base one, as returned by Image::generateMipChain
+    /// for an image of the size of the texture.
+    ///
+    /// The function fails if the sizes of the levels don't match
+    /// the texture, or if the texture had to be padded to a power
+    /// of two size. As with generateMipmap, the mipmap is only used
+    /// until the base level image is modified.
+    ///
+    /// \param levels Levels of the mipmap, from the largest to the 1x1 one
+    ///
+    /// \return True if the mipmap was uploaded, false if unsuccessful
+    ///
+    /// \see generateMipmap, Image::generateMipChain
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateMipmap(const std::vector<Image>& levels);
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -614,16 +670,17 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u     m_size;          ///< Public texture size
-    Vector2u     m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
-    unsigned int m_texture;       ///< Internal texture identifier
-    bool         m_isSmooth;      ///< Status of the smooth filter
-    bool         m_sRgb;          ///< Should the texture source be converted from sRGB?
-    bool         m_isRepeated;    ///< Is the texture in repeat mode?
-    mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
-    bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
-    bool         m_hasMipmap;     ///< Has the mipmap been generated?
-    Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    Vector2u           m_size;          ///< Public texture size
+    Vector2u           m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
+    Image::PixelFormat m_format;        ///< Format of the pixels of the texture
+    unsigned int       m_texture;       ///< Internal texture identifier
+    bool               m_isSmooth;      ///< Status of the smooth filter
+    bool               m_sRgb;          ///< Should the texture source be converted from sRGB?
+    bool               m_isRepeated;    ///< Is the texture in repeat mode?
+    mutable bool       m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
+    bool               m_fboAttachment; ///< Is this texture owned by a framebuffer object?
+    bool               m_hasMipmap;     ///< Has the mipmap been generated?
+    Uint64             m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
 };
 
 } // namespace sf
@@ -666,10 +723,17 @@ private:
 /// store the collision information separately, for example in an array
 /// of booleans.
 ///
-/// Like sf::Image, sf::Texture can handle a unique internal
-/// representation of pixels, which is RGBA 32 bits. This means
-/// that a pixel must be composed of 8 bits red, green, blue and
-/// alpha channels -- just like a sf::Color.
+/// Like sf::Image, sf::Texture represents pixels as RGBA 32 bits
+/// by default. This means that a pixel is composed of 8 bits red,
+/// green, blue and alpha channels -- just like a sf::Color.
+/// Textures that don't need all of it, like masks, lightmaps or
+/// heightmaps, can use a more compact sf::Image::PixelFormat to
+/// save graphics memory and upload bandwidth:
+/// \code
+/// sf::Texture fogOfWar;
+/// if (!fogOfWar.create(4096, 4096, sf::Image::R8)) // 16 MB instead of 64 MB
+///     return -1;
+/// \endcode
 ///
 /// Usage example:
 /// \code
@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Grid of tiles taken from a tileset texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty tile map.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the map
+    ///
+    /// All the tiles are initially empty. The tileset is split
+    /// in a grid of \a tileSize cells, numbered from left to
+    /// right and top to bottom starting at 0. The tileset
+    /// texture must exist as long as the map uses it.
+    ///
+    /// \param tileset   Texture containing the tiles
+    /// \param tileSize  Size of a tile, in pixels
+    /// \param width     Number of columns of the map
+    /// \param height    Number of rows of the map
+    /// \param chunkSize Number of columns and rows of tiles in a chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const Texture& tileset, const Vector2u& tileSize, unsigned int width, unsigned int height, unsigned int chunkSize = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a tile
+    ///
+    /// Only the chunk containing the tile is rebuilt, the next
+    /// time the map is drawn.
+    ///
+    /// \param x    Column of the tile
+    /// \param y    Row of the tile
+    /// \param tile Index of the tile in the tileset, or a negative value for an empty tile
+    ///
+    /// \see getTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int x, unsigned int y, int tile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change all the tiles at once
+    ///
+    /// \param tiles Array of width * height tile indices, row by row
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTiles(const int* tiles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile
+    ///
+    /// \param x Column of the tile
+    /// \param y Row of the tile
+    ///
+    /// \return Index of the tile in the tileset, negative if the tile is empty
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    int getTile(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of columns and rows of the map
+    ///
+    /// \return Size of the map, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a tile
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of columns and rows of tiles in a chunk
+    ///
+    /// \return Size of a chunk, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChunkSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the tileset texture
+    ///
+    /// \return Pointer to the tileset, NULL if the map was not created
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTileset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the map
+    ///
+    /// \return Local bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the map
+    ///
+    /// \return Global bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry of a square block of tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Chunk
+    {
+        std::vector<Vertex> vertices; ///< Two triangles per non-empty tile
+        bool                dirty;    ///< Do the vertices need to be rebuilt?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the vertices of a chunk
+    ///
+    /// \param x Column of the chunk
+    /// \param y Row of the chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateChunk(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*             m_tileset;     ///< Texture containing the tiles
+    Vector2u                   m_tileSize;    ///< Size of a tile, in pixels
+    unsigned int               m_width;       ///< Number of columns of tiles
+    unsigned int               m_height;      ///< Number of rows of tiles
+    unsigned int               m_chunkSize;   ///< Number of columns and rows of tiles in a chunk
+    unsigned int               m_chunkCountX; ///< Number of columns of chunks
+    unsigned int               m_chunkCountY; ///< Number of rows of chunks
+    std::vector<int>           m_tiles;       ///< Tile indices, row by row
+    mutable std::vector<Chunk> m_chunks;      ///< Geometry of the chunks, row by row
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap draws a large grid of tiles taken from a single
+/// tileset texture.
+///
+/// The map is split into square chunks whose geometry is built
+/// once and kept until one of their tiles changes. When the map
+/// is drawn, only the chunks that intersect the current view of
+/// the render target are submitted, so the cost of drawing the
+/// map depends on the visible area rather than on the size of
+/// the map.
+///
+/// Usage example:
+/// \code
+/// sf::Texture tileset;
+/// tileset.loadFromFile("tileset.png");
+///
+/// sf::TileMap map;
+/// map.create(tileset, sf::Vector2u(16, 16), 1000, 1000);
+///
+/// for (unsigned int y = 0; y < 1000; ++y)
+///     for (unsigned int x = 0; x < 1000; ++x)
+///         map.setTile(x, y, level[x + y * 1000]);
+///
+/// window.draw(map);
+/// \endcode
+///
+/// \see sf::VertexArray, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
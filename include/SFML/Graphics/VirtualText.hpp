@@ -0,0 +1,357 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VIRTUALTEXT_HPP
+#define SFML_VIRTUALTEXT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/String.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Font;
+
+////////////////////////////////////////////////////////////
+/// \brief Long text whose geometry is built only for the visible lines
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VirtualText : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty text.
+    ///
+    ////////////////////////////////////////////////////////////
+    VirtualText();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the text from a string, font and size
+    ///
+    /// \param string         Text assigned to the string
+    /// \param font           Font used to draw the string
+    /// \param characterSize  Base size of characters, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    VirtualText(const String& string, const Font& font, unsigned int characterSize = 30);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's string
+    ///
+    /// The line index of the string is rebuilt, and all the
+    /// geometry built so far is discarded.
+    ///
+    /// \param string New string
+    ///
+    /// \see getString, append
+    ///
+    ////////////////////////////////////////////////////////////
+    void setString(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add characters at the end of the string
+    ///
+    /// Only the new characters are indexed, and the geometry
+    /// of the other lines is kept (except the last one, which
+    /// may continue in \a string). This is the function to use
+    /// to feed a log or a console.
+    ///
+    /// \param string Characters to append
+    ///
+    /// \see setString
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's font
+    ///
+    /// The \a font argument refers to a font that must
+    /// exist as long as the text uses it.
+    ///
+    /// \param font New font
+    ///
+    /// \see getFont
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the character size
+    ///
+    /// The default size is 30.
+    ///
+    /// \param size New character size, in pixels
+    ///
+    /// \see getCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCharacterSize(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's style
+    ///
+    /// You can pass a combination of one or more styles of
+    /// sf::Text::Style, for example sf::Text::Bold | sf::Text::Italic.
+    /// The default style is sf::Text::Regular.
+    ///
+    /// \param style New style
+    ///
+    /// \see getStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStyle(Uint32 style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the fill color of the text
+    ///
+    /// The colors of the lines already built are changed in
+    /// place, without rebuilding them. By default, the text's
+    /// fill color is opaque white.
+    ///
+    /// \param color New fill color of the text
+    ///
+    /// \see getFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFillColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the area of the text to display
+    ///
+    /// By default, the lines that intersect the view of the
+    /// render target are drawn. If a clip rectangle is set,
+    /// the lines that intersect it are drawn instead, which is
+    /// useful when the text is displayed in a part of the view
+    /// only (like a scrolling panel). Note that glyphs which
+    /// are partly outside the rectangle are not cut.
+    ///
+    /// An empty rectangle restores the default behavior.
+    ///
+    /// \param rect Area to display, in local coordinates
+    ///
+    /// \see getClipRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setClipRect(const FloatRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the text's string
+    ///
+    /// \return Text's string
+    ///
+    /// \see setString
+    ///
+    ////////////////////////////////////////////////////////////
+    const String& getString() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the text's font
+    ///
+    /// \return Pointer to the text's font, NULL if no font is set
+    ///
+    /// \see setFont
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font* getFont() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size
+    ///
+    /// \return Size of the characters, in pixels
+    ///
+    /// \see setCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharacterSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the text's style
+    ///
+    /// \return Text's style
+    ///
+    /// \see setStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getStyle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fill color of the text
+    ///
+    /// \return Fill color of the text
+    ///
+    /// \see setFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getFillColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of the text to display
+    ///
+    /// \return Area to display, in local coordinates (empty if the view is used)
+    ///
+    /// \see setClipRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect& getClipRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of lines of the text
+    ///
+    /// An empty string, or a string ending with a line break,
+    /// ends with an empty line.
+    ///
+    /// \return Number of lines
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLineCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the vertical distance between two lines
+    ///
+    /// The top of the line \a n is at n * getLineSpacing(),
+    /// in local coordinates.
+    ///
+    /// \return Line spacing, in pixels (0 if no font is set)
+    ///
+    ////////////////////////////////////////////////////////////
+    float getLineSpacing() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry of a block of consecutive lines
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Block
+    {
+        Block() : built(false) {}
+
+        std::vector<Vertex> vertices; ///< Two triangles per glyph, underline and strike through
+        bool                built;    ///< Are the vertices up-to-date?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible lines to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the vertices of a block of lines
+    ///
+    /// \param index Index of the block
+    ///
+    ////////////////////////////////////////////////////////////
+    void buildBlock(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the geometry of all the blocks
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseBlocks() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Index the lines starting from a given character
+    ///
+    /// \param begin Index of the first character to index
+    ///
+    ////////////////////////////////////////////////////////////
+    void indexLines(std::size_t begin);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    String                           m_string;                ///< String to display
+    const Font*                      m_font;                  ///< Font used to display the string
+    unsigned int                     m_characterSize;         ///< Base size of characters, in pixels
+    Uint32                           m_style;                 ///< Text style (see sf::Text::Style)
+    Color                            m_fillColor;             ///< Text fill color
+    FloatRect                        m_clipRect;              ///< Area to display (empty to use the view)
+    std::vector<std::size_t>         m_lineStarts;            ///< Index of the first character of each line
+    mutable std::vector<Block>       m_blocks;                ///< Geometry of the blocks of lines
+    mutable std::vector<std::size_t> m_builtBlocks;           ///< Indices of the blocks that hold vertices
+    mutable Uint64                   m_fontTextureGeneration; ///< Generation of the font texture when the blocks were built
+};
+
+} // namespace sf
+
+
+#endif // SFML_VIRTUALTEXT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VirtualText
+/// \ingroup graphics
+///
+/// sf::VirtualText displays long texts, such as logs or documents,
+/// that would be too expensive to display with sf::Text: a sf::Text
+/// holds two triangles for every glyph of its string, even if only
+/// a few lines are visible.
+///
+/// sf::VirtualText only keeps an index of the lines of its string.
+/// When it is drawn, it finds the lines that intersect the view of
+/// the render target (or the clip rectangle, if one is set), builds
+/// their geometry by blocks of lines, and draws them. Blocks stay
+/// built while they are close to the visible area, so scrolling
+/// only builds the lines that come into sight, and the geometry of
+/// blocks far from it is released, so memory usage depends on the
+/// visible area rather than on the length of the text.
+///
+/// Lines are laid out like in sf::Text: the top of the first line
+/// is at the origin, and lines are getLineSpacing() pixels apart.
+/// Unlike sf::Text, sf::VirtualText doesn't support outlines.
+///
+/// Usage example:
+/// \code
+/// sf::VirtualText log(sf::String(), font, 14);
+///
+/// // Feed it with new lines as they come
+/// log.append("Connected to server\n");
+///
+/// // Scroll with the view
+/// sf::View view = window.getDefaultView();
+/// view.setCenter(view.getCenter().x, log.getLineCount() * log.getLineSpacing() - view.getSize().y / 2);
+/// window.setView(view);
+/// window.draw(log);
+/// \endcode
+///
+/// \see sf::Text, sf::Font
+///
+////////////////////////////////////////////////////////////
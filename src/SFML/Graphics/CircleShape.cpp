@@ -26,7 +26,41 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <cmath>
+#include <map>
+
+
+namespace
+{
+    // Get the points of a circle of radius 1 centered on the origin, starting at the top.
+    // The points are computed once per point count and shared by all the circles; the
+    // returned reference stays valid until the end of the program
+    const std::vector<sf::Vector2f>& getUnitCircle(std::size_t pointCount)
+    {
+        static sf::Mutex mutex;
+        static std::map<std::size_t, std::vector<sf::Vector2f> > circles;
+
+        sf::Lock lock(mutex);
+
+        std::map<std::size_t, std::vector<sf::Vector2f> >::iterator it = circles.find(pointCount);
+        if (it != circles.end())
+            return it->second;
+
+        static const float pi = 3.141592654f;
+
+        std::vector<sf::Vector2f>& points = circles[pointCount];
+        points.resize(pointCount);
+        for (std::size_t i = 0; i < pointCount; ++i)
+        {
+            float angle = i * 2 * pi / pointCount - pi / 2;
+            points[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+
+        return points;
+    }
+}
 
 
 namespace sf
@@ -34,7 +68,8 @@ namespace sf
 ////////////////////////////////////////////////////////////
 CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
-m_pointCount(pointCount)
+m_pointCount(pointCount),
+m_unitPoints(&getUnitCircle(pointCount))
 {
     update();
 }
@@ -43,6 +78,9 @@ m_pointCount(pointCount)
 ////////////////////////////////////////////////////////////
 void CircleShape::setRadius(float radius)
 {
+    if (radius == m_radius)
+        return;
+
     m_radius = radius;
     update();
 }
@@ -58,7 +96,11 @@ float CircleShape::getRadius() const
 ////////////////////////////////////////////////////////////
 void CircleShape::setPointCount(std::size_t count)
 {
+    if (count == m_pointCount)
+        return;
+
     m_pointCount = count;
+    m_unitPoints = &getUnitCircle(count);
     update();
 }
 
@@ -72,13 +114,9 @@ std::size_t CircleShape::getPointCount() const
 ////////////////////////////////////////////////////////////
 Vector2f CircleShape::getPoint(std::size_t index) const
 {
-    static const float pi = 3.141592654f;
-
-    float angle = index * 2 * pi / m_pointCount - pi / 2;
-    float x = std::cos(angle) * m_radius;
-    float y = std::sin(angle) * m_radius;
+    const Vector2f& point = (*m_unitPoints)[index];
 
-    return Vector2f(m_radius + x, m_radius + y);
+    return Vector2f(m_radius + point.x * m_radius, m_radius + point.y * m_radius);
 }
 
 } // namespace sf
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/ParallelFor.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
@@ -38,6 +39,8 @@
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 
@@ -61,6 +64,445 @@ namespace
     void close(FT_Stream)
     {
     }
+
+    // Maximum number of (bold, outline thickness) combinations that get a dense Latin-1 table in each page
+    const std::size_t maxLatin1Tables = 8;
+
+    // Fill a buffer with the pixels of an empty glyph texture: transparent white,
+    // except a 2x2 opaque white square in the top-left corner used for underlines
+    void createTexturePixels(std::vector<sf::Uint8>& pixels, unsigned int size)
+    {
+        pixels.assign(size * size, 0);
+
+        for (unsigned int y = 0; y < 2; ++y)
+            for (unsigned int x = 0; x < 2; ++x)
+                pixels[y * size + x] = 255;
+    }
+
+    // Upload the whole glyph texture from its alpha channel (the color is always white)
+    void updateTexture(sf::Texture& texture, const std::vector<sf::Uint8>& alpha)
+    {
+        std::vector<sf::Uint8> pixels(alpha.size() * 4, 255);
+        for (std::size_t i = 0; i < alpha.size(); ++i)
+            pixels[i * 4 + 3] = alpha[i];
+
+        texture.update(&pixels[0]);
+    }
+
+    // Parameters of the distance field glyphs: reference size, distance range (in pixels at
+    // the reference size), and oversampling factor of the bitmap the distances are computed on
+    const unsigned int distanceFieldSize         = 48;
+    const unsigned int distanceFieldSpread       = 6;
+    const unsigned int distanceFieldOversampling = 4;
+
+    // Abscissa of the intersection of the parabolas rooted at q and r in the distance transform below
+    float intersection(const float* f, std::size_t stride, std::size_t q, std::size_t r)
+    {
+        float fq = f[q * stride] + static_cast<float>(q * q);
+        float fr = f[r * stride] + static_cast<float>(r * r);
+        return (fq - fr) / (2.f * static_cast<float>(q) - 2.f * static_cast<float>(r));
+    }
+
+    // Squared Euclidean distance transform of a 1D function (Felzenszwalb & Huttenlocher),
+    // computed in place with the help of the d (result), v (parabola roots) and z (boundaries) buffers
+    void distanceTransform(float* f, std::size_t n, std::size_t stride, std::vector<float>& d, std::vector<std::size_t>& v, std::vector<float>& z)
+    {
+        const float infinity = 1e20f;
+
+        std::size_t k = 0;
+        v[0] = 0;
+        z[0] = -infinity;
+        z[1] = infinity;
+        for (std::size_t q = 1; q < n; ++q)
+        {
+            float s = intersection(f, stride, q, v[k]);
+            while (s <= z[k])
+            {
+                --k;
+                s = intersection(f, stride, q, v[k]);
+            }
+
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = infinity;
+        }
+
+        k = 0;
+        for (std::size_t q = 0; q < n; ++q)
+        {
+            while (z[k + 1] < static_cast<float>(q))
+                ++k;
+
+            float delta = static_cast<float>(q) - static_cast<float>(v[k]);
+            d[q] = delta * delta + f[v[k] * stride];
+        }
+
+        for (std::size_t q = 0; q < n; ++q)
+            f[q * stride] = d[q];
+    }
+
+    // Squared Euclidean distance transform of a 2D grid: cells must be 0 on the
+    // features and "infinite" elsewhere, and receive the squared distance to the nearest feature
+    void distanceTransform(std::vector<float>& grid, std::size_t width, std::size_t height)
+    {
+        std::size_t size = std::max(width, height);
+        std::vector<float> d(size);
+        std::vector<std::size_t> v(size);
+        std::vector<float> z(size + 1);
+
+        for (std::size_t x = 0; x < width; ++x)
+            distanceTransform(&grid[x], height, width, d, v, z);
+
+        for (std::size_t y = 0; y < height; ++y)
+            distanceTransform(&grid[y * width], width, 1, d, v, z);
+    }
+
+    // Write the signed distance field of an oversampled glyph bitmap into the alpha channel of
+    // a pixel buffer (the distance field is written inside the padding of the buffer)
+    void writeDistanceField(const FT_Bitmap& bitmap, std::vector<sf::Uint8>& pixels, unsigned int width, unsigned int height, unsigned int padding)
+    {
+        const float infinity = 1e20f;
+        const unsigned int oversampling = distanceFieldOversampling;
+
+        // Oversampled grid covering the field, glyph margin included
+        std::size_t fieldWidth  = width - 2 * padding;
+        std::size_t fieldHeight = height - 2 * padding;
+        std::size_t gridWidth   = fieldWidth * oversampling;
+        std::size_t gridHeight  = fieldHeight * oversampling;
+        std::size_t offset      = distanceFieldSpread * oversampling;
+
+        // Classify the bitmap pixels: the "outside" grid gets the distances to the glyph,
+        // the "inside" grid the distances to the background
+        std::vector<float> outside(gridWidth * gridHeight, infinity);
+        std::vector<float> inside(gridWidth * gridHeight, 0.f);
+        const sf::Uint8* row = bitmap.buffer;
+        for (std::size_t y = 0; y < static_cast<std::size_t>(bitmap.rows); ++y)
+        {
+            for (std::size_t x = 0; x < static_cast<std::size_t>(bitmap.width); ++x)
+            {
+                bool covered;
+                if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+                    covered = (row[x / 8] & (1 << (7 - (x % 8)))) != 0;
+                else
+                    covered = row[x] >= 128;
+
+                if (covered)
+                {
+                    std::size_t index = (y + offset) * gridWidth + x + offset;
+                    outside[index] = 0.f;
+                    inside[index] = infinity;
+                }
+            }
+            row += bitmap.pitch;
+        }
+
+        distanceTransform(outside, gridWidth, gridHeight);
+        distanceTransform(inside, gridWidth, gridHeight);
+
+        // Average the signed distances of each block of oversampled pixels, and map them to [0, 255]
+        float scale = 1.f / static_cast<float>(oversampling * oversampling * oversampling);
+        for (std::size_t y = 0; y < fieldHeight; ++y)
+        {
+            for (std::size_t x = 0; x < fieldWidth; ++x)
+            {
+                float distance = 0.f;
+                for (std::size_t j = 0; j < oversampling; ++j)
+                {
+                    for (std::size_t i = 0; i < oversampling; ++i)
+                    {
+                        std::size_t index = (y * oversampling + j) * gridWidth + x * oversampling + i;
+
+                        // Edges lie halfway between pixel centers
+                        if (outside[index] > 0.f)
+                            distance += std::sqrt(outside[index]) - 0.5f;
+                        else
+                            distance -= std::sqrt(inside[index]) - 0.5f;
+                    }
+                }
+                distance *= scale;
+
+                float value = 0.5f - distance / (2.f * static_cast<float>(distanceFieldSpread));
+                value = std::max(0.f, std::min(value, 1.f));
+                pixels[((y + padding) * width + x + padding) * 4 + 3] = static_cast<sf::Uint8>(value * 255.f + 0.5f);
+            }
+        }
+    }
+
+    // Combine the code point, bold flag, and outline thickness of a glyph into its cache key
+    sf::Uint64 combine(float outlineThickness, bool bold, sf::Uint32 codePoint)
+    {
+        return (static_cast<sf::Uint64>(*reinterpret_cast<sf::Uint32*>(&outlineThickness)) << 32)
+             | (static_cast<sf::Uint64>(bold ? 1 : 0) << 31)
+             |  static_cast<sf::Uint64>(codePoint);
+    }
+
+    // Padding left around the glyphs in the texture, so that filtering
+    // doesn't pollute them with pixels from neighbors
+    const unsigned int glyphPadding = 1;
+
+    // Make sure that the given size is the current one of a face
+    bool setFaceSize(FT_Face face, unsigned int characterSize)
+    {
+        // FT_Set_Pixel_Sizes is an expensive function, so we must call it
+        // only when necessary to avoid killing performances
+
+        FT_UShort currentSize = face->size->metrics.x_ppem;
+
+        if (currentSize != characterSize)
+        {
+            FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+
+            if (result == FT_Err_Invalid_Pixel_Size)
+            {
+                // In the case of bitmap fonts, resizing can
+                // fail if the requested size is not available
+                if (!FT_IS_SCALABLE(face))
+                {
+                    sf::err() << "Failed to set bitmap font size to " << characterSize << std::endl;
+                    sf::err() << "Available sizes are: ";
+                    for (int i = 0; i < face->num_fixed_sizes; ++i)
+                        sf::err() << face->available_sizes[i].height << " ";
+                    sf::err() << std::endl;
+                }
+            }
+
+            return result == FT_Err_Ok;
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    // Render a glyph into a buffer of RGBA pixels, padding included, and compute its metrics;
+    // the texture rectangle is left empty, and the size of the pixels is 0x0 if the glyph has no pixels
+    void rasterizeGlyph(FT_Library library, FT_Face face, FT_Stroker stroker, sf::Uint32 codePoint, unsigned int characterSize, bool bold,
+                        float outlineThickness, bool distanceField, sf::Glyph& glyph, std::vector<sf::Uint8>& buffer, unsigned int& bufferWidth, unsigned int& bufferHeight)
+    {
+        bufferWidth  = 0;
+        bufferHeight = 0;
+
+        // Distance fields are computed on an oversampled bitmap, for accuracy
+        unsigned int oversampling = distanceField ? distanceFieldOversampling : 1;
+
+        // Set the character size
+        if (!setFaceSize(face, characterSize * oversampling))
+            return;
+
+        // Load the glyph corresponding to the code point
+        FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
+        if (outlineThickness != 0)
+            flags |= FT_LOAD_NO_BITMAP;
+        if (FT_Load_Char(face, codePoint, flags) != 0)
+            return;
+
+        // Retrieve the glyph
+        FT_Glyph glyphDesc;
+        if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+            return;
+
+        // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
+        FT_Pos weight = (1 << 6) * oversampling;
+        bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (outline)
+        {
+            if (bold)
+            {
+                FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+                FT_Outline_Embolden(&outlineGlyph->outline, weight);
+            }
+
+            if (outlineThickness != 0)
+            {
+                FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+                FT_Glyph_Stroke(&glyphDesc, stroker, false);
+            }
+        }
+
+        // Convert the glyph to a bitmap (i.e. rasterize it)
+        FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+        FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+        // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+        if (!outline)
+        {
+            if (bold)
+                FT_Bitmap_Embolden(library, &bitmap, weight, weight);
+
+            if (outlineThickness != 0)
+                sf::err() << "Failed to outline glyph (no fallback available)" << std::endl;
+        }
+
+        // Compute the glyph's advance offset
+        float unit = static_cast<float>((1 << 6) * oversampling);
+        glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / unit;
+        if (bold)
+            glyph.advance += static_cast<float>(weight) / unit;
+
+        int width  = bitmap.width;
+        int height = bitmap.rows;
+
+        if ((width > 0) && (height > 0))
+        {
+            const int padding = static_cast<int>(glyphPadding);
+
+            // Distance fields are stored at the reference size, with a margin where the field fades out
+            unsigned int margin = 0;
+            if (distanceField)
+            {
+                width  = (width + oversampling - 1) / oversampling;
+                height = (height + oversampling - 1) / oversampling;
+                margin = distanceFieldSpread;
+            }
+
+            width += 2 * (padding + margin);
+            height += 2 * (padding + margin);
+
+            // Compute the glyph's bounding box
+            if (distanceField)
+            {
+                // The bounds match the texture rectangle exactly, so that the field is displayed 1:1 at the reference size
+                glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / unit - static_cast<float>(margin);
+                glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / unit - static_cast<float>(margin);
+                glyph.bounds.width  =  static_cast<float>(width - 2 * padding);
+                glyph.bounds.height =  static_cast<float>(height - 2 * padding);
+            }
+            else
+            {
+                glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+                glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+                glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
+                glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+            }
+
+            // Resize the pixel buffer to the new size and fill it with transparent white pixels
+            buffer.resize(width * height * 4);
+
+            sf::Uint8* current = &buffer[0];
+            sf::Uint8* end = current + width * height * 4;
+
+            while (current != end)
+            {
+                (*current++) = 255;
+                (*current++) = 255;
+                (*current++) = 255;
+                (*current++) = 0;
+            }
+
+            // Extract the glyph's pixels from the bitmap
+            const sf::Uint8* pixels = bitmap.buffer;
+            if (distanceField)
+            {
+                // Compute the distance field of the glyph
+                writeDistanceField(bitmap, buffer, width, height, padding);
+            }
+            else if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+            {
+                // Pixels are 1 bit monochrome values
+                for (int y = padding; y < height - padding; ++y)
+                {
+                    for (int x = padding; x < width - padding; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = x + y * width;
+                        buffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+            else
+            {
+                // Pixels are 8 bits gray levels
+                for (int y = padding; y < height - padding; ++y)
+                {
+                    for (int x = padding; x < width - padding; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = x + y * width;
+                        buffer[index * 4 + 3] = pixels[x - padding];
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+
+            bufferWidth  = width;
+            bufferHeight = height;
+        }
+
+        // Delete the FT glyph
+        FT_Done_Glyph(glyphDesc);
+    }
+
+    // Glyph rendered by Font::preload
+    struct GlyphJob
+    {
+        sf::Uint32             codePoint;     // Unicode code point of the character
+        unsigned int           characterSize; // Reference character size
+        sf::Glyph              glyph;         // Metrics of the rendered glyph
+        std::vector<sf::Uint8> pixels;        // Pixels of the rendered glyph, padding included
+        unsigned int           width;         // Width of the pixels
+        unsigned int           height;        // Height of the pixels
+        bool                   done;          // Was the glyph rendered?
+    };
+
+    // Sort glyph jobs by decreasing height, which packs them more tightly on the skyline
+    struct TallerJob
+    {
+        TallerJob(const std::vector<GlyphJob>& jobs) : m_jobs(jobs) {}
+        bool operator ()(std::size_t left, std::size_t right) const {return m_jobs[left].height > m_jobs[right].height;}
+        const std::vector<GlyphJob>& m_jobs;
+    };
+
+    // Render a range of glyph jobs; FreeType objects can't be used by several threads
+    // at once, so each range opens its own copy of the font face
+    struct GlyphRasterizer
+    {
+        void operator ()(std::size_t begin, std::size_t end)
+        {
+            FT_Library library;
+            if (FT_Init_FreeType(&library) != 0)
+                return;
+
+            FT_Face face;
+            FT_Error error;
+            if (data)
+                error = FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(size), 0, &face);
+            else
+                error = FT_New_Face(library, filename->c_str(), 0, &face);
+
+            FT_Stroker stroker;
+            if ((error == 0) && (FT_Stroker_New(library, &stroker) == 0))
+            {
+                if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        GlyphJob& job = (*jobs)[i];
+                        rasterizeGlyph(library, face, stroker, job.codePoint, job.characterSize, bold, outlineThickness,
+                                       distanceField, job.glyph, job.pixels, job.width, job.height);
+                        job.done = true;
+                    }
+                }
+
+                FT_Stroker_Done(stroker);
+            }
+
+            // This also destroys the face
+            FT_Done_FreeType(library);
+        }
+
+        std::vector<GlyphJob>* jobs;             // Glyphs to render
+        const std::string*     filename;         // Path of the font file
+        const void*            data;             // Font file in memory (used instead of the path if not NULL)
+        std::size_t            size;             // Size of the font file in memory
+        bool                   bold;             // Render the bold version of the glyphs?
+        float                  outlineThickness; // Thickness of outline of the glyphs
+        bool                   distanceField;    // Render distance field glyphs?
+    };
+
+    // Multiplier used to hash the keys of the glyph and page tables (2^64 divided by the golden ratio)
+    const sf::Uint64 hashMultiplier = (static_cast<sf::Uint64>(0x9E3779B9) << 32) | 0x7F4A7C15;
 }
 
 
@@ -68,12 +510,18 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_stroker  (NULL),
-m_refCount (NULL),
-m_info     ()
+m_library          (NULL),
+m_face             (NULL),
+m_streamRec        (NULL),
+m_stroker          (NULL),
+m_sourceData       (NULL),
+m_sourceSize       (0),
+m_refCount         (NULL),
+m_info             (),
+m_textureGeneration(0),
+m_memoryLimit      (0),
+m_evictionDelay    (60),
+m_frame            (0)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -83,14 +531,26 @@ m_info     ()
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_stroker    (copy.m_stroker),
-m_refCount   (copy.m_refCount),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_library          (copy.m_library),
+m_face             (copy.m_face),
+m_streamRec        (copy.m_streamRec),
+m_stroker          (copy.m_stroker),
+m_sourceFile       (copy.m_sourceFile),
+m_sourceData       (copy.m_sourceData),
+m_sourceSize       (copy.m_sourceSize),
+m_refCount         (copy.m_refCount),
+m_info             (copy.m_info),
+m_pages            (copy.m_pages),
+m_distanceFieldPage(copy.m_distanceFieldPage),
+m_charIndices      (copy.m_charIndices),
+m_pixelBuffer      (copy.m_pixelBuffer),
+m_texture          (copy.m_texture),
+m_texturePixels    (copy.m_texturePixels),
+m_skyline          (copy.m_skyline),
+m_textureGeneration(copy.m_textureGeneration),
+m_memoryLimit      (copy.m_memoryLimit),
+m_evictionDelay    (copy.m_evictionDelay),
+m_frame            (copy.m_frame)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -168,6 +628,9 @@ bool Font::loadFromFile(const std::string& filename)
     m_stroker = stroker;
     m_face = face;
 
+    // Remember where the font comes from, so that it can be opened again by other threads
+    m_sourceFile = filename;
+
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
@@ -233,6 +696,10 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
     m_stroker = stroker;
     m_face = face;
 
+    // Remember where the font comes from, so that it can be opened again by other threads
+    m_sourceData = data;
+    m_sourceSize = sizeInBytes;
+
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
@@ -329,26 +796,87 @@ const Font::Info& Font::getInfo() const
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
-
-    // Build the key by combining the code point, bold flag, and outline thickness
-    Uint64 key = (static_cast<Uint64>(*reinterpret_cast<Uint32*>(&outlineThickness)) << 32)
-               | (static_cast<Uint64>(bold ? 1 : 0) << 31)
-               |  static_cast<Uint64>(codePoint);
+    Page& page = getPage(characterSize);
 
-    // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
-    {
-        // Found: just return it
-        return it->second;
-    }
-    else
+    // Latin-1 code points are looked up directly in a dense table of the requested style
+    Latin1Glyphs* latin1 = NULL;
+    if (codePoint < 256)
     {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        for (std::vector<Latin1Glyphs>::iterator it = page.latin1.begin(); it != page.latin1.end(); ++it)
+        {
+            if ((it->bold == bold) && (it->outlineThickness == outlineThickness))
+            {
+                latin1 = &*it;
+                break;
+            }
+        }
+
+        // Only a few styles get their own table, to bound memory when many outline thicknesses are used
+        if (!latin1 && (page.latin1.size() < maxLatin1Tables))
+        {
+            page.latin1.push_back(Latin1Glyphs(bold, outlineThickness));
+            latin1 = &page.latin1.back();
+        }
+
+        if (latin1 && latin1->indices[codePoint])
+            return useGlyph(page.glyphs[latin1->indices[codePoint] - 1], codePoint, characterSize, bold, outlineThickness);
     }
+
+    // Build the key by combining the code point, bold flag, and outline thickness
+    Uint64 key = combine(outlineThickness, bold, codePoint);
+
+    // Search the glyph into the cache, and add an entry for it if it's not there yet
+    std::size_t index = page.glyphs.find(key);
+    if (index == GlyphTable::NotFound)
+        index = page.glyphs.insert(key, CachedGlyph());
+
+    // Remember it in the Latin-1 table so that the next lookup doesn't have to hash
+    if (latin1)
+        latin1->indices[codePoint] = static_cast<Uint32>(index + 1);
+
+    return useGlyph(page.glyphs[index], codePoint, characterSize, bold, outlineThickness);
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::getDistanceFieldGlyph(Uint32 codePoint, bool bold) const
+{
+    Uint64 key = combine(0, bold, codePoint);
+
+    GlyphTable& glyphs = m_distanceFieldPage.glyphs;
+    std::size_t index = glyphs.find(key);
+    if (index == GlyphTable::NotFound)
+        index = glyphs.insert(key, CachedGlyph());
+
+    return useGlyph(glyphs[index], codePoint, distanceFieldSize, bold, 0, true);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getDistanceFieldSize() const
+{
+    return distanceFieldSize;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getDistanceFieldSpread() const
+{
+    return static_cast<float>(distanceFieldSpread);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preload(const String& characters, const unsigned int* sizes, std::size_t sizeCount, bool bold, float outlineThickness, unsigned int threadCount) const
+{
+    preloadGlyphs(characters, sizes, sizeCount, bold, outlineThickness, false, threadCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preloadDistanceField(const String& characters, bool bold, unsigned int threadCount) const
+{
+    preloadGlyphs(characters, &distanceFieldSize, 1, bold, 0, true, threadCount);
 }
 
 
@@ -361,22 +889,29 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    if (face && FT_HAS_KERNING(face))
     {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        // Search the pair into the cache of the character size
+        KerningTable& kernings = getPage(characterSize).kernings;
+        Uint64 key = (static_cast<Uint64>(first) << 32) | static_cast<Uint64>(second);
+
+        std::size_t index = kernings.find(key);
+        if (index != KerningTable::NotFound)
+            return kernings[index];
+
+        if (!setCurrentSize(characterSize))
+            return 0.f;
 
         // Get the kerning vector
         FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+        FT_Get_Kerning(face, getCharIndex(first), getCharIndex(second), FT_KERNING_DEFAULT, &kerning);
 
         // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+        float offset = static_cast<float>(kerning.x);
+        if (FT_IS_SCALABLE(face))
+            offset /= static_cast<float>(1 << 6);
 
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
+        return kernings[kernings.insert(key, offset)];
     }
     else
     {
@@ -386,6 +921,38 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 }
 
 
+////////////////////////////////////////////////////////////
+void Font::getKerningRun(const Uint32* codePoints, std::size_t count, float* kernings, unsigned int characterSize) const
+{
+    if (count == 0)
+        return;
+
+    kernings[0] = 0.f;
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face || !FT_HAS_KERNING(face))
+    {
+        // Invalid font, or no kerning
+        std::fill(kernings + 1, kernings + count, 0.f);
+        return;
+    }
+
+    // Look up the page only once; pairs missing from its cache go through getKerning
+    const KerningTable& table = getPage(characterSize).kernings;
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        Uint32 first  = codePoints[i - 1];
+        Uint32 second = codePoints[i];
+        std::size_t index = table.find((static_cast<Uint64>(first) << 32) | static_cast<Uint64>(second));
+
+        if (index != KerningTable::NotFound)
+            kernings[i] = table[index];
+        else
+            kernings[i] = getKerning(first, second, characterSize);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 float Font::getLineSpacing(unsigned int characterSize) const
 {
@@ -443,9 +1010,53 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 
 
 ////////////////////////////////////////////////////////////
-const Texture& Font::getTexture(unsigned int characterSize) const
+const Texture& Font::getTexture(unsigned int) const
+{
+    ensureTexture();
+
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setTextureMemoryLimit(std::size_t bytes)
+{
+    m_memoryLimit = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getTextureMemoryLimit() const
+{
+    return m_memoryLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setGlyphEvictionDelay(unsigned int frames)
 {
-    return m_pages[characterSize].texture;
+    m_evictionDelay = frames;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getGlyphEvictionDelay() const
+{
+    return m_evictionDelay;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::advanceFrame()
+{
+    m_frame++;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Font::getTextureGeneration() const
+{
+    return m_textureGeneration;
 }
 
 
@@ -458,10 +1069,24 @@ Font& Font::operator =(const Font& right)
     std::swap(m_face,        temp.m_face);
     std::swap(m_streamRec,   temp.m_streamRec);
     std::swap(m_stroker,     temp.m_stroker);
+    std::swap(m_sourceFile,  temp.m_sourceFile);
+    std::swap(m_sourceData,  temp.m_sourceData);
+    std::swap(m_sourceSize,  temp.m_sourceSize);
     std::swap(m_refCount,    temp.m_refCount);
     std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
+    m_pages.swap(temp.m_pages);
+    m_distanceFieldPage.glyphs.swap(temp.m_distanceFieldPage.glyphs);
+    m_distanceFieldPage.latin1.swap(temp.m_distanceFieldPage.latin1);
+    m_distanceFieldPage.kernings.swap(temp.m_distanceFieldPage.kernings);
+    m_charIndices.swap(temp.m_charIndices);
     std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    m_texture.swap(temp.m_texture);
+    std::swap(m_texturePixels,     temp.m_texturePixels);
+    std::swap(m_skyline,           temp.m_skyline);
+    std::swap(m_textureGeneration, temp.m_textureGeneration);
+    std::swap(m_memoryLimit,       temp.m_memoryLimit);
+    std::swap(m_evictionDelay,     temp.m_evictionDelay);
+    std::swap(m_frame,             temp.m_frame);
 
     #ifdef SFML_SYSTEM_ANDROID
         std::swap(m_stream, temp.m_stream);
@@ -510,13 +1135,62 @@ void Font::cleanup()
     m_stroker   = NULL;
     m_streamRec = NULL;
     m_refCount  = NULL;
+    m_sourceFile.clear();
+    m_sourceData = NULL;
+    m_sourceSize = 0;
     m_pages.clear();
+    m_distanceFieldPage = Page();
+    m_charIndices.clear();
     std::vector<Uint8>().swap(m_pixelBuffer);
+
+    // Release the glyph texture; texts using this font will rebuild their geometry
+    Texture().swap(m_texture);
+    std::vector<Uint8>().swap(m_texturePixels);
+    m_skyline.clear();
+    m_textureGeneration++;
 }
 
 
 ////////////////////////////////////////////////////////////
-Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+Font::Page& Font::getPage(unsigned int characterSize) const
+{
+    std::size_t index = m_pages.find(characterSize);
+    if (index == PageTable::NotFound)
+        index = m_pages.insert(characterSize, Page());
+
+    return m_pages[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::useGlyph(CachedGlyph& cached, Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness, bool distanceField) const
+{
+    // Load the glyph if it's not in the texture (first use, or evicted since its last use)
+    if (!cached.resident)
+    {
+        cached.glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness, distanceField);
+        cached.resident = true;
+    }
+
+    cached.lastUse = m_frame;
+
+    return cached.glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Font::getCharIndex(Uint32 codePoint) const
+{
+    std::size_t index = m_charIndices.find(codePoint);
+    if (index == IndexTable::NotFound)
+        index = m_charIndices.insert(codePoint, FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint));
+
+    return m_charIndices[index];
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness, bool distanceField) const
 {
     // The glyph to return
     Glyph glyph;
@@ -526,273 +1200,500 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
     if (!face)
         return glyph;
 
-    // Set the character size
-    if (!setCurrentSize(characterSize))
-        return glyph;
+    // Render the glyph, and write it to the texture if it has pixels
+    unsigned int width, height;
+    rasterizeGlyph(static_cast<FT_Library>(m_library), face, static_cast<FT_Stroker>(m_stroker), codePoint, characterSize, bold,
+                   outlineThickness, distanceField, glyph, m_pixelBuffer, width, height);
+    if ((width > 0) && (height > 0))
+        placeGlyph(glyph, &m_pixelBuffer[0], width, height, true);
 
-    // Load the glyph corresponding to the code point
-    FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
-    if (outlineThickness != 0)
-        flags |= FT_LOAD_NO_BITMAP;
-    if (FT_Load_Char(face, codePoint, flags) != 0)
-        return glyph;
+    // Done :)
+    return glyph;
+}
 
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
 
-    // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (outline)
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphs(const String& characters, const unsigned int* sizes, std::size_t sizeCount, bool bold, float outlineThickness, bool distanceField, unsigned int threadCount) const
+{
+    if (!m_face)
+        return;
+
+    // Collect the glyphs which are not in the texture yet
+    std::vector<GlyphJob> jobs;
+    std::vector<CachedGlyph*> entries;
+    for (std::size_t i = 0; i < sizeCount; ++i)
     {
-        if (bold)
-        {
-            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-            FT_Outline_Embolden(&outlineGlyph->outline, weight);
-        }
+        GlyphTable& glyphs = distanceField ? m_distanceFieldPage.glyphs : getPage(sizes[i]).glyphs;
 
-        if (outlineThickness != 0)
+        for (String::ConstIterator it = characters.begin(); it != characters.end(); ++it)
         {
-            FT_Stroker stroker = static_cast<FT_Stroker>(m_stroker);
+            Uint64 key = combine(outlineThickness, bold, *it);
+            std::size_t index = glyphs.find(key);
+            if (index == GlyphTable::NotFound)
+                index = glyphs.insert(key, CachedGlyph());
 
-            FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
-            FT_Glyph_Stroke(&glyphDesc, stroker, false);
+            CachedGlyph& cached = glyphs[index];
+            if (!cached.resident)
+            {
+                // Mark the entry as loaded right away, so that duplicate characters are rendered only once
+                cached.glyph = Glyph();
+                cached.resident = true;
+
+                GlyphJob job;
+                job.codePoint     = *it;
+                job.characterSize = sizes[i];
+                job.width         = 0;
+                job.height        = 0;
+                job.done          = false;
+                jobs.push_back(job);
+                entries.push_back(&cached);
+            }
+
+            cached.lastUse = m_frame;
         }
     }
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+    if (jobs.empty())
+        return;
 
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (!outline)
+    // Render the glyphs in parallel, if the workers can open the font file again
+    if (!m_sourceFile.empty() || m_sourceData)
     {
-        if (bold)
-            FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+        GlyphRasterizer rasterizer;
+        rasterizer.jobs             = &jobs;
+        rasterizer.filename         = &m_sourceFile;
+        rasterizer.data             = m_sourceData;
+        rasterizer.size             = m_sourceSize;
+        rasterizer.bold             = bold;
+        rasterizer.outlineThickness = outlineThickness;
+        rasterizer.distanceField    = distanceField;
+        priv::parallelFor(jobs.size(), 16, threadCount, rasterizer);
+    }
 
-        if (outlineThickness != 0)
-            err() << "Failed to outline glyph (no fallback available)" << std::endl;
+    // Render the remaining glyphs with our own face (fonts loaded from a stream, or failure to open the font again)
+    for (std::vector<GlyphJob>::iterator job = jobs.begin(); job != jobs.end(); ++job)
+    {
+        if (!job->done)
+            rasterizeGlyph(static_cast<FT_Library>(m_library), static_cast<FT_Face>(m_face), static_cast<FT_Stroker>(m_stroker), job->codePoint,
+                           job->characterSize, bold, outlineThickness, distanceField, job->glyph, job->pixels, job->width, job->height);
     }
 
-    // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
-    if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+    // Pack the glyphs, tallest first, and write them to the texture in a single update
+    std::vector<std::size_t> order(jobs.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), TallerJob(jobs));
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
+    for (std::vector<std::size_t>::const_iterator it = order.begin(); it != order.end(); ++it)
+    {
+        GlyphJob& job = jobs[*it];
+        if ((job.width > 0) && (job.height > 0))
+            placeGlyph(job.glyph, &job.pixels[0], job.width, job.height, false);
 
-    if ((width > 0) && (height > 0))
+        entries[*it]->glyph = job.glyph;
+        std::vector<Uint8>().swap(job.pixels);
+    }
+
+    ensureTexture();
+    updateTexture(m_texture, m_texturePixels);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::placeGlyph(Glyph& glyph, const Uint8* pixels, unsigned int width, unsigned int height, bool upload) const
+{
+    const unsigned int padding = glyphPadding;
+
+    // Find a good position for the new glyph into the texture
+    IntRect rect = findGlyphRect(width, height);
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    glyph.textureRect.left   = rect.left + padding;
+    glyph.textureRect.top    = rect.top + padding;
+    glyph.textureRect.width  = rect.width - 2 * padding;
+    glyph.textureRect.height = rect.height - 2 * padding;
+
+    // The texture couldn't hold the glyph (the error has already been reported)
+    if ((rect.width != static_cast<int>(width)) || (rect.height != static_cast<int>(height)))
+        return;
+
+    // Write the pixels to the texture
+    if (upload)
+        m_texture.update(pixels, width, height, rect.left, rect.top);
+
+    // Keep a copy of the alpha channel, to be able to move the glyph later
+    unsigned int textureWidth = m_texture.getSize().x;
+    for (unsigned int row = 0; row < height; ++row)
     {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 1;
+        Uint8* alpha = &m_texturePixels[(rect.top + row) * textureWidth + rect.left];
+        const Uint8* source = &pixels[row * width * 4 + 3];
+        for (unsigned int x = 0; x < width; ++x)
+            alpha[x] = source[x * 4];
+    }
+}
+
 
-        width += 2 * padding;
-        height += 2 * padding;
+////////////////////////////////////////////////////////////
+IntRect Font::findGlyphRect(unsigned int width, unsigned int height) const
+{
+    ensureTexture();
+
+    IntRect rect;
+    while (!packRect(width, height, rect))
+    {
+        // Not enough space: resize the texture if possible
+        unsigned int size = m_texture.getSize().x;
+        Uint64 newMemory = static_cast<Uint64>(size * 2) * (size * 2) * 4;
+        if ((size * 2 <= Texture::getMaximumSize()) && ((m_memoryLimit == 0) || (newMemory <= m_memoryLimit)))
+        {
+            resizeTexture(size * 2);
+            continue;
+        }
 
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+        // The texture can't grow anymore: evict the glyphs that have not been used for a while...
+        Uint64 delay = std::max(m_evictionDelay, 1u);
+        if ((m_frame >= delay) && evictGlyphs(m_frame - delay + 1))
+            continue;
 
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width, height);
+        // ... or, as a last resort, all the glyphs that are not used during the current frame
+        if (evictGlyphs(m_frame))
+            continue;
 
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
+        // Oops, we've reached the maximum texture size...
+        err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+        return IntRect(0, 0, 2, 2);
+    }
 
-        // Compute the glyph's bounding box
-        glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
-        glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+    return rect;
+}
 
-        // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(width * height * 4);
 
-        Uint8* current = &m_pixelBuffer[0];
-        Uint8* end = current + width * height * 4;
+////////////////////////////////////////////////////////////
+bool Font::packRect(unsigned int width, unsigned int height, IntRect& rect) const
+{
+    unsigned int textureWidth  = m_texture.getSize().x;
+    unsigned int textureHeight = m_texture.getSize().y;
+
+    // Find the position where the rectangle lies the lowest (bottom-left heuristic),
+    // preferring the narrowest segments to leave wide gaps for wide glyphs
+    std::size_t best = m_skyline.size();
+    unsigned int bestY = 0;
+    unsigned int bestWidth = 0;
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        if (m_skyline[i].x + width > textureWidth)
+            break;
 
-        while (current != end)
+        // The rectangle rests on the highest segment below it
+        unsigned int y = 0;
+        unsigned int covered = 0;
+        for (std::size_t j = i; covered < width; ++j)
         {
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 0;
+            y = std::max(y, m_skyline[j].y);
+            covered += m_skyline[j].width;
         }
 
-        // Extract the glyph's pixels from the bitmap
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        if (y + height > textureHeight)
+            continue;
+
+        if ((best == m_skyline.size()) || (y < bestY) || ((y == bestY) && (m_skyline[i].width < bestWidth)))
         {
-            // Pixels are 1 bit monochrome values
-            for (int y = padding; y < height - padding; ++y)
-            {
-                for (int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
-            }
+            best = i;
+            bestY = y;
+            bestWidth = m_skyline[i].width;
+        }
+    }
+
+    if (best == m_skyline.size())
+        return false;
+
+    rect = IntRect(m_skyline[best].x, bestY, width, height);
+
+    // Raise the skyline over the new rectangle
+    m_skyline.insert(m_skyline.begin() + best, SkylineNode(rect.left, bestY + height, width));
+
+    // Shrink or remove the segments that are now covered by the new one
+    for (std::size_t i = best + 1; i < m_skyline.size();)
+    {
+        unsigned int previousEnd = m_skyline[i - 1].x + m_skyline[i - 1].width;
+        if (m_skyline[i].x >= previousEnd)
+            break;
+
+        unsigned int overlap = previousEnd - m_skyline[i].x;
+        if (m_skyline[i].width <= overlap)
+        {
+            m_skyline.erase(m_skyline.begin() + i);
         }
         else
         {
-            // Pixels are 8 bits gray levels
-            for (int y = padding; y < height - padding; ++y)
-            {
-                for (int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
-                }
-                pixels += bitmap.pitch;
-            }
+            m_skyline[i].x += overlap;
+            m_skyline[i].width -= overlap;
+            break;
         }
+    }
 
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left - padding;
-        unsigned int y = glyph.textureRect.top - padding;
-        unsigned int w = glyph.textureRect.width + 2 * padding;
-        unsigned int h = glyph.textureRect.height + 2 * padding;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
+    // Merge the neighbour segments that have the same height
+    for (std::size_t i = 0; i + 1 < m_skyline.size();)
+    {
+        if (m_skyline[i].y == m_skyline[i + 1].y)
+        {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
     }
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
+    return true;
+}
+
 
-    // Done :)
-    return glyph;
+////////////////////////////////////////////////////////////
+void Font::ensureTexture() const
+{
+    if (!m_texturePixels.empty())
+        return;
+
+    const unsigned int size = 128;
+    createTexturePixels(m_texturePixels, size);
+
+    // The reserved white square (and its padding) sits in the top-left corner
+    m_skyline.clear();
+    m_skyline.push_back(SkylineNode(0, 3, 3));
+    m_skyline.push_back(SkylineNode(3, 0, size - 3));
+
+    // Create the texture
+    m_texture.create(size, size);
+    updateTexture(m_texture, m_texturePixels);
+    m_texture.setSmooth(true);
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+void Font::resizeTexture(unsigned int size) const
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
-    {
-        float ratio = static_cast<float>(height) / it->height;
+    unsigned int oldSize = m_texture.getSize().x;
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
+    // Copy the existing glyphs to the top-left part of the new pixels
+    std::vector<Uint8> pixels;
+    createTexturePixels(pixels, size);
+    for (unsigned int y = 0; y < oldSize; ++y)
+        std::memcpy(&pixels[y * size], &m_texturePixels[y * oldSize], oldSize);
+    m_texturePixels.swap(pixels);
 
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
+    // The new columns are free from top to bottom
+    m_skyline.push_back(SkylineNode(oldSize, 0, size - oldSize));
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
+    m_texture.create(size, size);
+    updateTexture(m_texture, m_texturePixels);
+}
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
-    }
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
+////////////////////////////////////////////////////////////
+bool Font::evictGlyphs(Uint64 frame) const
+{
+    // Evict the old glyphs and collect the others, along with their height
+    std::vector<std::pair<int, CachedGlyph*> > remaining;
+    bool evicted = false;
+    for (std::size_t i = 0; i <= m_pages.getSize(); ++i)
     {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
+        GlyphTable& glyphs = (i < m_pages.getSize()) ? m_pages[i].glyphs : m_distanceFieldPage.glyphs;
+        for (std::size_t j = 0; j < glyphs.getSize(); ++j)
         {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
+            CachedGlyph& cached = glyphs[j];
+
+            // Glyphs without pixels (like spaces) don't take room in the texture
+            if (!cached.resident || (cached.glyph.textureRect.width <= 0))
+                continue;
+
+            if (cached.lastUse < frame)
             {
-                // Make the texture 2 times bigger
-                Texture newTexture;
-                newTexture.create(textureWidth * 2, textureHeight * 2);
-                newTexture.update(page.texture);
-                page.texture.swap(newTexture);
+                cached.resident = false;
+                evicted = true;
             }
             else
             {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
-                return IntRect(0, 0, 2, 2);
+                remaining.push_back(std::make_pair(cached.glyph.textureRect.height, &cached));
             }
         }
+    }
+
+    if (!evicted)
+        return false;
+
+    // Repack the remaining glyphs from scratch, tallest first
+    std::sort(remaining.begin(), remaining.end());
 
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
+    unsigned int size = m_texture.getSize().x;
+    std::vector<Uint8> pixels;
+    createTexturePixels(pixels, size);
+
+    m_skyline.clear();
+    m_skyline.push_back(SkylineNode(0, 3, 3));
+    m_skyline.push_back(SkylineNode(3, 0, size - 3));
+
+    const unsigned int padding = glyphPadding;
+    for (std::vector<std::pair<int, CachedGlyph*> >::reverse_iterator it = remaining.rbegin(); it != remaining.rend(); ++it)
+    {
+        IntRect& textureRect = it->second->glyph.textureRect;
+        unsigned int width  = textureRect.width + 2 * padding;
+        unsigned int height = textureRect.height + 2 * padding;
+
+        IntRect rect;
+        if (!packRect(width, height, rect))
+        {
+            // Doesn't fit anymore: it will be loaded again when needed
+            it->second->resident = false;
+            continue;
+        }
+
+        unsigned int x = textureRect.left - padding;
+        unsigned int y = textureRect.top - padding;
+        for (unsigned int row = 0; row < height; ++row)
+            std::memcpy(&pixels[(rect.top + row) * size + rect.left], &m_texturePixels[(y + row) * size + x], width);
+
+        textureRect.left = rect.left + padding;
+        textureRect.top  = rect.top + padding;
     }
 
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
+    m_texturePixels.swap(pixels);
+    updateTexture(m_texture, m_texturePixels);
 
-    // Update the row informations
-    row->width += width;
+    // Glyphs have moved: let the texts know that they must rebuild their geometry
+    m_textureGeneration++;
 
-    return rect;
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Font::setCurrentSize(unsigned int characterSize) const
 {
-    // FT_Set_Pixel_Sizes is an expensive function, so we must call it
-    // only when necessary to avoid killing performances
+    return setFaceSize(static_cast<FT_Face>(m_face), characterSize);
+}
 
-    FT_Face face = static_cast<FT_Face>(m_face);
-    FT_UShort currentSize = face->size->metrics.x_ppem;
 
-    if (currentSize != characterSize)
-    {
-        FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+////////////////////////////////////////////////////////////
+Font::Latin1Glyphs::Latin1Glyphs(bool glyphsBold, float glyphsOutlineThickness) :
+bold            (glyphsBold),
+outlineThickness(glyphsOutlineThickness)
+{
+    std::memset(indices, 0, sizeof(indices));
+}
 
-        if (result == FT_Err_Invalid_Pixel_Size)
-        {
-            // In the case of bitmap fonts, resizing can
-            // fail if the requested size is not available
-            if (!FT_IS_SCALABLE(face))
-            {
-                err() << "Failed to set bitmap font size to " << characterSize << std::endl;
-                err() << "Available sizes are: ";
-                for (int i = 0; i < face->num_fixed_sizes; ++i)
-                    err() << face->available_sizes[i].height << " ";
-                err() << std::endl;
-            }
-        }
 
-        return result == FT_Err_Ok;
-    }
-    else
+////////////////////////////////////////////////////////////
+template <typename T>
+const std::size_t Font::HashTable<T>::NotFound;
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+Font::HashTable<T>::HashTable() :
+m_shift(64)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t Font::HashTable<T>::find(Uint64 key) const
+{
+    if (m_slots.empty())
+        return NotFound;
+
+    // Fibonacci hashing spreads the consecutive code points over the whole table,
+    // then linear probing walks the neighbouring slots until an empty one is met
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = static_cast<std::size_t>((key * hashMultiplier) >> m_shift);
+    while (m_slots[slot])
     {
-        return true;
+        if (m_keys[slot] == key)
+            return m_slots[slot] - 1;
+
+        slot = (slot + 1) & mask;
     }
+
+    return NotFound;
 }
 
 
 ////////////////////////////////////////////////////////////
-Font::Page::Page() :
-nextRow(3)
+template <typename T>
+std::size_t Font::HashTable<T>::insert(Uint64 key, const T& value)
 {
-    // Make sure that the texture is initialized by default
-    sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
+    // Keep the load factor under 1/2 so that probe sequences stay short
+    if ((m_values.size() + 1) * 2 > m_slots.size())
+        grow();
 
-    // Reserve a 2x2 white square for texturing underlines
-    for (int x = 0; x < 2; ++x)
-        for (int y = 0; y < 2; ++y)
-            image.setPixel(x, y, Color(255, 255, 255, 255));
+    m_values.push_back(value);
+    std::size_t index = m_values.size() - 1;
 
-    // Create the texture
-    texture.loadFromImage(image);
-    texture.setSmooth(true);
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = static_cast<std::size_t>((key * hashMultiplier) >> m_shift);
+    while (m_slots[slot])
+        slot = (slot + 1) & mask;
+
+    m_keys[slot] = key;
+    m_slots[slot] = static_cast<Uint32>(index + 1);
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void Font::HashTable<T>::clear()
+{
+    std::vector<Uint64>().swap(m_keys);
+    std::vector<Uint32>().swap(m_slots);
+    std::deque<T>().swap(m_values);
+    m_shift = 64;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void Font::HashTable<T>::swap(HashTable& other)
+{
+    m_keys.swap(other.m_keys);
+    m_slots.swap(other.m_slots);
+    m_values.swap(other.m_values);
+    std::swap(m_shift, other.m_shift);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void Font::HashTable<T>::grow()
+{
+    std::vector<Uint64> keys;
+    std::vector<Uint32> slots;
+    keys.swap(m_keys);
+    slots.swap(m_slots);
+
+    // Start with 16 slots, then double the size each time
+    m_shift = slots.empty() ? 60 : m_shift - 1;
+    std::size_t count = static_cast<std::size_t>(1) << (64 - m_shift);
+    m_keys.resize(count, 0);
+    m_slots.resize(count, 0);
+
+    const std::size_t mask = count - 1;
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        if (slots[i])
+        {
+            std::size_t slot = static_cast<std::size_t>((keys[i] * hashMultiplier) >> m_shift);
+            while (m_slots[slot])
+                slot = (slot + 1) & mask;
+
+            m_keys[slot] = keys[i];
+            m_slots[slot] = slots[i];
+        }
+    }
 }
 
 } // namespace sf
@@ -53,6 +53,13 @@
     #define GLEXT_GL_CLAMP                            GL_CLAMP_TO_EDGE
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE
 
+    // Core since 1.0 - unsized internal formats, which must match the pixel format
+    #define GLEXT_GL_RGB8                             GL_RGB
+    #define GLEXT_GL_RGB5                             GL_RGB
+    #define GLEXT_GL_RGBA4                            GL_RGBA
+    #define GLEXT_GL_UNSIGNED_SHORT_5_6_5             GL_UNSIGNED_SHORT_5_6_5
+    #define GLEXT_GL_UNSIGNED_SHORT_4_4_4_4           GL_UNSIGNED_SHORT_4_4_4_4
+
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
     // functions according to the corresponding specification
@@ -114,15 +121,40 @@
     // Core since 3.0
     #define GLEXT_framebuffer_blit                    false
 
+    // Core since 3.0
+    #define GLEXT_framebuffer_multisample             false
+
+    // Core since 3.0
+    #define GLEXT_draw_buffers                        false
+
     // Core since 3.0 - EXT_sRGB
     #ifdef GL_EXT_sRGB
         #define GLEXT_texture_sRGB                        GL_EXT_sRGB
         #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
+        #define GLEXT_GL_SRGB8                            GL_SRGB_EXT
     #else
         #define GLEXT_texture_sRGB                        false
         #define GLEXT_GL_SRGB8_ALPHA8                     0
+        #define GLEXT_GL_SRGB8                            0
     #endif
 
+    // Core since 3.0
+    #define GLEXT_texture_rg                          false
+    #define GLEXT_GL_R8                               0
+    #define GLEXT_GL_RG8                              0
+    #define GLEXT_GL_R16F                             0
+    #define GLEXT_GL_RED                              0
+    #define GLEXT_GL_RG                               0
+
+    // Core since 3.0
+    #define GLEXT_texture_float                       false
+    #define GLEXT_GL_RGBA16F                          0
+    #define GLEXT_GL_RGBA32F                          0
+
+    // Core since 3.0
+    #define GLEXT_half_float_pixel                    false
+    #define GLEXT_GL_HALF_FLOAT                       0
+
 #else
 
     #include <SFML/Graphics/GLLoader.hpp>
@@ -134,6 +166,13 @@
     // Core since 1.1
     #define GLEXT_GL_DEPTH_COMPONENT                  GL_DEPTH_COMPONENT
     #define GLEXT_GL_CLAMP                            GL_CLAMP
+    #define GLEXT_GL_RGB8                             GL_RGB8
+    #define GLEXT_GL_RGB5                             GL_RGB5
+    #define GLEXT_GL_RGBA4                            GL_RGBA4
+
+    // Core since 1.2 - the loader is generated for 1.1
+    #define GLEXT_GL_UNSIGNED_SHORT_5_6_5             0x8363
+    #define GLEXT_GL_UNSIGNED_SHORT_4_4_4_4           0x8033
 
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
@@ -221,9 +260,15 @@
     #define GLEXT_blend_equation_separate             sfogl_ext_EXT_blend_equation_separate
     #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparateEXT
 
+    // Core since 2.0 - ARB_draw_buffers
+    #define GLEXT_draw_buffers                        sfogl_ext_ARB_draw_buffers
+    #define GLEXT_glDrawBuffers                       glDrawBuffersARB
+    #define GLEXT_GL_MAX_DRAW_BUFFERS                 GL_MAX_DRAW_BUFFERS_ARB
+
     // Core since 2.1 - EXT_texture_sRGB
     #define GLEXT_texture_sRGB                        sfogl_ext_EXT_texture_sRGB
     #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
+    #define GLEXT_GL_SRGB8                            GL_SRGB8_EXT
 
     // Core since 3.0 - EXT_framebuffer_object
     #define GLEXT_framebuffer_object                  sfogl_ext_EXT_framebuffer_object
@@ -242,6 +287,7 @@
     #define GLEXT_GL_RENDERBUFFER                     GL_RENDERBUFFER_EXT
     #define GLEXT_GL_COLOR_ATTACHMENT0                GL_COLOR_ATTACHMENT0_EXT
     #define GLEXT_GL_DEPTH_ATTACHMENT                 GL_DEPTH_ATTACHMENT_EXT
+    #define GLEXT_GL_MAX_COLOR_ATTACHMENTS            GL_MAX_COLOR_ATTACHMENTS_EXT
     #define GLEXT_GL_FRAMEBUFFER_COMPLETE             GL_FRAMEBUFFER_COMPLETE_EXT
     #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING_EXT
     #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION_EXT
@@ -254,6 +300,28 @@
     #define GLEXT_GL_DRAW_FRAMEBUFFER_BINDING         GL_DRAW_FRAMEBUFFER_BINDING_EXT
     #define GLEXT_GL_READ_FRAMEBUFFER_BINDING         GL_READ_FRAMEBUFFER_BINDING_EXT
 
+    // Core since 3.0 - EXT_framebuffer_multisample
+    #define GLEXT_framebuffer_multisample             sfogl_ext_EXT_framebuffer_multisample
+    #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
+    #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
+
+    // Core since 3.0 - ARB_texture_rg
+    #define GLEXT_texture_rg                          sfogl_ext_ARB_texture_rg
+    #define GLEXT_GL_R8                               GL_R8
+    #define GLEXT_GL_RG8                              GL_RG8
+    #define GLEXT_GL_R16F                             GL_R16F
+    #define GLEXT_GL_RED                              GL_RED
+    #define GLEXT_GL_RG                               GL_RG
+
+    // Core since 3.0 - ARB_texture_float
+    #define GLEXT_texture_float                       sfogl_ext_ARB_texture_float
+    #define GLEXT_GL_RGBA16F                          GL_RGBA16F_ARB
+    #define GLEXT_GL_RGBA32F                          GL_RGBA32F_ARB
+
+    // Core since 3.0 - ARB_half_float_pixel
+    #define GLEXT_half_float_pixel                    sfogl_ext_ARB_half_float_pixel
+    #define GLEXT_GL_HALF_FLOAT                       GL_HALF_FLOAT_ARB
+
     // Core since 3.2 - ARB_geometry_shader4
     #define GLEXT_geometry_shader4                    sfogl_ext_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
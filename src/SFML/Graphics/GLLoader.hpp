@@ -182,10 +182,15 @@ extern int sfogl_ext_ARB_vertex_shader;
 extern int sfogl_ext_ARB_fragment_shader;
 extern int sfogl_ext_ARB_texture_non_power_of_two;
 extern int sfogl_ext_EXT_blend_equation_separate;
+extern int sfogl_ext_ARB_draw_buffers;
 extern int sfogl_ext_EXT_texture_sRGB;
 extern int sfogl_ext_EXT_framebuffer_object;
 extern int sfogl_ext_EXT_framebuffer_blit;
+extern int sfogl_ext_EXT_framebuffer_multisample;
 extern int sfogl_ext_ARB_geometry_shader4;
+extern int sfogl_ext_ARB_texture_rg;
+extern int sfogl_ext_ARB_texture_float;
+extern int sfogl_ext_ARB_half_float_pixel;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -311,6 +316,16 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_BLEND_EQUATION_ALPHA_EXT 0x883D
 #define GL_BLEND_EQUATION_RGB_EXT 0x8009
 
+#define GL_DRAW_BUFFER0_ARB 0x8825
+#define GL_DRAW_BUFFER1_ARB 0x8826
+#define GL_DRAW_BUFFER2_ARB 0x8827
+#define GL_DRAW_BUFFER3_ARB 0x8828
+#define GL_DRAW_BUFFER4_ARB 0x8829
+#define GL_DRAW_BUFFER5_ARB 0x882A
+#define GL_DRAW_BUFFER6_ARB 0x882B
+#define GL_DRAW_BUFFER7_ARB 0x882C
+#define GL_MAX_DRAW_BUFFERS_ARB 0x8824
+
 #define GL_COMPRESSED_SLUMINANCE_ALPHA_EXT 0x8C4B
 #define GL_COMPRESSED_SLUMINANCE_EXT 0x8C4A
 #define GL_COMPRESSED_SRGB_ALPHA_EXT 0x8C49
@@ -385,6 +400,10 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_READ_FRAMEBUFFER_BINDING_EXT 0x8CAA
 #define GL_READ_FRAMEBUFFER_EXT 0x8CA8
 
+#define GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE_EXT 0x8D56
+#define GL_MAX_SAMPLES_EXT 0x8D57
+#define GL_RENDERBUFFER_SAMPLES_EXT 0x8CAB
+
 #define GL_FRAMEBUFFER_ATTACHMENT_LAYERED_ARB 0x8DA7
 #define GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER 0x8CD4
 #define GL_FRAMEBUFFER_INCOMPLETE_LAYER_COUNT_ARB 0x8DA9
@@ -406,6 +425,52 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_TRIANGLES_ADJACENCY_ARB 0x000C
 #define GL_TRIANGLE_STRIP_ADJACENCY_ARB 0x000D
 
+#define GL_R16 0x822A
+#define GL_R16F 0x822D
+#define GL_R16I 0x8233
+#define GL_R16UI 0x8234
+#define GL_R32F 0x822E
+#define GL_R32I 0x8235
+#define GL_R32UI 0x8236
+#define GL_R8 0x8229
+#define GL_R8I 0x8231
+#define GL_R8UI 0x8232
+#define GL_RG 0x8227
+#define GL_RG16 0x822C
+#define GL_RG16F 0x822F
+#define GL_RG16I 0x8239
+#define GL_RG16UI 0x823A
+#define GL_RG32F 0x8230
+#define GL_RG32I 0x823B
+#define GL_RG32UI 0x823C
+#define GL_RG8 0x822B
+#define GL_RG8I 0x8237
+#define GL_RG8UI 0x8238
+#define GL_RG_INTEGER 0x8228
+
+#define GL_ALPHA16F_ARB 0x881C
+#define GL_ALPHA32F_ARB 0x8816
+#define GL_INTENSITY16F_ARB 0x881D
+#define GL_INTENSITY32F_ARB 0x8817
+#define GL_LUMINANCE16F_ARB 0x881E
+#define GL_LUMINANCE32F_ARB 0x8818
+#define GL_LUMINANCE_ALPHA16F_ARB 0x881F
+#define GL_LUMINANCE_ALPHA32F_ARB 0x8819
+#define GL_RGB16F_ARB 0x881B
+#define GL_RGB32F_ARB 0x8815
+#define GL_RGBA16F_ARB 0x881A
+#define GL_RGBA32F_ARB 0x8814
+#define GL_TEXTURE_ALPHA_TYPE_ARB 0x8C13
+#define GL_TEXTURE_BLUE_TYPE_ARB 0x8C12
+#define GL_TEXTURE_DEPTH_TYPE_ARB 0x8C16
+#define GL_TEXTURE_GREEN_TYPE_ARB 0x8C11
+#define GL_TEXTURE_INTENSITY_TYPE_ARB 0x8C15
+#define GL_TEXTURE_LUMINANCE_TYPE_ARB 0x8C14
+#define GL_TEXTURE_RED_TYPE_ARB 0x8C10
+#define GL_UNSIGNED_NORMALIZED_ARB 0x8C17
+
+#define GL_HALF_FLOAT_ARB 0x140B
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -1209,6 +1274,12 @@ extern void (GL_FUNCPTR *sf_ptrc_glBlendEquationSeparateEXT)(GLenum, GLenum);
 #define glBlendEquationSeparateEXT sf_ptrc_glBlendEquationSeparateEXT
 #endif // GL_EXT_blend_equation_separate
 
+#ifndef GL_ARB_draw_buffers
+#define GL_ARB_draw_buffers 1
+extern void (GL_FUNCPTR *sf_ptrc_glDrawBuffersARB)(GLsizei, const GLenum*);
+#define glDrawBuffersARB sf_ptrc_glDrawBuffersARB
+#endif // GL_ARB_draw_buffers
+
 
 #ifndef GL_EXT_framebuffer_object
 #define GL_EXT_framebuffer_object 1
@@ -1254,6 +1325,12 @@ extern void (GL_FUNCPTR *sf_ptrc_glBlitFramebufferEXT)(GLint, GLint, GLint, GLin
 #define glBlitFramebufferEXT sf_ptrc_glBlitFramebufferEXT
 #endif // GL_EXT_framebuffer_blit
 
+#ifndef GL_EXT_framebuffer_multisample
+#define GL_EXT_framebuffer_multisample 1
+extern void (GL_FUNCPTR *sf_ptrc_glRenderbufferStorageMultisampleEXT)(GLenum, GLsizei, GLenum, GLsizei, GLsizei);
+#define glRenderbufferStorageMultisampleEXT sf_ptrc_glRenderbufferStorageMultisampleEXT
+#endif // GL_EXT_framebuffer_multisample
+
 #ifndef GL_ARB_geometry_shader4
 #define GL_ARB_geometry_shader4 1
 extern void (GL_FUNCPTR *sf_ptrc_glFramebufferTextureARB)(GLenum, GLenum, GLuint, GLint);
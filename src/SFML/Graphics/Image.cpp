@@ -26,32 +26,222 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageResampler.hpp>
+#include <SFML/Graphics/ParallelFor.hpp>
+#include <SFML/Graphics/PixelConverter.hpp>
 #include <SFML/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <new>
+
+
+namespace
+{
+    // Allocate an uninitialized array of pixels, with the same
+    // allocator as the image decoders so that their output can be adopted
+    sf::Uint8* allocatePixels(unsigned int width, unsigned int height, sf::Image::PixelFormat format = sf::Image::RGBA8)
+    {
+        void* pixels = std::malloc(static_cast<std::size_t>(width) * height * sf::Image::getPixelSize(format));
+        if (!pixels)
+            throw std::bad_alloc();
+
+        return static_cast<sf::Uint8*>(pixels);
+    }
+
+    // Minimum number of pixels given to each thread by the pixel kernels;
+    // smaller images are processed by the calling thread alone
+    const std::size_t pixelsPerThread = 256 * 1024;
+
+    // Number of rows of the given width to give to each thread
+    std::size_t rowGrain(std::size_t width)
+    {
+        return std::max<std::size_t>(pixelsPerThread / std::max<std::size_t>(width, 1), 1);
+    }
+
+    // Alpha-blend a band of rows of a source image over a destination image
+    struct BlendRows
+    {
+        void operator()(std::size_t begin, std::size_t end)
+        {
+            if ((sourceFormat == sf::Image::RGBA8) && (destinationFormat == sf::Image::RGBA8))
+            {
+                for (std::size_t row = begin; row < end; ++row)
+                    sf::priv::blendPixels(source + row * sourceStride, destination + row * destinationStride, width);
+            }
+            else
+            {
+                // Other formats are blended through RGBA8 rows
+                std::vector<sf::Uint8> sourceRow(width * 4);
+                std::vector<sf::Uint8> destinationRow(width * 4);
+                for (std::size_t row = begin; row < end; ++row)
+                {
+                    sf::Uint8* pixels = destination + row * destinationStride;
+                    sf::priv::convertPixels(source + row * sourceStride, sourceFormat, &sourceRow[0], sf::Image::RGBA8, width);
+                    sf::priv::convertPixels(pixels, destinationFormat, &destinationRow[0], sf::Image::RGBA8, width);
+                    sf::priv::blendPixels(&sourceRow[0], &destinationRow[0], width);
+                    sf::priv::convertPixels(&destinationRow[0], sf::Image::RGBA8, pixels, destinationFormat, width);
+                }
+            }
+        }
+
+        const sf::Uint8*       source;
+        sf::Image::PixelFormat sourceFormat;
+        std::size_t            sourceStride;
+        sf::Uint8*             destination;
+        sf::Image::PixelFormat destinationFormat;
+        std::size_t            destinationStride;
+        std::size_t            width;
+    };
+
+    // Convert a range of pixels to another format
+    struct ConvertPixels
+    {
+        void operator()(std::size_t begin, std::size_t end)
+        {
+            sf::priv::convertPixels(source + begin * sourceSize, sourceFormat,
+                                    destination + begin * destinationSize, destinationFormat, end - begin);
+        }
+
+        const sf::Uint8*       source;
+        sf::Image::PixelFormat sourceFormat;
+        std::size_t            sourceSize;
+        sf::Uint8*             destination;
+        sf::Image::PixelFormat destinationFormat;
+        std::size_t            destinationSize;
+    };
+
+    // Replace the alpha of the pixels matching a color in a range of pixels
+    struct MaskPixels
+    {
+        void operator()(std::size_t begin, std::size_t end)
+        {
+            if (format == sf::Image::RGBA8)
+            {
+                sf::priv::maskPixels(pixels + begin * 4, end - begin, color, alpha);
+            }
+            else
+            {
+                // Other formats are compared pixel by pixel, and only
+                // the matching pixels are converted back
+                std::size_t size = sf::Image::getPixelSize(format);
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    sf::Uint8 rgba[4];
+                    sf::priv::convertPixels(pixels + i * size, format, rgba, sf::Image::RGBA8, 1);
+                    if (std::memcmp(rgba, color, 4) == 0)
+                    {
+                        rgba[3] = alpha;
+                        sf::priv::convertPixels(rgba, sf::Image::RGBA8, pixels + i * size, format, 1);
+                    }
+                }
+            }
+        }
+
+        sf::Uint8*             pixels;
+        sf::Image::PixelFormat format;
+        const sf::Uint8*       color;
+        sf::Uint8              alpha;
+    };
+
+    // Mirror a band of rows horizontally
+    struct ReverseRows
+    {
+        void operator()(std::size_t begin, std::size_t end)
+        {
+            for (std::size_t row = begin; row < end; ++row)
+            {
+                sf::Uint8* first = pixels + row * width * pixelSize;
+                if (pixelSize == 4)
+                {
+                    sf::priv::reversePixels(first, width);
+                }
+                else
+                {
+                    sf::Uint8* last = first + (width - 1) * pixelSize;
+                    for (; first < last; first += pixelSize, last -= pixelSize)
+                        std::swap_ranges(first, first + pixelSize, last);
+                }
+            }
+        }
+
+        sf::Uint8*  pixels;
+        std::size_t width;
+        std::size_t pixelSize;
+    };
+
+    // Exchange a band of rows of the top half with their mirror in the bottom half
+    struct SwapRows
+    {
+        void operator()(std::size_t begin, std::size_t end)
+        {
+            std::size_t pitch = width * pixelSize;
+            for (std::size_t row = begin; row < end; ++row)
+            {
+                sf::Uint8* top    = pixels + row * pitch;
+                sf::Uint8* bottom = pixels + (height - 1 - row) * pitch;
+                if (pixelSize == 4)
+                    sf::priv::swapPixels(top, bottom, width);
+                else
+                    std::swap_ranges(top, top + pitch, bottom);
+            }
+        }
+
+        sf::Uint8*  pixels;
+        std::size_t width;
+        std::size_t height;
+        std::size_t pixelSize;
+    };
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Image::Image() :
-m_size(0, 0)
+m_size  (0, 0),
+m_format(RGBA8),
+m_pixels(NULL)
+{
+    #ifdef SFML_SYSTEM_ANDROID
+
+    m_stream = NULL;
+
+    #endif
+}
+
+
+////////////////////////////////////////////////////////////
+Image::Image(const Image& copy) :
+m_size  (0, 0),
+m_format(copy.m_format),
+m_pixels(NULL)
 {
     #ifdef SFML_SYSTEM_ANDROID
 
     m_stream = NULL;
 
     #endif
+
+    if (copy.m_pixels)
+    {
+        m_pixels = allocatePixels(copy.m_size.x, copy.m_size.y, copy.m_format);
+        std::memcpy(m_pixels, copy.m_pixels, static_cast<std::size_t>(copy.m_size.x) * copy.m_size.y * getPixelSize(copy.m_format));
+        m_size = copy.m_size;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 Image::~Image()
 {
+    std::free(m_pixels);
+
     #ifdef SFML_SYSTEM_ANDROID
 
         if (m_stream)
@@ -61,17 +251,30 @@ Image::~Image()
 }
 
 
+////////////////////////////////////////////////////////////
+Image& Image::operator =(const Image& right)
+{
+    Image temp(right);
+
+    std::swap(m_size,   temp.m_size);
+    std::swap(m_format, temp.m_format);
+    std::swap(m_pixels, temp.m_pixels);
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::create(unsigned int width, unsigned int height, const Color& color)
 {
     if (width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(width * height * 4);
-    
+        Uint8* newPixels = allocatePixels(width, height);
+
         // Fill it with the specified color
-        Uint8* ptr = &newPixels[0];
-        Uint8* end = ptr + newPixels.size();
+        Uint8* ptr = newPixels;
+        Uint8* end = ptr + static_cast<std::size_t>(width) * height * 4;
         while (ptr < end)
         {
             *ptr++ = color.r;
@@ -79,22 +282,14 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
             *ptr++ = color.b;
             *ptr++ = color.a;
         }
-    
+
         // Commit the new pixel buffer
-        m_pixels.swap(newPixels);
-        
-        // Assign the new size
-        m_size.x = width;
-        m_size.y = height;
+        setPixels(newPixels, Vector2u(width, height), RGBA8);
     }
     else
     {
         // Dump the pixel buffer
-        std::vector<Uint8>().swap(m_pixels);
-        
-        // Assign the new size
-        m_size.x = 0;
-        m_size.y = 0;
+        setPixels(NULL, Vector2u(0, 0), RGBA8);
     }
 }
 
@@ -105,23 +300,65 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
     if (pixels && width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(pixels, pixels + width * height * 4);
-        
+        Uint8* newPixels = allocatePixels(width, height);
+        std::memcpy(newPixels, pixels, static_cast<std::size_t>(width) * height * 4);
+
+        // Commit the new pixel buffer
+        setPixels(newPixels, Vector2u(width, height), RGBA8);
+    }
+    else
+    {
+        // Dump the pixel buffer
+        setPixels(NULL, Vector2u(0, 0), RGBA8);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::create(unsigned int width, unsigned int height, PixelFormat format, const Color& color)
+{
+    if (width && height)
+    {
+        // Convert the color to the format once, then repeat it
+        const Uint8 components[4] = {color.r, color.g, color.b, color.a};
+        Uint8 pixel[16];
+        priv::convertPixels(components, RGBA8, pixel, format, 1);
+
+        // Create a new pixel buffer first for exception safety's sake
+        std::size_t size = getPixelSize(format);
+        Uint8* newPixels = allocatePixels(width, height, format);
+        Uint8* ptr = newPixels;
+        Uint8* end = ptr + static_cast<std::size_t>(width) * height * size;
+        for (; ptr < end; ptr += size)
+            std::memcpy(ptr, pixel, size);
+
+        // Commit the new pixel buffer
+        setPixels(newPixels, Vector2u(width, height), format);
+    }
+    else
+    {
+        // Dump the pixel buffer
+        setPixels(NULL, Vector2u(0, 0), format);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::create(unsigned int width, unsigned int height, const void* pixels, PixelFormat format)
+{
+    if (pixels && width && height)
+    {
+        // Create a new pixel buffer first for exception safety's sake
+        Uint8* newPixels = allocatePixels(width, height, format);
+        std::memcpy(newPixels, pixels, static_cast<std::size_t>(width) * height * getPixelSize(format));
+
         // Commit the new pixel buffer
-        m_pixels.swap(newPixels);
-        
-        // Assign the new size
-        m_size.x = width;
-        m_size.y = height;
+        setPixels(newPixels, Vector2u(width, height), format);
     }
     else
     {
         // Dump the pixel buffer
-        std::vector<Uint8>().swap(m_pixels);
-        
-        // Assign the new size
-        m_size.x = 0;
-        m_size.y = 0;
+        setPixels(NULL, Vector2u(0, 0), format);
     }
 }
 
@@ -131,7 +368,14 @@ bool Image::loadFromFile(const std::string& filename)
 {
     #ifndef SFML_SYSTEM_ANDROID
 
-        return priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size);
+        // The decoded pixels are adopted as they are
+        Uint8* pixels = NULL;
+        Vector2u size;
+        if (!priv::ImageLoader::getInstance().loadImageFromFile(filename, pixels, size))
+            return false;
+
+        setPixels(pixels, size, RGBA8);
+        return true;
 
     #else
 
@@ -148,21 +392,41 @@ bool Image::loadFromFile(const std::string& filename)
 ////////////////////////////////////////////////////////////
 bool Image::loadFromMemory(const void* data, std::size_t size)
 {
-    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    Uint8* pixels = NULL;
+    Vector2u imageSize;
+    if (!priv::ImageLoader::getInstance().loadImageFromMemory(data, size, pixels, imageSize))
+        return false;
+
+    setPixels(pixels, imageSize, RGBA8);
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::loadFromStream(InputStream& stream)
 {
-    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    Uint8* pixels = NULL;
+    Vector2u size;
+    if (!priv::ImageLoader::getInstance().loadImageFromStream(stream, pixels, size))
+        return false;
+
+    setPixels(pixels, size, RGBA8);
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::saveToFile(const std::string& filename) const
+bool Image::saveToFile(const std::string& filename, const SaveSettings& settings) const
 {
-    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
+    // The encoders only know RGBA8
+    if (m_format != RGBA8)
+    {
+        Image converted(*this);
+        converted.convert(RGBA8);
+        return converted.saveToFile(filename, settings);
+    }
+
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size, settings);
 }
 
 
@@ -173,21 +437,75 @@ Vector2u Image::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+Image::PixelFormat Image::getPixelFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::convert(PixelFormat format)
+{
+    if (format == m_format)
+        return;
+
+    if (m_pixels)
+    {
+        // Convert into a new pixel buffer first for exception safety's sake
+        Uint8* newPixels = allocatePixels(m_size.x, m_size.y, format);
+
+        ConvertPixels conversion;
+        conversion.source            = m_pixels;
+        conversion.sourceFormat      = m_format;
+        conversion.sourceSize        = getPixelSize(m_format);
+        conversion.destination       = newPixels;
+        conversion.destinationFormat = format;
+        conversion.destinationSize   = getPixelSize(format);
+        priv::parallelFor(static_cast<std::size_t>(m_size.x) * m_size.y, pixelsPerThread, 0, conversion);
+
+        setPixels(newPixels, m_size, format);
+    }
+    else
+    {
+        m_format = format;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Image::getPixelSize(PixelFormat format)
+{
+    switch (format)
+    {
+        case R8:       return 1;
+        case RG8:      return 2;
+        case RGB8:     return 3;
+        case RGB565:   return 2;
+        case RGBA4444: return 2;
+        case R16F:     return 2;
+        case RGBA16F:  return 8;
+        case RGBA32F:  return 16;
+        default:       return 4;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 {
-    // Make sure that the image is not empty
-    if (!m_pixels.empty())
+    // Make sure that the image is not empty, and that its pixels have an alpha
+    if (m_pixels && ((m_format == RGBA8) || (m_format == RGBA4444) || (m_format == RGBA16F) || (m_format == RGBA32F)))
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        const Uint8 components[4] = {color.r, color.g, color.b, color.a};
+
+        MaskPixels mask;
+        mask.pixels = m_pixels;
+        mask.format = m_format;
+        mask.color  = components;
+        mask.alpha  = alpha;
+        priv::parallelFor(static_cast<std::size_t>(m_size.x) * m_size.y, pixelsPerThread, 0, mask);
     }
 }
 
@@ -227,43 +545,47 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
         return;
 
     // Precompute as much as possible
-    int          pitch     = width * 4;
+    std::size_t  srcSize   = getPixelSize(source.m_format);
+    std::size_t  dstSize   = getPixelSize(m_format);
+    int          pitch     = width * static_cast<int>(dstSize);
     int          rows      = height;
-    int          srcStride = source.m_size.x * 4;
-    int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
-    Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
+    int          srcStride = source.m_size.x * static_cast<int>(srcSize);
+    int          dstStride = m_size.x * static_cast<int>(dstSize);
+    const Uint8* srcPixels = source.m_pixels + (srcRect.left + srcRect.top * source.m_size.x) * srcSize;
+    Uint8*       dstPixels = m_pixels + (destX + destY * m_size.x) * dstSize;
 
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, split in bands of rows for large areas (slower)
+        BlendRows blend;
+        blend.source            = srcPixels;
+        blend.sourceFormat      = source.m_format;
+        blend.sourceStride      = srcStride;
+        blend.destination       = dstPixels;
+        blend.destinationFormat = m_format;
+        blend.destinationStride = dstStride;
+        blend.width             = width;
+
+        // Copying an image onto itself may read rows that another thread writes
+        priv::parallelFor(rows, rowGrain(width), (&source == this) ? 1 : 0, blend);
+    }
+    else if (source.m_format == m_format)
+    {
+        // Optimized copy ignoring alpha values, row by row (faster)
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
+            std::memcpy(dstPixels, srcPixels, pitch);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
     }
     else
     {
-        // Optimized copy ignoring alpha values, row by row (faster)
+        // Copy ignoring alpha values, converting each row to the format of this image
         for (int i = 0; i < rows; ++i)
         {
-            std::memcpy(dstPixels, srcPixels, pitch);
+            priv::convertPixels(srcPixels, source.m_format, dstPixels, m_format, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
@@ -274,28 +596,45 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
 ////////////////////////////////////////////////////////////
 void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 {
-    Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
-    *pixel++ = color.r;
-    *pixel++ = color.g;
-    *pixel++ = color.b;
-    *pixel++ = color.a;
+    if (m_format == RGBA8)
+    {
+        Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
+        *pixel++ = color.r;
+        *pixel++ = color.g;
+        *pixel++ = color.b;
+        *pixel++ = color.a;
+    }
+    else
+    {
+        const Uint8 components[4] = {color.r, color.g, color.b, color.a};
+        priv::convertPixels(components, RGBA8, &m_pixels[(x + y * m_size.x) * getPixelSize(m_format)], m_format, 1);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 Color Image::getPixel(unsigned int x, unsigned int y) const
 {
-    const Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
-    return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+    if (m_format == RGBA8)
+    {
+        const Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
+        return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+    }
+    else
+    {
+        Uint8 pixel[4];
+        priv::convertPixels(&m_pixels[(x + y * m_size.x) * getPixelSize(m_format)], m_format, pixel, RGBA8, 1);
+        return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 const Uint8* Image::getPixelsPtr() const
 {
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
-        return &m_pixels[0];
+        return m_pixels;
     }
     else
     {
@@ -308,45 +647,109 @@ const Uint8* Image::getPixelsPtr() const
 ////////////////////////////////////////////////////////////
 void Image::flipHorizontally()
 {
-    if (!m_pixels.empty())
+    if (m_pixels)
     {
-        std::size_t rowSize = m_size.x * 4;
+        ReverseRows reverse;
+        reverse.pixels    = m_pixels;
+        reverse.width     = m_size.x;
+        reverse.pixelSize = getPixelSize(m_format);
+        priv::parallelFor(m_size.y, rowGrain(m_size.x), 0, reverse);
+    }
+}
 
-        for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
 
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
+////////////////////////////////////////////////////////////
+void Image::flipVertically()
+{
+    if (m_pixels)
+    {
+        SwapRows swap;
+        swap.pixels    = m_pixels;
+        swap.width     = m_size.x;
+        swap.height    = m_size.y;
+        swap.pixelSize = getPixelSize(m_format);
+        priv::parallelFor(m_size.y / 2, rowGrain(m_size.x), 0, swap);
+    }
+}
 
-                left += 4;
-                right -= 4;
-            }
-        }
+
+////////////////////////////////////////////////////////////
+void Image::resize(unsigned int width, unsigned int height, ResizeFilter filter, bool sRgb)
+{
+    if (!width || !height)
+    {
+        create(0, 0, m_format);
+        return;
+    }
+
+    if (!m_pixels || ((width == m_size.x) && (height == m_size.y)))
+        return;
+
+    // The resampler only knows RGBA8
+    if (m_format != RGBA8)
+    {
+        PixelFormat format = m_format;
+        convert(RGBA8);
+        resize(width, height, filter, sRgb);
+        convert(format);
+        return;
     }
+
+    // Resample into a new pixel buffer first for exception safety's sake
+    Uint8* newPixels = allocatePixels(width, height);
+    priv::resamplePixels(m_pixels, m_size, newPixels, Vector2u(width, height), filter, sRgb);
+
+    setPixels(newPixels, Vector2u(width, height), RGBA8);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Image::flipVertically()
+std::vector<Image> Image::generateMipChain(ResizeFilter filter, bool sRgb) const
 {
-    if (!m_pixels.empty())
+    std::vector<Image> levels;
+    if (!m_pixels)
+        return levels;
+
+    // The resampler only knows RGBA8
+    if (m_format != RGBA8)
     {
-        std::size_t rowSize = m_size.x * 4;
+        Image converted(*this);
+        converted.convert(RGBA8);
+        levels = converted.generateMipChain(filter, sRgb);
+        for (std::size_t i = 0; i < levels.size(); ++i)
+            levels[i].convert(m_format);
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        return levels;
+    }
 
-        for (std::size_t y = 0; y < m_size.y / 2; ++y)
-        {
-            std::swap_ranges(top, top + rowSize, bottom);
+    // Count the levels first, so that they are never copied
+    std::size_t count = 0;
+    for (Vector2u size = m_size; (size.x > 1) || (size.y > 1); ++count)
+        size = Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+    levels.resize(count);
 
-            top += rowSize;
-            bottom -= rowSize;
-        }
+    // Compute each level from the previous one
+    const Image* previous = this;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Vector2u size(std::max(previous->m_size.x / 2, 1u), std::max(previous->m_size.y / 2, 1u));
+        levels[i].setPixels(allocatePixels(size.x, size.y), size, RGBA8);
+        priv::resamplePixels(previous->m_pixels, previous->m_size, levels[i].m_pixels, size, filter, sRgb);
+        previous = &levels[i];
     }
+
+    return levels;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::setPixels(Uint8* pixels, const Vector2u& size, PixelFormat format)
+{
+    std::free(m_pixels);
+
+    m_pixels = pixels;
+    m_size   = size;
+    m_format = format;
 }
 
 } // namespace sf
@@ -0,0 +1,339 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <algorithm>
+#include <cstring>
+
+// SSE2 is part of every x86-64 CPU, NEON of every ARMv8 one; other
+// targets (or 32-bit builds without these extensions) use the scalar
+// version of the kernels
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define SFML_IMAGEKERNELS_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define SFML_IMAGEKERNELS_NEON
+    #include <arm_neon.h>
+#endif
+
+
+namespace
+{
+    // Pack 4 bytes into a 32-bit value with the same memory layout
+    sf::Uint32 packBytes(sf::Uint8 b0, sf::Uint8 b1, sf::Uint8 b2, sf::Uint8 b3)
+    {
+        const sf::Uint8 bytes[4] = {b0, b1, b2, b3};
+        sf::Uint32 value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+
+    // Blend two pixels whose components are unpacked to 16 bits.
+    // Rather than dividing by 255, the sums (at most 255 * 255) are
+    // divided with (x + 1 + (x >> 8)) >> 8, which gives the same
+    // result over that range. The alpha is computed as
+    // (255 * a + d * (255 - a)) / 255, equal to a + d * (255 - a) / 255.
+    __m128i blendUnpacked(__m128i source, __m128i destination)
+    {
+        const __m128i one        = _mm_set1_epi16(1);
+        const __m128i full       = _mm_set1_epi16(255);
+        const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+        __m128i alpha = _mm_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3));
+        alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+        source = _mm_or_si128(source, alphaLanes);
+
+        __m128i sum = _mm_add_epi16(_mm_mullo_epi16(source, alpha), _mm_mullo_epi16(destination, _mm_sub_epi16(full, alpha)));
+        return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(sum, one), _mm_srli_epi16(sum, 8)), 8);
+    }
+
+#elif defined(SFML_IMAGEKERNELS_NEON)
+
+    // Same division as the SSE2 version, on 8 components
+    uint8x8_t divideBy255(uint16x8_t sum)
+    {
+        return vshrn_n_u16(vaddq_u16(vaddq_u16(sum, vdupq_n_u16(1)), vshrq_n_u16(sum, 8)), 8);
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void blendPixels(const Uint8* source, Uint8* destination, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+
+    // 4 pixels per iteration
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+
+        __m128i low  = blendUnpacked(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+        __m128i high = blendUnpacked(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_IMAGEKERNELS_NEON)
+
+    // 8 pixels per iteration, deinterleaved into component planes
+    const uint8x8_t full = vdup_n_u8(255);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8x4_t src = vld4_u8(source + i * 4);
+        uint8x8x4_t dst = vld4_u8(destination + i * 4);
+
+        uint8x8_t alpha   = src.val[3];
+        uint8x8_t inverse = vsub_u8(full, alpha);
+
+        for (int c = 0; c < 3; ++c)
+            dst.val[c] = divideBy255(vmlal_u8(vmull_u8(src.val[c], alpha), dst.val[c], inverse));
+        dst.val[3] = divideBy255(vmlal_u8(vmull_u8(full, alpha), dst.val[3], inverse));
+
+        vst4_u8(destination + i * 4, dst);
+    }
+
+#endif
+
+    // Remaining pixels
+    for (; i < count; ++i)
+    {
+        const Uint8* src = source + i * 4;
+        Uint8*       dst = destination + i * 4;
+
+        Uint8 alpha = src[3];
+        dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
+        dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
+        dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
+        dst[3] = alpha + dst[3] * (255 - alpha) / 255;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha)
+{
+    const Uint32 key = packBytes(color[0], color[1], color[2], color[3]);
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+
+    // Compare whole pixels, then replace the alpha byte of the matching ones
+    const __m128i keys      = _mm_set1_epi32(static_cast<int>(key));
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(packBytes(0, 0, 0, 255)));
+    const __m128i newAlpha  = _mm_set1_epi32(static_cast<int>(packBytes(0, 0, 0, alpha)));
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* ptr      = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  pixel    = _mm_loadu_si128(ptr);
+        __m128i  selected = _mm_and_si128(_mm_cmpeq_epi32(pixel, keys), alphaMask);
+
+        _mm_storeu_si128(ptr, _mm_or_si128(_mm_andnot_si128(selected, pixel), _mm_and_si128(selected, newAlpha)));
+    }
+
+#elif defined(SFML_IMAGEKERNELS_NEON)
+
+    const uint32x4_t keys      = vdupq_n_u32(key);
+    const uint32x4_t alphaMask = vdupq_n_u32(packBytes(0, 0, 0, 255));
+    const uint32x4_t newAlpha  = vdupq_n_u32(packBytes(0, 0, 0, alpha));
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t pixel    = vreinterpretq_u32_u8(vld1q_u8(pixels + i * 4));
+        uint32x4_t selected = vandq_u32(vceqq_u32(pixel, keys), alphaMask);
+
+        vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(vbslq_u32(selected, newAlpha, pixel)));
+    }
+
+#endif
+
+    // Remaining pixels
+    for (; i < count; ++i)
+    {
+        Uint32 pixel;
+        std::memcpy(&pixel, pixels + i * 4, sizeof(pixel));
+        if (pixel == key)
+            pixels[i * 4 + 3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count)
+{
+    Uint8* left  = pixels;
+    Uint8* right = pixels + count * 4;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+
+    // Swap blocks of 4 pixels from both ends, reversing each block
+    while (right - left >= 32)
+    {
+        right -= 16;
+
+        __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left), _mm_shuffle_epi32(second, _MM_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(first, _MM_SHUFFLE(0, 1, 2, 3)));
+
+        left += 16;
+    }
+
+#elif defined(SFML_IMAGEKERNELS_NEON)
+
+    while (right - left >= 32)
+    {
+        right -= 16;
+
+        uint32x4_t first  = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(left)));
+        uint32x4_t second = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(right)));
+        vst1q_u8(left, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(second), vget_low_u32(second))));
+        vst1q_u8(right, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(first), vget_low_u32(first))));
+
+        left += 16;
+    }
+
+#endif
+
+    // Remaining pixels in the middle
+    while (right - left >= 8)
+    {
+        right -= 4;
+        std::swap_ranges(left, left + 4, right);
+        left += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t count)
+{
+    std::size_t size = count * 4;
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(first + i), b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(second + i), a);
+    }
+
+#elif defined(SFML_IMAGEKERNELS_NEON)
+
+    for (; i + 16 <= size; i += 16)
+    {
+        uint8x16_t a = vld1q_u8(first + i);
+        uint8x16_t b = vld1q_u8(second + i);
+        vst1q_u8(first + i, b);
+        vst1q_u8(second + i, a);
+    }
+
+#endif
+
+    std::swap_ranges(first + i, first + size, second + i);
+}
+
+
+////////////////////////////////////////////////////////////
+void sumWeightedPixels(const float* pixels, const float* weights, std::size_t count, float* result)
+{
+#if defined(SFML_IMAGEKERNELS_SSE2)
+
+    // One pixel per register
+    __m128 sum = _mm_setzero_ps();
+    for (std::size_t i = 0; i < count; ++i)
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pixels + i * 4), _mm_set1_ps(weights[i])));
+    _mm_storeu_ps(result, sum);
+
+#elif defined(SFML_IMAGEKERNELS_NEON)
+
+    float32x4_t sum = vdupq_n_f32(0.f);
+    for (std::size_t i = 0; i < count; ++i)
+        sum = vmlaq_n_f32(sum, vld1q_f32(pixels + i * 4), weights[i]);
+    vst1q_f32(result, sum);
+
+#else
+
+    result[0] = result[1] = result[2] = result[3] = 0.f;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (int c = 0; c < 4; ++c)
+            result[c] += pixels[i * 4 + c] * weights[i];
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void addWeightedPixels(float* destination, const float* source, float weight, std::size_t count)
+{
+    std::size_t size = count * 4;
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+
+    // 2 pixels per iteration
+    const __m128 factor = _mm_set1_ps(weight);
+    for (; i + 8 <= size; i += 8)
+    {
+        __m128 first  = _mm_add_ps(_mm_loadu_ps(destination + i), _mm_mul_ps(_mm_loadu_ps(source + i), factor));
+        __m128 second = _mm_add_ps(_mm_loadu_ps(destination + i + 4), _mm_mul_ps(_mm_loadu_ps(source + i + 4), factor));
+        _mm_storeu_ps(destination + i, first);
+        _mm_storeu_ps(destination + i + 4, second);
+    }
+
+#elif defined(SFML_IMAGEKERNELS_NEON)
+
+    for (; i + 8 <= size; i += 8)
+    {
+        vst1q_f32(destination + i, vmlaq_n_f32(vld1q_f32(destination + i), vld1q_f32(source + i), weight));
+        vst1q_f32(destination + i + 4, vmlaq_n_f32(vld1q_f32(destination + i + 4), vld1q_f32(source + i + 4), weight));
+    }
+
+#endif
+
+    for (; i < size; ++i)
+        destination[i] += source[i] * weight;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGEKERNELS_HPP
+#define SFML_IMAGEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Blend RGBA pixels over other RGBA pixels
+///
+/// Each destination pixel is interpolated towards the source
+/// pixel using the alpha of the source, with the same integer
+/// rounding as the original per-pixel formula of Image::copy.
+///
+/// \param source      Source pixels
+/// \param destination Destination pixels, blended in place
+/// \param count       Number of pixels to blend
+///
+////////////////////////////////////////////////////////////
+void blendPixels(const Uint8* source, Uint8* destination, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Replace the alpha of the pixels matching a color
+///
+/// \param pixels Pixels to process in place
+/// \param count  Number of pixels to process
+/// \param color  RGBA components of the color to match
+/// \param alpha  Alpha to give to the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of a run of pixels in place
+///
+/// \param pixels Pixels to reverse
+/// \param count  Number of pixels to reverse
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Exchange two non-overlapping runs of pixels
+///
+/// \param first  First run of pixels
+/// \param second Second run of pixels
+/// \param count  Number of pixels in each run
+///
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Compute the weighted sum of consecutive float pixels
+///
+/// Pixels are made of 4 float components.
+///
+/// \param pixels  Pixels to sum
+/// \param weights Weight of each pixel
+/// \param count   Number of pixels to sum
+/// \param result  Array of 4 floats receiving the sum
+///
+////////////////////////////////////////////////////////////
+void sumWeightedPixels(const float* pixels, const float* weights, std::size_t count, float* result);
+
+////////////////////////////////////////////////////////////
+/// \brief Add a run of float pixels, scaled by a weight, to another
+///
+/// Pixels are made of 4 float components.
+///
+/// \param destination Pixels to add to
+/// \param source      Pixels to add
+/// \param weight      Factor to apply to the source pixels
+/// \param count       Number of pixels to add
+///
+////////////////////////////////////////////////////////////
+void addWeightedPixels(float* destination, const float* source, float weight, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEKERNELS_HPP
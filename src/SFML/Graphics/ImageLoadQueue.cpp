@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageLoadQueue.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ParallelFor.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageLoadQueue::ImageLoadQueue(const std::vector<std::string>& filenames, unsigned int threadCount) :
+m_filenames(filenames),
+m_images   (filenames.size()),
+m_ready    (),
+m_threads  (),
+m_mutex    (),
+m_nextFile (0),
+m_returned (0),
+m_current  (filenames.size()),
+m_cancelled(false)
+{
+    if (threadCount == 0)
+        threadCount = priv::getProcessorCount();
+
+    // Create the shared loader before the workers use it concurrently
+    priv::ImageLoader::getInstance();
+
+    std::size_t workerCount = std::min<std::size_t>(threadCount, m_filenames.size());
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        m_threads.push_back(new Thread(&ImageLoadQueue::decodeImages, this));
+        m_threads.back()->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ImageLoadQueue::~ImageLoadQueue()
+{
+    {
+        Lock lock(m_mutex);
+        m_cancelled = true;
+    }
+
+    for (std::vector<Thread*>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageLoadQueue::getFileCount() const
+{
+    return m_filenames.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageLoadQueue::getRemainingCount() const
+{
+    Lock lock(m_mutex);
+    return m_filenames.size() - m_returned;
+}
+
+
+////////////////////////////////////////////////////////////
+const Image* ImageLoadQueue::waitNext(std::size_t& index)
+{
+    // Poll the workers: there's no condition variable in SFML, and
+    // decoding an image takes much longer than the polling interval
+    for (;;)
+    {
+        bool done = false;
+        const Image* image = takeNext(index, done);
+        if (image || done)
+            return image;
+
+        sleep(milliseconds(1));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Image* ImageLoadQueue::pollNext(std::size_t& index)
+{
+    bool done = false;
+    return takeNext(index, done);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoadQueue::loadTextures(std::vector<Texture>& textures)
+{
+    textures.resize(m_filenames.size());
+
+    bool success = true;
+    std::size_t index;
+    while (const Image* image = waitNext(index))
+    {
+        if (image->getSize().x > 0)
+            success = textures[index].loadFromImage(*image) && success;
+        else
+            success = false;
+    }
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoadQueue::decodeImages()
+{
+    for (;;)
+    {
+        std::size_t index;
+        {
+            Lock lock(m_mutex);
+            if (m_cancelled || (m_nextFile == m_filenames.size()))
+                return;
+
+            index = m_nextFile++;
+        }
+
+        // The image is only accessed by this worker until it's marked as ready
+        m_images[index].loadFromFile(m_filenames[index]);
+
+        Lock lock(m_mutex);
+        m_ready.push_back(index);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Image* ImageLoadQueue::takeNext(std::size_t& index, bool& done)
+{
+    Lock lock(m_mutex);
+
+    // Release the previously returned image
+    if (m_current < m_images.size())
+    {
+        m_images[m_current] = Image();
+        m_current = m_images.size();
+    }
+
+    done = (m_returned == m_filenames.size());
+    if (m_ready.empty())
+        return NULL;
+
+    index = m_ready.front();
+    m_ready.pop_front();
+    ++m_returned;
+    m_current = index;
+
+    return &m_images[index];
+}
+
+} // namespace sf
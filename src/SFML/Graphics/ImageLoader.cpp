@@ -26,8 +26,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/MappedFile.hpp>
+#include <SFML/Graphics/PngEncoder.hpp>
+#include <SFML/Graphics/QoiCodec.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+// The decoded pixels are handed over to sf::Image, which releases them
+// with std::free: stb_image must keep its default allocator
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -37,7 +42,10 @@ extern "C"
     #include <jpeglib.h>
     #include <jerror.h>
 }
+#include <algorithm>
 #include <cctype>
+#include <climits>
+#include <vector>
 
 
 namespace
@@ -97,32 +105,41 @@ ImageLoader::~ImageLoader()
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromFile(const std::string& filename, Uint8*& pixels, Vector2u& size)
 {
-    // Clear the array (just in case)
-    pixels.clear();
-
     // Load the image and get a pointer to the pixels in memory
     int width = 0;
     int height = 0;
     int channels = 0;
-    unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    unsigned char* ptr = NULL;
+
+    // Decode straight from the file mapped in memory if possible,
+    // rather than having stb_image read it through a buffer
+    MappedFile file;
+    bool mapped = file.open(filename);
+
+    if (mapped && isQoi(file.getData(), file.getSize()))
+    {
+        // QOI format, which stb_image doesn't support
+        const char* error = NULL;
+        if (decodeQoi(file.getData(), file.getSize(), pixels, size, error))
+            return true;
+
+        err() << "Failed to load image \"" << filename << "\". Reason: " << error << std::endl;
+        return false;
+    }
+
+    if (mapped && (file.getSize() <= INT_MAX))
+        ptr = stbi_load_from_memory(file.getData(), static_cast<int>(file.getSize()), &width, &height, &channels, STBI_rgb_alpha);
+    else
+        ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
 
     if (ptr)
     {
-        // Assign the image properties
+        // Assign the image properties, the pixels are used as they were decoded
         size.x = width;
         size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        pixels = ptr;
 
         return true;
     }
@@ -137,13 +154,21 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, Uint8*& pixels, Vector2u& size)
 {
     // Check input parameters
     if (data && dataSize)
     {
-        // Clear the array (just in case)
-        pixels.clear();
+        // QOI format, which stb_image doesn't support
+        if (isQoi(data, dataSize))
+        {
+            const char* error = NULL;
+            if (decodeQoi(data, dataSize, pixels, size, error))
+                return true;
+
+            err() << "Failed to load image from memory. Reason: " << error << std::endl;
+            return false;
+        }
 
         // Load the image and get a pointer to the pixels in memory
         int width = 0;
@@ -154,19 +179,10 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
 
         if (ptr)
         {
-            // Assign the image properties
+            // Assign the image properties, the pixels are used as they were decoded
             size.x = width;
             size.y = height;
-
-            if (width && height)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(width * height * 4);
-                memcpy(&pixels[0], ptr, pixels.size());
-            }
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
+            pixels = ptr;
 
             return true;
         }
@@ -187,14 +203,26 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromStream(InputStream& stream, Uint8*& pixels, Vector2u& size)
 {
-    // Clear the array (just in case)
-    pixels.clear();
+    // Check the magic bytes of the formats stb_image doesn't support
+    char magic[4];
+    bool qoi = (stream.seek(0) == 0) && (stream.read(magic, sizeof(magic)) == sizeof(magic)) && isQoi(magic, sizeof(magic));
 
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
 
+    if (qoi)
+    {
+        // QOI format, decoded as the stream is read
+        const char* error = NULL;
+        if (decodeQoi(stream, pixels, size, error))
+            return true;
+
+        err() << "Failed to load image from stream. Reason: " << error << std::endl;
+        return false;
+    }
+
     // Setup the stb_image callbacks
     stbi_io_callbacks callbacks;
     callbacks.read = &read;
@@ -209,19 +237,10 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
     if (ptr)
     {
-        // Assign the image properties
+        // Assign the image properties, the pixels are used as they were decoded
         size.x = width;
         size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        pixels = ptr;
 
         return true;
     }
@@ -236,10 +255,10 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToFile(const std::string& filename, const Uint8* pixels, const Vector2u& size, const Image::SaveSettings& settings)
 {
     // Make sure the image is not empty
-    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
+    if (pixels && (size.x > 0) && (size.y > 0))
     {
         // Deduce the image type from its extension
 
@@ -250,25 +269,31 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
         if (extension == "bmp")
         {
             // BMP format
-            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, pixels))
                 return true;
         }
         else if (extension == "tga")
         {
             // TGA format
-            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, pixels))
                 return true;
         }
         else if (extension == "png")
         {
             // PNG format
-            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
+            if (writePng(filename, pixels, size, settings.compressionLevel, settings.threadCount))
                 return true;
         }
         else if (extension == "jpg" || extension == "jpeg")
         {
             // JPG format
-            if (writeJpg(filename, pixels, size.x, size.y))
+            if (writeJpg(filename, pixels, size.x, size.y, settings.jpegQuality))
+                return true;
+        }
+        else if (extension == "qoi")
+        {
+            // QOI format
+            if (writeQoi(filename, pixels, size))
                 return true;
         }
     }
@@ -279,7 +304,7 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
+bool ImageLoader::writeJpg(const std::string& filename, const Uint8* pixels, unsigned int width, unsigned int height, unsigned int quality)
 {
     // Open the file to write in
     FILE* file = fopen(filename.c_str(), "wb");
@@ -299,25 +324,24 @@ bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>
     compressInfos.in_color_space   = JCS_RGB;
     jpeg_stdio_dest(&compressInfos, file);
     jpeg_set_defaults(&compressInfos);
-    jpeg_set_quality(&compressInfos, 90, TRUE);
-
-    // Get rid of the alpha channel
-    std::vector<Uint8> buffer(width * height * 3);
-    for (std::size_t i = 0; i < width * height; ++i)
-    {
-        buffer[i * 3 + 0] = pixels[i * 4 + 0];
-        buffer[i * 3 + 1] = pixels[i * 4 + 1];
-        buffer[i * 3 + 2] = pixels[i * 4 + 2];
-    }
-    Uint8* ptr = &buffer[0];
+    jpeg_set_quality(&compressInfos, static_cast<int>(std::min(quality, 100u)), TRUE);
 
     // Start compression
     jpeg_start_compress(&compressInfos, TRUE);
 
-    // Write each row of the image
+    // Write each row of the image, getting rid of the alpha channel
+    // one row at a time rather than copying the whole image
+    std::vector<Uint8> buffer(width * 3);
+    JSAMPROW rawPointer = &buffer[0];
     while (compressInfos.next_scanline < compressInfos.image_height)
     {
-        JSAMPROW rawPointer = ptr + (compressInfos.next_scanline * width * 3);
+        const Uint8* row = pixels + static_cast<std::size_t>(compressInfos.next_scanline) * width * 4;
+        for (std::size_t i = 0; i < width; ++i)
+        {
+            buffer[i * 3 + 0] = row[i * 4 + 0];
+            buffer[i * 3 + 1] = row[i * 4 + 1];
+            buffer[i * 3 + 2] = row[i * 4 + 2];
+        }
         jpeg_write_scanlines(&compressInfos, &rawPointer, 1);
     }
 
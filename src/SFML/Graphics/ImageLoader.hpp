@@ -28,10 +28,10 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <string>
-#include <vector>
 
 
 namespace sf
@@ -59,39 +59,50 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file on disk
     ///
+    /// The file is mapped in memory rather than read, when
+    /// possible. On success, \a pixels receives an array
+    /// allocated with std::malloc, that the caller must free
+    /// with std::free.
+    ///
     /// \param filename Path of image file to load
-    /// \param pixels   Array of pixels to fill with loaded image
+    /// \param pixels   Receives the array of pixels of the loaded image
     /// \param size     Size of loaded image, in pixels
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromFile(const std::string& filename, Uint8*& pixels, Vector2u& size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file in memory
     ///
+    /// On success, \a pixels receives an array allocated with
+    /// std::malloc, that the caller must free with std::free.
+    ///
     /// \param data     Pointer to the file data in memory
     /// \param dataSize Size of the data to load, in bytes
-    /// \param pixels   Array of pixels to fill with loaded image
+    /// \param pixels   Receives the array of pixels of the loaded image
     /// \param size     Size of loaded image, in pixels
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, Uint8*& pixels, Vector2u& size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a custom stream
     ///
+    /// On success, \a pixels receives an array allocated with
+    /// std::malloc, that the caller must free with std::free.
+    ///
     /// \param stream Source stream to read from
-    /// \param pixels Array of pixels to fill with loaded image
+    /// \param pixels Receives the array of pixels of the loaded image
     /// \param size   Size of loaded image, in pixels
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromStream(InputStream& stream, Uint8*& pixels, Vector2u& size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
@@ -99,11 +110,12 @@ public:
     /// \param filename Path of image file to save
     /// \param pixels   Array of pixels to save to image
     /// \param size     Size of image to save, in pixels
+    /// \param settings Settings of the encoder of the file format
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToFile(const std::string& filename, const Uint8* pixels, const Vector2u& size, const Image::SaveSettings& settings);
 
 private:
 
@@ -126,11 +138,12 @@ private:
     /// \param pixels   Array of pixels to save to image
     /// \param width    Width of image to save, in pixels
     /// \param height   Height of image to save, in pixels
+    /// \param quality  Quality of the compression, from 0 to 100
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
+    bool writeJpg(const std::string& filename, const Uint8* pixels, unsigned int width, unsigned int height, unsigned int quality);
 };
 
 } // namespace priv
@@ -0,0 +1,311 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageResampler.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/Graphics/ParallelFor.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Minimum number of destination pixels filtered by each thread
+    const std::size_t pixelsPerThread = 64 * 1024;
+
+    const double pi = 3.141592653589793;
+
+    // Number of rows of the given width to give to each thread
+    std::size_t rowGrain(std::size_t width)
+    {
+        return std::max<std::size_t>(pixelsPerThread / std::max<std::size_t>(width, 1), 1);
+    }
+
+    // Source pixels contributing to each destination pixel, along one axis
+    struct Contributions
+    {
+        std::vector<std::size_t> first;   // First source pixel of each destination pixel
+        std::vector<std::size_t> count;   // Number of source pixels of each destination pixel
+        std::vector<float>       weights; // Normalized weights, 'taps' per destination pixel
+        std::size_t              taps;    // Maximum number of source pixels per destination pixel
+    };
+
+    // Evaluate the bilinear or Lanczos kernel at a distance from its center
+    double kernel(sf::Image::ResizeFilter filter, double distance)
+    {
+        distance = std::fabs(distance);
+
+        if (filter == sf::Image::Bilinear)
+            return (distance < 1) ? 1 - distance : 0;
+
+        // 3-lobed Lanczos
+        if (distance < 1e-6)
+            return 1;
+        if (distance >= 3)
+            return 0;
+        return 3 * std::sin(pi * distance) * std::sin(pi * distance / 3) / (pi * pi * distance * distance);
+    }
+
+    // Compute the contributions of the source pixels to each destination pixel
+    void computeContributions(unsigned int sourceSize, unsigned int size, sf::Image::ResizeFilter filter, Contributions& contributions)
+    {
+        // When shrinking, the kernel is stretched to cover all the source pixels
+        double scale       = static_cast<double>(sourceSize) / size;
+        double filterScale = std::max(scale, 1.0);
+        double radius      = filterScale * ((filter == sf::Image::Box) ? 0.5 : (filter == sf::Image::Bilinear) ? 1 : 3);
+
+        contributions.taps = static_cast<std::size_t>(std::ceil(radius * 2)) + 2;
+        contributions.first.resize(size);
+        contributions.count.resize(size);
+        contributions.weights.assign(size * contributions.taps, 0.f);
+
+        for (unsigned int x = 0; x < size; ++x)
+        {
+            double center = (x + 0.5) * scale;
+            int    begin  = std::max(static_cast<int>(std::floor(center - radius)), 0);
+            int    end    = std::min(static_cast<int>(std::ceil(center + radius)), static_cast<int>(sourceSize));
+            float* weights = &contributions.weights[x * contributions.taps];
+
+            double total = 0;
+            for (int i = begin; i < end; ++i)
+            {
+                double weight;
+                if (filter == sf::Image::Box)
+                    weight = std::max(std::min(center + radius, i + 1.0) - std::max(center - radius, static_cast<double>(i)), 0.0);
+                else
+                    weight = kernel(filter, (i + 0.5 - center) / filterScale);
+
+                weights[i - begin] = static_cast<float>(weight);
+                total += weight;
+            }
+
+            // Normalize, which also compensates the pixels cut at the borders
+            for (int i = begin; (i < end) && (total != 0); ++i)
+                weights[i - begin] = static_cast<float>(weights[i - begin] / total);
+
+            contributions.first[x] = begin;
+            contributions.count[x] = end - begin;
+        }
+    }
+
+    // Conversions between 8-bit components and linear float components
+    struct ColorTables
+    {
+        // Number of buckets of the encoding table
+        static const int encodeSteps = 4096;
+
+        explicit ColorTables(bool sRgb)
+        {
+            for (int i = 0; i < 256; ++i)
+                toLinear[i] = decode(i / 255.0, sRgb);
+
+            // A value encodes to the byte whose range of values it falls in
+            for (int i = 0; i < 255; ++i)
+                thresholds[i] = decode((i + 0.5) / 255.0, sRgb);
+
+            // Start the search of the byte from the lower end of the value's bucket
+            for (int i = 0; i <= encodeSteps; ++i)
+                startBytes[i] = static_cast<sf::Uint8>(std::upper_bound(thresholds, thresholds + 255, static_cast<float>(i) / encodeSteps) - thresholds);
+        }
+
+        static float decode(double value, bool sRgb)
+        {
+            if (!sRgb)
+                return static_cast<float>(value);
+
+            return static_cast<float>((value <= 0.04045) ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+        }
+
+        sf::Uint8 encode(float value) const
+        {
+            value = std::min(std::max(value, 0.f), 1.f);
+
+            // Buckets are smaller than the range of any byte, so this loop advances at most once
+            int byte = startBytes[static_cast<int>(value * encodeSteps)];
+            while ((byte < 255) && (thresholds[byte] <= value))
+                ++byte;
+
+            return static_cast<sf::Uint8>(byte);
+        }
+
+        static sf::Uint8 encodeAlpha(float alpha)
+        {
+            return static_cast<sf::Uint8>(std::min(alpha, 1.f) * 255 + 0.5f);
+        }
+
+        float     toLinear[256];
+        float     thresholds[255];
+        sf::Uint8 startBytes[encodeSteps + 1];
+    };
+
+    // Filter the rows of the source image horizontally into premultiplied linear pixels
+    struct HorizontalPass
+    {
+        void operator()(std::size_t begin, std::size_t end)
+        {
+            std::vector<float> row(sourceWidth * 4);
+
+            for (std::size_t y = begin; y < end; ++y)
+            {
+                // Convert the source row
+                const sf::Uint8* pixels = source + y * sourceWidth * 4;
+                for (std::size_t x = 0; x < sourceWidth * 4; x += 4)
+                {
+                    float alpha = pixels[x + 3] * (1.f / 255);
+                    row[x + 0] = tables->toLinear[pixels[x + 0]] * alpha;
+                    row[x + 1] = tables->toLinear[pixels[x + 1]] * alpha;
+                    row[x + 2] = tables->toLinear[pixels[x + 2]] * alpha;
+                    row[x + 3] = alpha;
+                }
+
+                // Filter it
+                float* result = destination + y * width * 4;
+                for (std::size_t x = 0; x < width; ++x)
+                {
+                    sf::priv::sumWeightedPixels(&row[contributions->first[x] * 4], &contributions->weights[x * contributions->taps],
+                                                contributions->count[x], result + x * 4);
+                }
+            }
+        }
+
+        const sf::Uint8*     source;
+        std::size_t          sourceWidth;
+        float*               destination;
+        std::size_t          width;
+        const Contributions* contributions;
+        const ColorTables*   tables;
+    };
+
+    // Filter the horizontally filtered rows vertically and encode the result
+    struct VerticalPass
+    {
+        void operator()(std::size_t begin, std::size_t end)
+        {
+            std::vector<float> row(width * 4);
+
+            for (std::size_t y = begin; y < end; ++y)
+            {
+                // Accumulate the contributing rows
+                std::fill(row.begin(), row.end(), 0.f);
+                for (std::size_t i = 0; i < contributions->count[y]; ++i)
+                {
+                    const float* sourceRow = source + (contributions->first[y] + i) * width * 4;
+                    sf::priv::addWeightedPixels(&row[0], sourceRow, contributions->weights[y * contributions->taps + i], width);
+                }
+
+                // Convert back to straight alpha and 8-bit components
+                sf::Uint8* pixels = destination + y * width * 4;
+                for (std::size_t x = 0; x < width * 4; x += 4)
+                {
+                    float alpha = row[x + 3];
+                    if (alpha > 0)
+                    {
+                        float inverse = 1.f / alpha;
+                        pixels[x + 0] = tables->encode(row[x + 0] * inverse);
+                        pixels[x + 1] = tables->encode(row[x + 1] * inverse);
+                        pixels[x + 2] = tables->encode(row[x + 2] * inverse);
+                        pixels[x + 3] = ColorTables::encodeAlpha(alpha);
+                    }
+                    else
+                    {
+                        pixels[x + 0] = pixels[x + 1] = pixels[x + 2] = pixels[x + 3] = 0;
+                    }
+                }
+            }
+        }
+
+        const float*         source;
+        sf::Uint8*           destination;
+        std::size_t          width;
+        const Contributions* contributions;
+        const ColorTables*   tables;
+    };
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void resamplePixels(const Uint8* source, const Vector2u& sourceSize, Uint8* destination,
+                    const Vector2u& size, Image::ResizeFilter filter, bool sRgb)
+{
+    if ((size.x == 0) || (size.y == 0) || (sourceSize.x == 0) || (sourceSize.y == 0))
+        return;
+
+    if (filter == Image::Nearest)
+    {
+        // Pick the source pixel under the center of each destination pixel
+        std::vector<std::size_t> columns(size.x);
+        for (unsigned int x = 0; x < size.x; ++x)
+            columns[x] = std::min(static_cast<std::size_t>((x + 0.5) * sourceSize.x / size.x), static_cast<std::size_t>(sourceSize.x - 1));
+
+        Uint8* pixels = destination;
+        for (unsigned int y = 0; y < size.y; ++y)
+        {
+            std::size_t row = std::min(static_cast<std::size_t>((y + 0.5) * sourceSize.y / size.y), static_cast<std::size_t>(sourceSize.y - 1));
+            const Uint8* sourceRow = source + row * sourceSize.x * 4;
+            for (unsigned int x = 0; x < size.x; ++x, pixels += 4)
+                std::copy(sourceRow + columns[x] * 4, sourceRow + columns[x] * 4 + 4, pixels);
+        }
+
+        return;
+    }
+
+    ColorTables tables(sRgb);
+
+    Contributions horizontal;
+    Contributions vertical;
+    computeContributions(sourceSize.x, size.x, filter, horizontal);
+    computeContributions(sourceSize.y, size.y, filter, vertical);
+
+    // Filter every source row horizontally
+    std::vector<float> intermediate(static_cast<std::size_t>(size.x) * sourceSize.y * 4);
+
+    HorizontalPass horizontalPass;
+    horizontalPass.source        = source;
+    horizontalPass.sourceWidth   = sourceSize.x;
+    horizontalPass.destination   = &intermediate[0];
+    horizontalPass.width         = size.x;
+    horizontalPass.contributions = &horizontal;
+    horizontalPass.tables        = &tables;
+    priv::parallelFor(sourceSize.y, rowGrain(size.x), 0, horizontalPass);
+
+    // Then filter the result vertically
+    VerticalPass verticalPass;
+    verticalPass.source        = &intermediate[0];
+    verticalPass.destination   = destination;
+    verticalPass.width         = size.x;
+    verticalPass.contributions = &vertical;
+    verticalPass.tables        = &tables;
+    priv::parallelFor(size.y, rowGrain(size.x), 0, verticalPass);
+}
+
+} // namespace priv
+
+} // namespace sf
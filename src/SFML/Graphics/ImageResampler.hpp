@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGERESAMPLER_HPP
+#define SFML_IMAGERESAMPLER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Resample RGBA pixels to a different size
+///
+/// Except for the nearest filter, pixels are filtered
+/// horizontally then vertically, with premultiplied alpha
+/// and, if \a sRgb is true, in linear color space.
+///
+/// \param source      Source pixels
+/// \param sourceSize  Size of the source, in pixels
+/// \param destination Array of size.x * size.y pixels receiving the result
+/// \param size        Size to resample to, in pixels
+/// \param filter      Filter to use
+/// \param sRgb        Are the color components sRGB-encoded?
+///
+////////////////////////////////////////////////////////////
+void resamplePixels(const Uint8* source, const Vector2u& sourceSize, Uint8* destination,
+                    const Vector2u& size, Image::ResizeFilter filter, bool sRgb);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGERESAMPLER_HPP
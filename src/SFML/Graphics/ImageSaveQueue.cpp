@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageSaveQueue.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageSaveQueue::ImageSaveQueue() :
+m_requests(),
+m_thread  (&ImageSaveQueue::saveImages, this),
+m_mutex   (),
+m_running (false),
+m_failed  (false)
+{
+    // Create the shared loader before the worker uses it
+    priv::ImageLoader::getInstance();
+}
+
+
+////////////////////////////////////////////////////////////
+ImageSaveQueue::~ImageSaveQueue()
+{
+    wait();
+    m_thread.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageSaveQueue::save(const Image& image, const std::string& filename, const Image::SaveSettings& settings)
+{
+    // Copy the image outside of the lock, so the worker is never kept waiting
+    Request* request = new Request;
+    request->image    = image;
+    request->filename = filename;
+    request->settings = settings;
+
+    Lock lock(m_mutex);
+    m_requests.push_back(request);
+
+    // Start the worker if it stopped after saving the previous images;
+    // launch first waits for the end of its previous run
+    if (!m_running)
+    {
+        m_running = true;
+        m_thread.launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageSaveQueue::getPendingCount() const
+{
+    Lock lock(m_mutex);
+    return m_requests.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageSaveQueue::wait()
+{
+    // Poll the worker: there's no condition variable in SFML, and
+    // saving an image takes much longer than the polling interval
+    while (getPendingCount() > 0)
+        sleep(milliseconds(1));
+
+    Lock lock(m_mutex);
+    bool success = !m_failed;
+    m_failed = false;
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageSaveQueue::saveImages()
+{
+    for (;;)
+    {
+        Request* request;
+        {
+            Lock lock(m_mutex);
+            if (m_requests.empty())
+            {
+                m_running = false;
+                return;
+            }
+
+            request = m_requests.front();
+        }
+
+        // The request stays in the queue while it's being saved, so that
+        // it's counted as pending; only this worker accesses it
+        bool success = request->image.saveToFile(request->filename, request->settings);
+        delete request;
+
+        Lock lock(m_mutex);
+        m_requests.pop_front();
+        if (!success)
+            m_failed = true;
+    }
+}
+
+} // namespace sf
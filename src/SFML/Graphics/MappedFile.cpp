@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/MappedFile.hpp>
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+MappedFile::MappedFile() :
+m_data(NULL),
+m_size(0)
+{
+#if defined(SFML_SYSTEM_WINDOWS)
+    m_mapping = NULL;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFile::open(const std::string& filename)
+{
+    close();
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    // The mapping keeps the file open, its handle is not needed anymore
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && (size.QuadPart > 0) && (static_cast<unsigned __int64>(size.QuadPart) <= static_cast<std::size_t>(-1)))
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+
+    if (!mapping)
+        return false;
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_data = static_cast<const Uint8*>(data);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+
+#else
+
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    // The mapping keeps the file open, its descriptor is not needed anymore
+    struct stat status;
+    void* data = MAP_FAILED;
+    if ((fstat(file, &status) == 0) && (status.st_size > 0))
+        data = mmap(NULL, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    // The file is usually read from start to end
+    madvise(data, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+
+    m_data = static_cast<const Uint8*>(data);
+    m_size = static_cast<std::size_t>(status.st_size);
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFile::close()
+{
+    if (!m_data)
+        return;
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+    m_mapping = NULL;
+
+#else
+
+    munmap(const_cast<Uint8*>(m_data), m_size);
+
+#endif
+
+    m_data = NULL;
+    m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* MappedFile::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t MappedFile::getSize() const
+{
+    return m_size;
+}
+
+} // namespace priv
+
+} // namespace sf
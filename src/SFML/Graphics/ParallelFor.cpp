@@ -0,0 +1,306 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParallelFor.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
+#include <vector>
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+    #include <climits>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+
+namespace
+{
+    // Query the number of processors once, at static initialization time,
+    // so that concurrent callers never race on a lazily filled cache
+    unsigned int queryProcessorCount()
+    {
+#if defined(SFML_SYSTEM_WINDOWS)
+
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        long processors = static_cast<long>(info.dwNumberOfProcessors);
+
+#else
+
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+#endif
+
+        return processors > 0 ? static_cast<unsigned int>(processors) : 1;
+    }
+
+    const unsigned int processorCount = queryProcessorCount();
+
+    // Counting semaphore, so that idle workers and callers waiting
+    // for their chunks block instead of polling
+    class Semaphore
+    {
+    public:
+
+        Semaphore()
+        {
+#if defined(SFML_SYSTEM_WINDOWS)
+            m_handle = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+#else
+            m_count = 0;
+            pthread_mutex_init(&m_mutex, NULL);
+            pthread_cond_init(&m_condition, NULL);
+#endif
+        }
+
+        ~Semaphore()
+        {
+#if defined(SFML_SYSTEM_WINDOWS)
+            CloseHandle(m_handle);
+#else
+            pthread_cond_destroy(&m_condition);
+            pthread_mutex_destroy(&m_mutex);
+#endif
+        }
+
+        void post(std::size_t count)
+        {
+#if defined(SFML_SYSTEM_WINDOWS)
+            ReleaseSemaphore(m_handle, static_cast<LONG>(count), NULL);
+#else
+            pthread_mutex_lock(&m_mutex);
+            m_count += count;
+            if (count == 1)
+                pthread_cond_signal(&m_condition);
+            else
+                pthread_cond_broadcast(&m_condition);
+            pthread_mutex_unlock(&m_mutex);
+#endif
+        }
+
+        void wait()
+        {
+#if defined(SFML_SYSTEM_WINDOWS)
+            WaitForSingleObject(m_handle, INFINITE);
+#else
+            pthread_mutex_lock(&m_mutex);
+            while (m_count == 0)
+                pthread_cond_wait(&m_condition, &m_mutex);
+            --m_count;
+            pthread_mutex_unlock(&m_mutex);
+#endif
+        }
+
+    private:
+
+        // Non-copyable
+        Semaphore(const Semaphore&);
+        Semaphore& operator =(const Semaphore&);
+
+#if defined(SFML_SYSTEM_WINDOWS)
+        HANDLE          m_handle;
+#else
+        std::size_t     m_count;
+        pthread_mutex_t m_mutex;
+        pthread_cond_t  m_condition;
+#endif
+    };
+
+    // Job submitted to the pool, living on the stack of the caller of runParallelJob
+    struct Batch
+    {
+        sf::priv::ParallelJob* job;
+        std::size_t            count;     // Number of elements to process
+        std::size_t            chunkSize; // Number of elements per chunk
+        std::size_t            chunks;    // Number of chunks
+        std::size_t            next;      // Next chunk to start
+        std::size_t            remaining; // Number of chunks not finished yet
+        Semaphore              done;      // Posted when the last chunk finishes
+    };
+
+    // Pool of worker threads shared by all the parallelFor calls
+    class WorkerPool
+    {
+    public:
+
+        static WorkerPool& getInstance()
+        {
+            // The pool is never destroyed: joining threads while the
+            // process exits (or the library is unloaded) can deadlock
+            sf::Lock lock(instanceMutex);
+            static WorkerPool* instance = new WorkerPool;
+            return *instance;
+        }
+
+        void run(Batch& batch)
+        {
+            // Offer all the chunks but the first one to the workers
+            {
+                sf::Lock lock(m_mutex);
+                m_batches.push_back(&batch);
+            }
+            m_available.post(batch.chunks - 1);
+
+            // Process the first chunk, then the ones that no worker has started yet
+            process(batch, 0);
+            std::size_t chunk;
+            while (claim(&batch, chunk))
+                process(batch, chunk);
+
+            // Wait for the chunks started by the workers
+            batch.done.wait();
+        }
+
+    private:
+
+        WorkerPool()
+        {
+            // The calling thread always takes part in the work
+            unsigned int count = sf::priv::getProcessorCount() - 1;
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                m_threads.push_back(new sf::Thread(&WorkerPool::work, this));
+                m_threads.back()->launch();
+            }
+        }
+
+        // Take the next chunk of a batch (of any batch if NULL), in submission order
+        bool claim(Batch* only, std::size_t& chunk)
+        {
+            sf::Lock lock(m_mutex);
+
+            std::deque<Batch*>::iterator it = m_batches.begin();
+            if (only)
+                it = std::find(m_batches.begin(), m_batches.end(), only);
+
+            if (it == m_batches.end())
+                return false;
+
+            Batch* batch = *it;
+            chunk = batch->next++;
+            if (batch->next == batch->chunks)
+                m_batches.erase(it);
+
+            return true;
+        }
+
+        // Run a chunk of a batch and signal the batch when it was the last one
+        void process(Batch& batch, std::size_t chunk)
+        {
+            // std::min is avoided because windows.h may define a min macro
+            std::size_t begin = chunk * batch.chunkSize;
+            std::size_t end   = begin + batch.chunkSize;
+            if (end > batch.count)
+                end = batch.count;
+            if (begin < end)
+                batch.job->run(begin, end);
+
+            bool last;
+            {
+                sf::Lock lock(m_mutex);
+                last = (--batch.remaining == 0);
+            }
+
+            if (last)
+                batch.done.post(1);
+        }
+
+        void work()
+        {
+            for (;;)
+            {
+                m_available.wait();
+
+                // The chunk may already have been taken by the caller of its batch
+                Batch* batch = NULL;
+                std::size_t chunk = 0;
+                {
+                    sf::Lock lock(m_mutex);
+                    if (!m_batches.empty())
+                    {
+                        batch = m_batches.front();
+                        chunk = batch->next++;
+                        if (batch->next == batch->chunks)
+                            m_batches.pop_front();
+                    }
+                }
+
+                if (batch)
+                    process(*batch, chunk);
+            }
+        }
+
+        static sf::Mutex instanceMutex;
+
+        sf::Mutex                m_mutex;     // Protects the batches and their counters
+        std::deque<Batch*>       m_batches;   // Batches that still have chunks to start
+        Semaphore                m_available; // Posted once per chunk offered to the workers
+        std::vector<sf::Thread*> m_threads;   // Worker threads
+    };
+
+    sf::Mutex WorkerPool::instanceMutex;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+unsigned int getProcessorCount()
+{
+    // processorCount is still zero if called during another unit's static initialization
+    return processorCount > 0 ? processorCount : queryProcessorCount();
+}
+
+
+////////////////////////////////////////////////////////////
+void runParallelJob(ParallelJob& job, std::size_t count, std::size_t chunks)
+{
+    Batch batch;
+    batch.job       = &job;
+    batch.count     = count;
+    batch.chunkSize = (count + chunks - 1) / chunks;
+    batch.chunks    = (count + batch.chunkSize - 1) / batch.chunkSize;
+    batch.next      = 1;
+    batch.remaining = batch.chunks;
+
+    if (batch.chunks <= 1)
+    {
+        job.run(0, count);
+        return;
+    }
+
+    WorkerPool::getInstance().run(batch);
+}
+
+} // namespace priv
+
+} // namespace sf
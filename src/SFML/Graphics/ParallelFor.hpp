@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PARALLELFOR_HPP
+#define SFML_PARALLELFOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <algorithm>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Get the number of processors available to the process
+///
+/// \return Number of logical processors, at least 1
+///
+////////////////////////////////////////////////////////////
+unsigned int getProcessorCount();
+
+////////////////////////////////////////////////////////////
+/// \brief Work split in ranges by parallelFor
+///
+////////////////////////////////////////////////////////////
+class ParallelJob
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~ParallelJob() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a range of the job
+    ///
+    /// \param begin First index of the range
+    /// \param end   One past the last index of the range
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void run(std::size_t begin, std::size_t end) = 0;
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Job calling a functor on each range
+///
+////////////////////////////////////////////////////////////
+template <typename F>
+class ParallelFunctor : public ParallelJob
+{
+public:
+
+    explicit ParallelFunctor(F& functor) :
+    m_functor(functor)
+    {
+    }
+
+    virtual void run(std::size_t begin, std::size_t end)
+    {
+        m_functor(begin, end);
+    }
+
+private:
+
+    F& m_functor; ///< Functor processing the ranges
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Run a job on the worker pool, split in chunks
+///
+/// The range [0, count) is split in \a chunks contiguous
+/// chunks. Chunks are processed by a pool of worker threads,
+/// created on first use and kept until the process exits,
+/// and by the calling thread, which takes the chunks that no
+/// worker has started yet. The function returns once all the
+/// chunks are done.
+///
+/// \param job    Job to run
+/// \param count  Number of elements to process
+/// \param chunks Number of chunks to split the range in
+///
+////////////////////////////////////////////////////////////
+void runParallelJob(ParallelJob& job, std::size_t count, std::size_t chunks);
+
+////////////////////////////////////////////////////////////
+/// \brief Process the range [0, count) on several threads
+///
+/// The range is split in contiguous chunks of at least
+/// \a grain elements, one per thread; \a functor is called
+/// as functor(begin, end) for each chunk and must support
+/// being called concurrently on disjoint ranges. Chunks are
+/// run by a persistent pool of worker threads and by the
+/// calling thread, so that calling this function every frame
+/// doesn't pay for starting threads; the function returns
+/// once all the chunks are done.
+///
+/// \param count       Number of elements to process
+/// \param grain       Minimum number of elements per thread
+/// \param threadCount Maximum number of threads to use, 0 for one per processor
+/// \param functor     Functor to call on each chunk
+///
+////////////////////////////////////////////////////////////
+template <typename F>
+void parallelFor(std::size_t count, std::size_t grain, unsigned int threadCount, F& functor)
+{
+    if (threadCount == 0)
+        threadCount = getProcessorCount();
+
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t chunks = std::min<std::size_t>(threadCount, (count + grain - 1) / grain);
+
+    // Not worth involving other threads
+    if (chunks <= 1)
+    {
+        if (count > 0)
+            functor(0, count);
+        return;
+    }
+
+    ParallelFunctor<F> job(functor);
+    runParallelJob(job, count, chunks);
+}
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PARALLELFOR_HPP
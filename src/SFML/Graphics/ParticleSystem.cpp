@@ -0,0 +1,339 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/ParticleAffector.hpp>
+#include <SFML/Graphics/ParticleEmitter.hpp>
+#include <SFML/Graphics/ParallelFor.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Minimum number of particles worth handing to a separate thread
+    const std::size_t updateGrain = 2048;
+
+    // Moves a range of particles, applies the affectors and writes their vertices
+    struct ParticleUpdater
+    {
+        void operator()(std::size_t begin, std::size_t end) const
+        {
+            // Integrate, one attribute at a time so that the loops vectorize
+            for (std::size_t i = begin; i < end; ++i)
+                particles.ages[i] += elapsed;
+
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                particles.positions[i].x += particles.velocities[i].x * elapsed;
+                particles.positions[i].y += particles.velocities[i].y * elapsed;
+            }
+
+            for (std::size_t i = begin; i < end; ++i)
+                particles.rotations[i] += particles.rotationSpeeds[i] * elapsed;
+
+            // Apply the affectors
+            for (std::size_t i = 0; i < affectorCount; ++i)
+                affectors[i]->affect(particles, begin, end, time);
+
+            // Generate the geometry
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                float angle  = particles.rotations[i] * 3.141592654f / 180.f;
+                float half   = particles.sizes[i] / 2.f;
+                float cosine = std::cos(angle) * half;
+                float sine   = std::sin(angle) * half;
+
+                sf::Vector2f position = particles.positions[i];
+                sf::Vector2f right(cosine, sine);
+                sf::Vector2f down(-sine, cosine);
+
+                sf::Vertex* quad = vertices + i * 6;
+
+                quad[0].position = position - right - down;
+                quad[1].position = position + right - down;
+                quad[2].position = position - right + down;
+                quad[5].position = position + right + down;
+                quad[3].position = quad[2].position;
+                quad[4].position = quad[1].position;
+
+                quad[0].texCoords = texCoords[0];
+                quad[1].texCoords = texCoords[1];
+                quad[2].texCoords = texCoords[2];
+                quad[3].texCoords = texCoords[2];
+                quad[4].texCoords = texCoords[1];
+                quad[5].texCoords = texCoords[3];
+
+                sf::Color color = particles.colors[i];
+                for (int j = 0; j < 6; ++j)
+                    quad[j].color = color;
+            }
+        }
+
+        sf::ParticleSystem::Arrays         particles;
+        const sf::ParticleAffector* const* affectors;
+        std::size_t                        affectorCount;
+        sf::Vertex*                        vertices;
+        sf::Vector2f                       texCoords[4];
+        sf::Time                           time;
+        float                              elapsed;
+    };
+
+    // Moves the last element of an array to a given index and drops it
+    template <typename T>
+    void moveLast(std::vector<T>& array, std::size_t index)
+    {
+        array[index] = array.back();
+        array.pop_back();
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ParticleSystem::Particle::Particle() :
+position     (0, 0),
+velocity     (0, 0),
+rotation     (0),
+rotationSpeed(0),
+size         (1),
+color        (Color::White),
+lifetime     (seconds(1))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem() :
+m_positions     (),
+m_velocities    (),
+m_rotations     (),
+m_rotationSpeeds(),
+m_sizes         (),
+m_colors        (),
+m_ages          (),
+m_lifetimes     (),
+m_vertices      (),
+m_emitters      (),
+m_affectors     (),
+m_texture       (NULL),
+m_textureRect   (),
+m_threadCount   (1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTexture(const Texture& texture, const IntRect& textureRect)
+{
+    m_texture = &texture;
+
+    if ((textureRect.width == 0) || (textureRect.height == 0))
+        m_textureRect = IntRect(0, 0, texture.getSize().x, texture.getSize().y);
+    else
+        m_textureRect = textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::addEmitter(ParticleEmitter& emitter)
+{
+    m_emitters.push_back(&emitter);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeEmitter(ParticleEmitter& emitter)
+{
+    m_emitters.erase(std::remove(m_emitters.begin(), m_emitters.end(), &emitter), m_emitters.end());
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::addAffector(const ParticleAffector& affector)
+{
+    m_affectors.push_back(&affector);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeAffector(const ParticleAffector& affector)
+{
+    m_affectors.erase(std::remove(m_affectors.begin(), m_affectors.end(), &affector), m_affectors.end());
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::addParticle(const Particle& particle)
+{
+    m_positions.push_back(particle.position);
+    m_velocities.push_back(particle.velocity);
+    m_rotations.push_back(particle.rotation);
+    m_rotationSpeeds.push_back(particle.rotationSpeed);
+    m_sizes.push_back(particle.size);
+    m_colors.push_back(particle.color);
+    m_ages.push_back(0.f);
+    m_lifetimes.push_back(particle.lifetime.asSeconds());
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::reserve(std::size_t count)
+{
+    m_positions.reserve(count);
+    m_velocities.reserve(count);
+    m_rotations.reserve(count);
+    m_rotationSpeeds.reserve(count);
+    m_sizes.reserve(count);
+    m_colors.reserve(count);
+    m_ages.reserve(count);
+    m_lifetimes.reserve(count);
+    m_vertices.reserve(count * 6);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::clear()
+{
+    m_positions.clear();
+    m_velocities.clear();
+    m_rotations.clear();
+    m_rotationSpeeds.clear();
+    m_sizes.clear();
+    m_colors.clear();
+    m_ages.clear();
+    m_lifetimes.clear();
+    m_vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getParticleCount() const
+{
+    return m_positions.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setThreadCount(unsigned int count)
+{
+    m_threadCount = count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ParticleSystem::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::update(Time elapsed)
+{
+    // Create the new particles
+    for (std::size_t i = 0; i < m_emitters.size(); ++i)
+        m_emitters[i]->emit(*this, elapsed);
+
+    // Drop the particles that die during this update, so that
+    // the remaining ones can be processed as a contiguous range
+    removeDeadParticles(elapsed.asSeconds());
+
+    std::size_t count = m_positions.size();
+    m_vertices.resize(count * 6);
+    if (count == 0)
+        return;
+
+    ParticleUpdater updater;
+    updater.particles.positions      = &m_positions[0];
+    updater.particles.velocities     = &m_velocities[0];
+    updater.particles.rotations      = &m_rotations[0];
+    updater.particles.rotationSpeeds = &m_rotationSpeeds[0];
+    updater.particles.sizes          = &m_sizes[0];
+    updater.particles.colors         = &m_colors[0];
+    updater.particles.ages           = &m_ages[0];
+    updater.particles.lifetimes      = &m_lifetimes[0];
+    updater.affectors                = m_affectors.empty() ? NULL : &m_affectors[0];
+    updater.affectorCount            = m_affectors.size();
+    updater.vertices                 = &m_vertices[0];
+    updater.time                     = elapsed;
+    updater.elapsed                  = elapsed.asSeconds();
+
+    float left   = static_cast<float>(m_textureRect.left);
+    float top    = static_cast<float>(m_textureRect.top);
+    float right  = left + m_textureRect.width;
+    float bottom = top + m_textureRect.height;
+    updater.texCoords[0] = Vector2f(left, top);
+    updater.texCoords[1] = Vector2f(right, top);
+    updater.texCoords[2] = Vector2f(left, bottom);
+    updater.texCoords[3] = Vector2f(right, bottom);
+
+    priv::parallelFor(count, updateGrain, m_threadCount, updater);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_vertices.empty())
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeDeadParticles(float elapsed)
+{
+    std::size_t i = 0;
+    while (i < m_ages.size())
+    {
+        if (m_ages[i] + elapsed < m_lifetimes[i])
+        {
+            ++i;
+            continue;
+        }
+
+        // Order doesn't matter, replace the dead particle with the last one
+        moveLast(m_positions, i);
+        moveLast(m_velocities, i);
+        moveLast(m_rotations, i);
+        moveLast(m_rotationSpeeds, i);
+        moveLast(m_sizes, i);
+        moveLast(m_colors, i);
+        moveLast(m_ages, i);
+        moveLast(m_lifetimes, i);
+    }
+}
+
+} // namespace sf
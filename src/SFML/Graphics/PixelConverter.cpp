@@ -0,0 +1,466 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelConverter.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Number of pixels converted at once through the intermediate buffer
+    const std::size_t blockSize = 256;
+
+    // Is the format made of float components?
+    bool isFloatFormat(sf::Image::PixelFormat format)
+    {
+        return (format == sf::Image::R16F) || (format == sf::Image::RGBA16F) || (format == sf::Image::RGBA32F);
+    }
+
+    // Read and write 16-bit values in native byte order, as OpenGL expects them
+    sf::Uint16 load16(const sf::Uint8* bytes)
+    {
+        sf::Uint16 value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    void store16(sf::Uint8* bytes, sf::Uint16 value)
+    {
+        std::memcpy(bytes, &value, sizeof(value));
+    }
+
+    // Scale a component of n bits to 8 bits and back, rounding to nearest
+    sf::Uint8 expand(unsigned int value, unsigned int maximum)
+    {
+        return static_cast<sf::Uint8>((value * 255 + maximum / 2) / maximum);
+    }
+
+    unsigned int reduce(sf::Uint8 value, unsigned int maximum)
+    {
+        return (value * maximum + 127) / 255;
+    }
+
+    // Scale a float component to an integer in [0, maximum], rounding to nearest (NaN gives 0)
+    unsigned int quantize(float value, unsigned int maximum)
+    {
+        if (!(value > 0.f))
+            return 0;
+        if (value >= 1.f)
+            return maximum;
+
+        return static_cast<unsigned int>(value * maximum + 0.5f);
+    }
+
+    // Convert a float to a half float, rounding to nearest even
+    sf::Uint16 floatToHalf(float value)
+    {
+        sf::Uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        sf::Uint32 sign      = (bits >> 16) & 0x8000;
+        sf::Uint32 magnitude = bits & 0x7FFFFFFF;
+
+        // Infinity and NaN (keeping NaNs quiet)
+        if (magnitude >= 0x7F800000)
+            return static_cast<sf::Uint16>(sign | 0x7C00 | ((magnitude > 0x7F800000) ? 0x0200 : 0));
+
+        // Too large, rounds to infinity (65520 is halfway between 65504 and 65536)
+        if (magnitude >= 0x477FF000)
+            return static_cast<sf::Uint16>(sign | 0x7C00);
+
+        // Below the smallest normal half float (2^-14): denormal, in units of 2^-24
+        if (magnitude < 0x38800000)
+        {
+            // At most 2^-25, rounds to zero
+            if (magnitude <= 0x33000000)
+                return static_cast<sf::Uint16>(sign);
+
+            sf::Uint32 mantissa = (magnitude & 0x007FFFFF) | 0x00800000;
+            sf::Uint32 shift    = 126 - (magnitude >> 23);
+            sf::Uint32 half     = mantissa >> shift;
+            sf::Uint32 rest     = mantissa & ((1u << shift) - 1);
+            sf::Uint32 halfway  = 1u << (shift - 1);
+            if ((rest > halfway) || ((rest == halfway) && (half & 1)))
+                ++half;
+
+            return static_cast<sf::Uint16>(sign | half);
+        }
+
+        // Normal: rebias the exponent from 127 to 15 and round the mantissa,
+        // a carry correctly moves the value to the next exponent
+        sf::Uint32 half = (magnitude - 0x38000000) >> 13;
+        sf::Uint32 rest = magnitude & 0x1FFF;
+        if ((rest > 0x1000) || ((rest == 0x1000) && (half & 1)))
+            ++half;
+
+        return static_cast<sf::Uint16>(sign | half);
+    }
+
+    // Convert a half float to a float, which is always exact
+    float halfToFloat(sf::Uint16 half)
+    {
+        sf::Uint32 sign     = static_cast<sf::Uint32>(half & 0x8000) << 16;
+        sf::Uint32 exponent = (half >> 10) & 0x1F;
+        sf::Uint32 mantissa = half & 0x03FF;
+
+        sf::Uint32 bits;
+        if (exponent == 0x1F)
+        {
+            // Infinity and NaN
+            bits = sign | 0x7F800000 | (mantissa << 13);
+        }
+        else if (exponent)
+        {
+            // Normal
+            bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        else if (mantissa)
+        {
+            // Denormal, mantissa * 2^-24
+            float value = static_cast<float>(mantissa) / 16777216.f;
+            return sign ? -value : value;
+        }
+        else
+        {
+            // Zero
+            bits = sign;
+        }
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // Float and half float values of the 8-bit components, computed once at
+    // startup so that the threads converting pixels never initialize them
+    struct ByteTables
+    {
+        ByteTables()
+        {
+            for (unsigned int i = 0; i < 256; ++i)
+            {
+                toFloat[i] = i / 255.f;
+                toHalf[i]  = floatToHalf(toFloat[i]);
+            }
+        }
+
+        float      toFloat[256];
+        sf::Uint16 toHalf[256];
+    };
+
+    const ByteTables byteTables;
+
+    // Decode pixels of a normalized format to RGBA8
+    void decodeBytes(const sf::Uint8* source, sf::Image::PixelFormat format, sf::Uint8* rgba, std::size_t count)
+    {
+        switch (format)
+        {
+            case sf::Image::RGBA8:
+                std::memcpy(rgba, source, count * 4);
+                break;
+
+            case sf::Image::R8:
+                for (std::size_t i = 0; i < count; ++i, rgba += 4)
+                {
+                    rgba[0] = source[i];
+                    rgba[1] = 0;
+                    rgba[2] = 0;
+                    rgba[3] = 255;
+                }
+                break;
+
+            case sf::Image::RG8:
+                for (std::size_t i = 0; i < count; ++i, source += 2, rgba += 4)
+                {
+                    rgba[0] = source[0];
+                    rgba[1] = source[1];
+                    rgba[2] = 0;
+                    rgba[3] = 255;
+                }
+                break;
+
+            case sf::Image::RGB8:
+                for (std::size_t i = 0; i < count; ++i, source += 3, rgba += 4)
+                {
+                    rgba[0] = source[0];
+                    rgba[1] = source[1];
+                    rgba[2] = source[2];
+                    rgba[3] = 255;
+                }
+                break;
+
+            case sf::Image::RGB565:
+                for (std::size_t i = 0; i < count; ++i, source += 2, rgba += 4)
+                {
+                    sf::Uint16 value = load16(source);
+                    rgba[0] = expand(value >> 11, 31);
+                    rgba[1] = expand((value >> 5) & 0x3F, 63);
+                    rgba[2] = expand(value & 0x1F, 31);
+                    rgba[3] = 255;
+                }
+                break;
+
+            case sf::Image::RGBA4444:
+                for (std::size_t i = 0; i < count; ++i, source += 2, rgba += 4)
+                {
+                    sf::Uint16 value = load16(source);
+                    rgba[0] = static_cast<sf::Uint8>((value >> 12) * 17);
+                    rgba[1] = static_cast<sf::Uint8>(((value >> 8) & 0xF) * 17);
+                    rgba[2] = static_cast<sf::Uint8>(((value >> 4) & 0xF) * 17);
+                    rgba[3] = static_cast<sf::Uint8>((value & 0xF) * 17);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    // Encode RGBA8 pixels to a normalized format
+    void encodeBytes(const sf::Uint8* rgba, sf::Uint8* destination, sf::Image::PixelFormat format, std::size_t count)
+    {
+        switch (format)
+        {
+            case sf::Image::RGBA8:
+                std::memcpy(destination, rgba, count * 4);
+                break;
+
+            case sf::Image::R8:
+                for (std::size_t i = 0; i < count; ++i, rgba += 4)
+                    destination[i] = rgba[0];
+                break;
+
+            case sf::Image::RG8:
+                for (std::size_t i = 0; i < count; ++i, rgba += 4, destination += 2)
+                {
+                    destination[0] = rgba[0];
+                    destination[1] = rgba[1];
+                }
+                break;
+
+            case sf::Image::RGB8:
+                for (std::size_t i = 0; i < count; ++i, rgba += 4, destination += 3)
+                {
+                    destination[0] = rgba[0];
+                    destination[1] = rgba[1];
+                    destination[2] = rgba[2];
+                }
+                break;
+
+            case sf::Image::RGB565:
+                for (std::size_t i = 0; i < count; ++i, rgba += 4, destination += 2)
+                    store16(destination, static_cast<sf::Uint16>((reduce(rgba[0], 31) << 11) |
+                                                                 (reduce(rgba[1], 63) << 5) |
+                                                                  reduce(rgba[2], 31)));
+                break;
+
+            case sf::Image::RGBA4444:
+                for (std::size_t i = 0; i < count; ++i, rgba += 4, destination += 2)
+                    store16(destination, static_cast<sf::Uint16>((reduce(rgba[0], 15) << 12) |
+                                                                 (reduce(rgba[1], 15) << 8) |
+                                                                 (reduce(rgba[2], 15) << 4) |
+                                                                  reduce(rgba[3], 15)));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    // Decode pixels of any format to float RGBA
+    void decodeFloats(const sf::Uint8* source, sf::Image::PixelFormat format, float* rgba, std::size_t count)
+    {
+        switch (format)
+        {
+            case sf::Image::R16F:
+                for (std::size_t i = 0; i < count; ++i, source += 2, rgba += 4)
+                {
+                    rgba[0] = halfToFloat(load16(source));
+                    rgba[1] = 0.f;
+                    rgba[2] = 0.f;
+                    rgba[3] = 1.f;
+                }
+                break;
+
+            case sf::Image::RGBA16F:
+                for (std::size_t i = 0; i < count * 4; ++i, source += 2)
+                    rgba[i] = halfToFloat(load16(source));
+                break;
+
+            case sf::Image::RGBA32F:
+                std::memcpy(rgba, source, count * 4 * sizeof(float));
+                break;
+
+            default:
+            {
+                // Normalized formats go through their 8-bit components, which hold them exactly
+                sf::Uint8 bytes[blockSize * 4];
+                for (std::size_t done = 0; done < count; )
+                {
+                    std::size_t size = std::min(blockSize, count - done);
+                    decodeBytes(source + done * sf::Image::getPixelSize(format), format, bytes, size);
+                    for (std::size_t i = 0; i < size * 4; ++i)
+                        rgba[done * 4 + i] = byteTables.toFloat[bytes[i]];
+                    done += size;
+                }
+                break;
+            }
+        }
+    }
+
+    // Encode float RGBA pixels to any format
+    void encodeFloats(const float* rgba, sf::Uint8* destination, sf::Image::PixelFormat format, std::size_t count)
+    {
+        switch (format)
+        {
+            case sf::Image::RGBA8:
+            case sf::Image::R8:
+            case sf::Image::RG8:
+            case sf::Image::RGB8:
+            {
+                sf::Uint8 bytes[blockSize * 4];
+                for (std::size_t done = 0; done < count; )
+                {
+                    std::size_t size = std::min(blockSize, count - done);
+                    for (std::size_t i = 0; i < size * 4; ++i)
+                        bytes[i] = static_cast<sf::Uint8>(quantize(rgba[done * 4 + i], 255));
+                    encodeBytes(bytes, destination + done * sf::Image::getPixelSize(format), format, size);
+                    done += size;
+                }
+                break;
+            }
+
+            // Packed formats are quantized directly, not through 8 bits, to round only once
+            case sf::Image::RGB565:
+                for (std::size_t i = 0; i < count; ++i, rgba += 4, destination += 2)
+                    store16(destination, static_cast<sf::Uint16>((quantize(rgba[0], 31) << 11) |
+                                                                 (quantize(rgba[1], 63) << 5) |
+                                                                  quantize(rgba[2], 31)));
+                break;
+
+            case sf::Image::RGBA4444:
+                for (std::size_t i = 0; i < count; ++i, rgba += 4, destination += 2)
+                    store16(destination, static_cast<sf::Uint16>((quantize(rgba[0], 15) << 12) |
+                                                                 (quantize(rgba[1], 15) << 8) |
+                                                                 (quantize(rgba[2], 15) << 4) |
+                                                                  quantize(rgba[3], 15)));
+                break;
+
+            case sf::Image::R16F:
+                for (std::size_t i = 0; i < count; ++i, rgba += 4, destination += 2)
+                    store16(destination, floatToHalf(rgba[0]));
+                break;
+
+            case sf::Image::RGBA16F:
+                for (std::size_t i = 0; i < count * 4; ++i, destination += 2)
+                    store16(destination, floatToHalf(rgba[i]));
+                break;
+
+            case sf::Image::RGBA32F:
+                std::memcpy(destination, rgba, count * 4 * sizeof(float));
+                break;
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void convertPixels(const Uint8* source, Image::PixelFormat sourceFormat,
+                   Uint8* destination, Image::PixelFormat destinationFormat, std::size_t count)
+{
+    std::size_t sourceSize      = Image::getPixelSize(sourceFormat);
+    std::size_t destinationSize = Image::getPixelSize(destinationFormat);
+
+    if (sourceFormat == destinationFormat)
+    {
+        std::memcpy(destination, source, count * sourceSize);
+    }
+    else if (!isFloatFormat(sourceFormat) && !isFloatFormat(destinationFormat))
+    {
+        // Normalized formats are converted through RGBA8, which holds all of them exactly;
+        // the intermediate buffer is skipped when one side already is RGBA8
+        if (sourceFormat == Image::RGBA8)
+        {
+            encodeBytes(source, destination, destinationFormat, count);
+        }
+        else if (destinationFormat == Image::RGBA8)
+        {
+            decodeBytes(source, sourceFormat, destination, count);
+        }
+        else
+        {
+            Uint8 rgba[blockSize * 4];
+            for (std::size_t done = 0; done < count; done += blockSize)
+            {
+                std::size_t size = std::min(blockSize, count - done);
+                decodeBytes(source + done * sourceSize, sourceFormat, rgba, size);
+                encodeBytes(rgba, destination + done * destinationSize, destinationFormat, size);
+            }
+        }
+    }
+    else if (!isFloatFormat(sourceFormat) && (destinationFormat != Image::RGBA32F))
+    {
+        // Normalized formats are converted to half floats through RGBA8 and a table
+        Uint8 rgba[blockSize * 4];
+        for (std::size_t done = 0; done < count; done += blockSize)
+        {
+            std::size_t size   = std::min(blockSize, count - done);
+            Uint8*      pixels = destination + done * destinationSize;
+            decodeBytes(source + done * sourceSize, sourceFormat, rgba, size);
+            if (destinationFormat == Image::R16F)
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                    store16(pixels + i * 2, byteTables.toHalf[rgba[i * 4]]);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < size * 4; ++i)
+                    store16(pixels + i * 2, byteTables.toHalf[rgba[i]]);
+            }
+        }
+    }
+    else
+    {
+        // Float formats are converted through float RGBA
+        float rgba[blockSize * 4];
+        for (std::size_t done = 0; done < count; done += blockSize)
+        {
+            std::size_t size = std::min(blockSize, count - done);
+            decodeFloats(source + done * sourceSize, sourceFormat, rgba, size);
+            encodeFloats(rgba, destination + done * destinationSize, destinationFormat, size);
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
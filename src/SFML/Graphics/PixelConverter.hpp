@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PIXELCONVERTER_HPP
+#define SFML_PIXELCONVERTER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Convert a run of pixels from a pixel format to another
+///
+/// Components that the source format doesn't have are read
+/// as OpenGL does: 0 for green and blue, 1 for alpha.
+/// Components that the destination format doesn't have are
+/// dropped. Normalized components are rounded to the nearest
+/// representable value, float components are clamped to
+/// [0, 1] when converted to a normalized format, and half
+/// floats are rounded to nearest even.
+///
+/// \param source            Source pixels
+/// \param sourceFormat      Format of the source pixels
+/// \param destination       Destination pixels, must not overlap the source
+/// \param destinationFormat Format of the destination pixels
+/// \param count             Number of pixels to convert
+///
+////////////////////////////////////////////////////////////
+void convertPixels(const Uint8* source, Image::PixelFormat sourceFormat,
+                   Uint8* destination, Image::PixelFormat destinationFormat, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PIXELCONVERTER_HPP
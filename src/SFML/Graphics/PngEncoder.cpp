@@ -0,0 +1,645 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PngEncoder.hpp>
+#include <SFML/Graphics/ParallelFor.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Size of the deflate window, which is also the farthest match distance
+    const std::size_t windowSize = 32768;
+
+    // Longest match that deflate can encode
+    const std::size_t maxMatchLength = 258;
+
+    // Number of bits of the hash used to look up matches
+    const unsigned int hashBits = 15;
+
+    // Amount of filtered data compressed by one task: big enough for
+    // the restarts of the blocks between bands to cost nothing
+    const std::size_t bandSize = 256 * 1024;
+
+    // Largest prime below 65536, modulo of the Adler-32 checksum
+    const sf::Uint32 adlerBase = 65521;
+
+    // Number of previous positions to try, and length of match to settle for, at each compression level
+    const unsigned int maxChains[10]   = {0, 4, 8, 16, 32, 64, 128, 256, 1024, 4096};
+    const std::size_t  niceLengths[10] = {0, 16, 32, 64, 64, 128, 128, 258, 258, 258};
+
+    // Base value and number of extra bits of each length and distance symbol
+    const unsigned int lengthBases[29]    = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    const unsigned int lengthExtras[29]   = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    const unsigned int distanceBases[30]  = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    const unsigned int distanceExtras[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    // Reverse the bits of a Huffman code, since deflate writes
+    // codes starting from their most significant bit
+    unsigned int reverseBits(unsigned int code, unsigned int count)
+    {
+        unsigned int reversed = 0;
+        for (unsigned int i = 0; i < count; ++i, code >>= 1)
+            reversed = (reversed << 1) | (code & 1);
+        return reversed;
+    }
+
+    // Lookup tables of the encoder, built once at startup
+    struct Tables
+    {
+        Tables()
+        {
+            // CRC-32 of the chunks
+            for (sf::Uint32 n = 0; n < 256; ++n)
+            {
+                sf::Uint32 c = n;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+                crc[n] = c;
+            }
+
+            // Fixed Huffman codes of the literal/length alphabet
+            for (unsigned int symbol = 0; symbol < 288; ++symbol)
+            {
+                unsigned int code;
+                unsigned int length;
+                if (symbol < 144)      {code = 0x30 + symbol;        length = 8;}
+                else if (symbol < 256) {code = 0x190 + symbol - 144; length = 9;}
+                else if (symbol < 280) {code = symbol - 256;         length = 7;}
+                else                   {code = 0xC0 + symbol - 280;  length = 8;}
+
+                literalCodes[symbol]   = static_cast<sf::Uint16>(reverseBits(code, length));
+                literalLengths[symbol] = static_cast<sf::Uint8>(length);
+            }
+
+            // Symbol of every match length (258 has its own symbol)
+            for (unsigned int symbol = 0; symbol < 29; ++symbol)
+            {
+                for (unsigned int i = 0; (i < (1u << lengthExtras[symbol])) && (lengthBases[symbol] + i <= maxMatchLength); ++i)
+                    lengthSymbols[lengthBases[symbol] + i - 3] = static_cast<sf::Uint8>(symbol);
+            }
+
+            // Symbol of every distance; distances above 256 are looked up by
+            // steps of 128, since all their symbols start on such a step
+            for (unsigned int symbol = 0; symbol < 30; ++symbol)
+            {
+                for (unsigned int i = 0; i < (1u << distanceExtras[symbol]); ++i)
+                {
+                    unsigned int distance = distanceBases[symbol] + i - 1;
+                    distanceSymbols[distance < 256 ? distance : 256 + (distance >> 7)] = static_cast<sf::Uint8>(symbol);
+                }
+
+                distanceCodes[symbol] = static_cast<sf::Uint8>(reverseBits(symbol, 5));
+            }
+        }
+
+        sf::Uint32 crc[256];             // CRC-32 of every byte value
+        sf::Uint16 literalCodes[288];    // Fixed codes of the literal/length symbols, bit-reversed
+        sf::Uint8  literalLengths[288];  // Number of bits of the literal/length codes
+        sf::Uint8  lengthSymbols[256];   // Length symbol of every match length minus 3
+        sf::Uint8  distanceSymbols[512]; // Distance symbol of every distance minus 1
+        sf::Uint8  distanceCodes[30];    // Fixed codes of the distance symbols, bit-reversed
+    };
+    const Tables tables;
+
+    // Store a 32-bit value in big-endian order
+    void storeBigEndian(sf::Uint8* bytes, sf::Uint32 value)
+    {
+        bytes[0] = static_cast<sf::Uint8>(value >> 24);
+        bytes[1] = static_cast<sf::Uint8>(value >> 16);
+        bytes[2] = static_cast<sf::Uint8>(value >> 8);
+        bytes[3] = static_cast<sf::Uint8>(value);
+    }
+
+    // Update a CRC-32 with a block of data
+    sf::Uint32 updateCrc(sf::Uint32 crc, const sf::Uint8* data, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            crc = tables.crc[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return crc;
+    }
+
+    // Compute the CRC-32 of a chunk, which covers its type and data
+    sf::Uint32 getChunkCrc(const char* type, const sf::Uint8* data, std::size_t size)
+    {
+        sf::Uint32 crc = updateCrc(0xFFFFFFFF, reinterpret_cast<const sf::Uint8*>(type), 4);
+        return updateCrc(crc, data, size) ^ 0xFFFFFFFF;
+    }
+
+    // Compute the Adler-32 checksum of a block of data
+    sf::Uint32 computeAdler(const sf::Uint8* data, std::size_t size)
+    {
+        sf::Uint32 a = 1;
+        sf::Uint32 b = 0;
+        while (size > 0)
+        {
+            // 5552 is the largest run of bytes that can't overflow b
+            std::size_t count = std::min<std::size_t>(size, 5552);
+            size -= count;
+            for (; count > 0; --count)
+            {
+                a += *data++;
+                b += a;
+            }
+            a %= adlerBase;
+            b %= adlerBase;
+        }
+
+        return (b << 16) | a;
+    }
+
+    // Compute the Adler-32 checksum of two consecutive blocks from their own checksums
+    sf::Uint32 combineAdler(sf::Uint32 first, sf::Uint32 second, std::size_t secondSize)
+    {
+        sf::Uint32 remainder = static_cast<sf::Uint32>(secondSize % adlerBase);
+        sf::Uint32 a = first & 0xFFFF;
+        sf::Uint32 b = (remainder * a) % adlerBase;
+        a += (second & 0xFFFF) + adlerBase - 1;
+        b += (first >> 16) + (second >> 16) + adlerBase - remainder;
+        if (a >= adlerBase)
+            a -= adlerBase;
+        if (a >= adlerBase)
+            a -= adlerBase;
+        if (b >= adlerBase * 2)
+            b -= adlerBase * 2;
+        if (b >= adlerBase)
+            b -= adlerBase;
+
+        return (b << 16) | a;
+    }
+
+    // Write a chunk to a PNG file
+    bool writeChunk(std::FILE* file, const char* type, const sf::Uint8* data, std::size_t size, sf::Uint32 crc)
+    {
+        sf::Uint8 length[4];
+        sf::Uint8 checksum[4];
+        storeBigEndian(length, static_cast<sf::Uint32>(size));
+        storeBigEndian(checksum, crc);
+
+        return (std::fwrite(length, 1, 4, file) == 4) &&
+               (std::fwrite(type, 1, 4, file) == 4) &&
+               ((size == 0) || (std::fwrite(data, 1, size, file) == size)) &&
+               (std::fwrite(checksum, 1, 4, file) == 4);
+    }
+
+    // Predictor of the Paeth filter, with the distances of p = a + b - c
+    // to a, b and c simplified
+    int paeth(int a, int b, int c)
+    {
+        int pa = std::abs(b - c);
+        int pb = std::abs(a - c);
+        int pc = std::abs(a + b - 2 * c);
+        if ((pa <= pb) && (pa <= pc))
+            return a;
+        return (pb <= pc) ? b : c;
+    }
+
+    // Absolute value of a filtered byte, seen as a signed value
+    sf::Uint8 getMagnitude(sf::Uint8 value)
+    {
+        return std::min(value, static_cast<sf::Uint8>(-value));
+    }
+
+    // Apply one of the 5 PNG filters to a row of RGBA pixels, and return
+    // the sum of the absolute values of the filtered bytes
+    std::size_t filterRow(int type, const sf::Uint8* row, const sf::Uint8* above, sf::Uint8* output, std::size_t size)
+    {
+        std::size_t cost = 0;
+        switch (type)
+        {
+            case 0: // None
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    output[i] = row[i];
+                    cost += getMagnitude(output[i]);
+                }
+                break;
+
+            case 1: // Sub
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    output[i] = static_cast<sf::Uint8>(row[i] - (i >= 4 ? row[i - 4] : 0));
+                    cost += getMagnitude(output[i]);
+                }
+                break;
+
+            case 2: // Up
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    output[i] = static_cast<sf::Uint8>(row[i] - above[i]);
+                    cost += getMagnitude(output[i]);
+                }
+                break;
+
+            case 3: // Average
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    output[i] = static_cast<sf::Uint8>(row[i] - (((i >= 4 ? row[i - 4] : 0) + above[i]) >> 1));
+                    cost += getMagnitude(output[i]);
+                }
+                break;
+
+            default: // Paeth
+                for (std::size_t i = 0; i < 4; ++i)
+                {
+                    output[i] = static_cast<sf::Uint8>(row[i] - above[i]);
+                    cost += getMagnitude(output[i]);
+                }
+                for (std::size_t i = 4; i < size; ++i)
+                {
+                    output[i] = static_cast<sf::Uint8>(row[i] - paeth(row[i - 4], above[i], above[i - 4]));
+                    cost += getMagnitude(output[i]);
+                }
+                break;
+        }
+
+        return cost;
+    }
+
+    // Filter the rows of an image, each one prefixed with its filter type
+    struct FilterRows
+    {
+        void operator()(std::size_t begin, std::size_t end)
+        {
+            std::vector<sf::Uint8> buffers(rowSize * 2);
+            for (std::size_t y = begin; y < end; ++y)
+            {
+                const sf::Uint8* row   = pixels + y * rowSize;
+                const sf::Uint8* above = (y > 0) ? row - rowSize : zeros;
+                sf::Uint8*       out   = output + y * (rowSize + 1);
+
+                // Uncompressed rows don't need to be filtered
+                if (!adaptive)
+                {
+                    out[0] = 0;
+                    std::memcpy(out + 1, row, rowSize);
+                    continue;
+                }
+
+                // Keep the filter that gives the lowest sum of the absolute
+                // values of the filtered bytes, the heuristic of libpng
+                sf::Uint8*  best      = &buffers[0];
+                sf::Uint8*  candidate = &buffers[rowSize];
+                std::size_t bestCost  = 0;
+                for (int type = 0; type < 5; ++type)
+                {
+                    std::size_t cost = filterRow(type, row, above, candidate, rowSize);
+                    if ((type == 0) || (cost < bestCost))
+                    {
+                        bestCost = cost;
+                        out[0] = static_cast<sf::Uint8>(type);
+                        std::swap(best, candidate);
+                    }
+                }
+
+                std::memcpy(out + 1, best, rowSize);
+            }
+        }
+
+        const sf::Uint8* pixels;   // Pixels of the image
+        const sf::Uint8* zeros;    // Row of zeros, above the first row
+        sf::Uint8*       output;   // Filtered rows
+        std::size_t      rowSize;  // Size of a row of pixels, in bytes
+        bool             adaptive; // Pick the best filter of each row?
+    };
+
+    // Writes the bits of a deflate stream, least significant first
+    class BitWriter
+    {
+    public:
+
+        explicit BitWriter(std::vector<sf::Uint8>& output) :
+        m_output(output),
+        m_bits  (0),
+        m_count (0)
+        {
+        }
+
+        void write(sf::Uint32 bits, unsigned int count)
+        {
+            m_bits |= bits << m_count;
+            m_count += count;
+            while (m_count >= 8)
+            {
+                m_output.push_back(static_cast<sf::Uint8>(m_bits));
+                m_bits >>= 8;
+                m_count -= 8;
+            }
+        }
+
+        void align()
+        {
+            if (m_count > 0)
+                write(0, 8 - m_count);
+        }
+
+    private:
+
+        std::vector<sf::Uint8>& m_output; // Stream to write to
+        sf::Uint32              m_bits;   // Bits not written yet
+        unsigned int            m_count;  // Number of bits not written yet
+    };
+
+    // Store a band in uncompressed blocks
+    void storeBand(const sf::Uint8* data, std::size_t size, bool last, std::vector<sf::Uint8>& output)
+    {
+        do
+        {
+            std::size_t length = std::min<std::size_t>(size, 65535);
+            size -= length;
+
+            output.push_back((last && (size == 0)) ? 1 : 0);
+            output.push_back(static_cast<sf::Uint8>(length));
+            output.push_back(static_cast<sf::Uint8>(length >> 8));
+            output.push_back(static_cast<sf::Uint8>(~length));
+            output.push_back(static_cast<sf::Uint8>(~length >> 8));
+            output.insert(output.end(), data, data + length);
+            data += length;
+        }
+        while (size > 0);
+    }
+
+    // Compress the filtered rows of an image, in bands processed in parallel
+    struct CompressBands
+    {
+        void operator()(std::size_t begin, std::size_t end)
+        {
+            std::vector<int> head(1 << hashBits);
+            std::vector<int> previous(windowSize);
+
+            for (std::size_t band = begin; band < end; ++band)
+            {
+                const std::size_t start = band * bandBytes;
+                const std::size_t stop  = std::min(start + bandBytes, dataSize);
+                const bool        last  = (band + 1 == bandCount);
+
+                std::vector<sf::Uint8>& output = outputs[band];
+                output.reserve((stop - start) / 2);
+
+                // The zlib header goes at the beginning of the first band
+                if (band == 0)
+                {
+                    output.push_back(0x78);
+                    output.push_back(level < 2 ? 0x01 : level < 6 ? 0x5E : level == 6 ? 0x9C : 0xDA);
+                }
+
+                if (level == 0)
+                {
+                    storeBand(data + start, stop - start, last, output);
+                }
+                else
+                {
+                    std::fill(head.begin(), head.end(), -1);
+                    deflateBand(start, stop, last, head, previous, output);
+                }
+
+                adlers[band] = computeAdler(data + start, stop - start);
+                crcs[band] = getChunkCrc("IDAT", &output[0], output.size());
+            }
+        }
+
+        // Deflate a band with the fixed Huffman codes. The match finder
+        // starts with the end of the previous band as its dictionary, and
+        // a band that isn't the last one is terminated by an empty stored
+        // block, which aligns it on a byte so the next band can follow it
+        void deflateBand(std::size_t start, std::size_t stop, bool last, std::vector<int>& head, std::vector<int>& previous, std::vector<sf::Uint8>& output) const
+        {
+            // Work with positions relative to the start of the dictionary
+            const std::size_t origin = start - std::min(start, windowSize);
+            const sf::Uint8*  bytes  = data + origin;
+            start -= origin;
+            stop  -= origin;
+
+            // Higher levels search longer chains of previous positions
+            const unsigned int maxChain   = maxChains[level];
+            const std::size_t  niceLength = niceLengths[level];
+
+            for (std::size_t position = 0; (position < start) && (position + 3 <= stop); ++position)
+                insert(bytes, position, head, previous);
+
+            BitWriter writer(output);
+            writer.write(last ? 1 : 0, 1);
+            writer.write(1, 2);
+
+            std::size_t position = start;
+            while (position < stop)
+            {
+                const sf::Uint8* current = bytes + position;
+
+                // Find the longest match among the previous positions with the same hash
+                std::size_t bestLength   = 0;
+                std::size_t bestDistance = 0;
+                if (position + 3 <= stop)
+                {
+                    const std::size_t maxLength = std::min(maxMatchLength, stop - position);
+                    unsigned int chain = maxChain;
+                    for (int candidate = head[hash(current)]; (candidate >= 0) && (chain > 0); candidate = previous[candidate & (windowSize - 1)], --chain)
+                    {
+                        const std::size_t distance = position - candidate;
+                        if (distance > windowSize)
+                            break;
+
+                        const sf::Uint8* match = bytes + candidate;
+                        if (match[bestLength] != current[bestLength])
+                            continue;
+
+                        std::size_t length = 0;
+                        while ((length < maxLength) && (match[length] == current[length]))
+                            ++length;
+
+                        if (length > bestLength)
+                        {
+                            bestLength   = length;
+                            bestDistance = distance;
+                            if ((length >= niceLength) || (length == maxLength))
+                                break;
+                        }
+                    }
+                }
+
+                // Distant 3-byte matches take more bits than the literals they replace
+                if ((bestLength > 3) || ((bestLength == 3) && (bestDistance <= 4096)))
+                {
+                    const unsigned int lengthSymbol = tables.lengthSymbols[bestLength - 3];
+                    writer.write(tables.literalCodes[257 + lengthSymbol], tables.literalLengths[257 + lengthSymbol]);
+                    writer.write(static_cast<sf::Uint32>(bestLength - lengthBases[lengthSymbol]), lengthExtras[lengthSymbol]);
+
+                    const std::size_t  distanceIndex  = bestDistance - 1;
+                    const unsigned int distanceSymbol = tables.distanceSymbols[distanceIndex < 256 ? distanceIndex : 256 + (distanceIndex >> 7)];
+                    writer.write(tables.distanceCodes[distanceSymbol], 5);
+                    writer.write(static_cast<sf::Uint32>(bestDistance - distanceBases[distanceSymbol]), distanceExtras[distanceSymbol]);
+
+                    for (const std::size_t next = position + bestLength; position < next; ++position)
+                    {
+                        if (position + 3 <= stop)
+                            insert(bytes, position, head, previous);
+                    }
+                }
+                else
+                {
+                    writer.write(tables.literalCodes[*current], tables.literalLengths[*current]);
+
+                    if (position + 3 <= stop)
+                        insert(bytes, position, head, previous);
+                    ++position;
+                }
+            }
+
+            // End of block
+            writer.write(tables.literalCodes[256], tables.literalLengths[256]);
+
+            if (!last)
+            {
+                writer.write(0, 3);
+                writer.align();
+                output.push_back(0x00);
+                output.push_back(0x00);
+                output.push_back(0xFF);
+                output.push_back(0xFF);
+            }
+            else
+            {
+                writer.align();
+            }
+        }
+
+        // Hash the next 3 bytes
+        static unsigned int hash(const sf::Uint8* bytes)
+        {
+            sf::Uint32 value = (static_cast<sf::Uint32>(bytes[0]) << 16) | (static_cast<sf::Uint32>(bytes[1]) << 8) | bytes[2];
+            return (value * 2654435761u) >> (32 - hashBits);
+        }
+
+        // Add a position to the chain of its hash
+        static void insert(const sf::Uint8* bytes, std::size_t position, std::vector<int>& head, std::vector<int>& previous)
+        {
+            unsigned int key = hash(bytes + position);
+            previous[position & (windowSize - 1)] = head[key];
+            head[key] = static_cast<int>(position);
+        }
+
+        const sf::Uint8*        data;      // Filtered rows
+        std::size_t             dataSize;  // Size of the filtered rows, in bytes
+        std::size_t             bandBytes; // Size of a band, in bytes
+        std::size_t             bandCount; // Number of bands
+        unsigned int            level;     // Compression level
+        std::vector<sf::Uint8>* outputs;   // Compressed data of every band
+        sf::Uint32*             adlers;    // Adler-32 of the filtered data of every band
+        sf::Uint32*             crcs;      // CRC-32 of the chunk of every band
+    };
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool writePng(const std::string& filename, const Uint8* pixels, const Vector2u& size, unsigned int compressionLevel, unsigned int threadCount)
+{
+    const unsigned int level   = std::min(compressionLevel, 9u);
+    const std::size_t  rowSize = static_cast<std::size_t>(size.x) * 4;
+    const std::size_t  stride  = rowSize + 1;
+
+    // Bands are made of whole rows
+    const std::size_t rowsPerBand = std::max<std::size_t>(bandSize / stride, 1);
+    const std::size_t bandCount   = (size.y + rowsPerBand - 1) / rowsPerBand;
+
+    // Filter the rows
+    std::vector<Uint8> filtered(stride * size.y);
+    std::vector<Uint8> zeros(rowSize, 0);
+
+    FilterRows filter;
+    filter.pixels   = pixels;
+    filter.zeros    = &zeros[0];
+    filter.output   = &filtered[0];
+    filter.rowSize  = rowSize;
+    filter.adaptive = (level > 0);
+    parallelFor(size.y, rowsPerBand, threadCount, filter);
+
+    // Compress the bands
+    std::vector<std::vector<Uint8> > outputs(bandCount);
+    std::vector<Uint32> adlers(bandCount);
+    std::vector<Uint32> crcs(bandCount);
+
+    CompressBands compress;
+    compress.data      = &filtered[0];
+    compress.dataSize  = filtered.size();
+    compress.bandBytes = rowsPerBand * stride;
+    compress.bandCount = bandCount;
+    compress.level     = level;
+    compress.outputs   = &outputs[0];
+    compress.adlers    = &adlers[0];
+    compress.crcs      = &crcs[0];
+    parallelFor(bandCount, 1, threadCount, compress);
+
+    // Combine the checksums of the bands into the one of the zlib stream
+    Uint32 adler = adlers[0];
+    for (std::size_t band = 1; band < bandCount; ++band)
+    {
+        std::size_t bandLength = std::min(compress.bandBytes, filtered.size() - band * compress.bandBytes);
+        adler = combineAdler(adler, adlers[band], bandLength);
+    }
+
+    Uint8 header[13];
+    storeBigEndian(header, size.x);
+    storeBigEndian(header + 4, size.y);
+    header[8]  = 8; // Bits per component
+    header[9]  = 6; // RGBA
+    header[10] = 0; // Deflate compression
+    header[11] = 0; // Adaptive filtering
+    header[12] = 0; // No interlacing
+
+    Uint8 checksum[4];
+    storeBigEndian(checksum, adler);
+
+    // Write the file, with one chunk per band
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file)
+        return false;
+
+    static const Uint8 signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    bool success = (std::fwrite(signature, 1, 8, file) == 8) &&
+                   writeChunk(file, "IHDR", header, 13, getChunkCrc("IHDR", header, 13));
+
+    for (std::size_t band = 0; success && (band < bandCount); ++band)
+        success = writeChunk(file, "IDAT", &outputs[band][0], outputs[band].size(), crcs[band]);
+
+    success = success &&
+              writeChunk(file, "IDAT", checksum, 4, getChunkCrc("IDAT", checksum, 4)) &&
+              writeChunk(file, "IEND", NULL, 0, getChunkCrc("IEND", NULL, 0));
+
+    return (std::fclose(file) == 0) && success;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PNGENCODER_HPP
+#define SFML_PNGENCODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Save an array of RGBA pixels as a PNG file
+///
+/// The image is split in bands of rows that are filtered and
+/// deflated independently, on several threads. Each band
+/// starts with the dictionary of the end of the previous one
+/// and ends on a byte boundary, so the bands concatenate to a
+/// single zlib stream; the file is the same whatever the
+/// number of threads.
+///
+/// Level 0 stores the rows without filtering or compressing
+/// them. Levels 1 to 9 pick the best filter of each row and
+/// search longer chains of previous matches as they increase.
+///
+/// \param filename         Path of the file to save
+/// \param pixels           Array of pixels to save
+/// \param size             Size of the image, in pixels
+/// \param compressionLevel Compression level, from 0 to 9
+/// \param threadCount      Maximum number of threads to use, 0 for one per processor
+///
+/// \return True if saving was successful
+///
+////////////////////////////////////////////////////////////
+bool writePng(const std::string& filename, const Uint8* pixels, const Vector2u& size, unsigned int compressionLevel, unsigned int threadCount);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PNGENCODER_HPP
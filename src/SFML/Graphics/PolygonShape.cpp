@@ -0,0 +1,641 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PolygonShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+
+
+namespace
+{
+    // The triangulation follows the classic approach (de Berg et al., "Computational
+    // Geometry", chapter 3): a sweep line going down splits the polygon into y-monotone
+    // pieces by adding diagonals, then each piece is triangulated in linear time.
+    // Points are ordered from top (largest y) to bottom, ties broken by smaller x first;
+    // boundaries are oriented so that the interior is always on the left of each edge.
+
+    typedef std::size_t Index;
+
+    const Index none = static_cast<Index>(-1);
+
+    enum VertexType
+    {
+        StartVertex,
+        EndVertex,
+        SplitVertex,
+        MergeVertex,
+        RegularVertex
+    };
+
+    // Is a above b in the sweep order?
+    bool isAbove(const sf::Vector2f& a, const sf::Vector2f& b)
+    {
+        return (a.y > b.y) || ((a.y == b.y) && (a.x < b.x));
+    }
+
+    // Cross product of (b - a) and (c - b), positive when a, b, c make a left turn
+    float turn(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c)
+    {
+        return (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+    }
+
+    // Sort points by sweep order
+    struct SweepOrder
+    {
+        bool operator()(Index left, Index right) const
+        {
+            return isAbove(points[left], points[right]);
+        }
+
+        const sf::Vector2f* points;
+    };
+
+    // Order of the edges crossed by the sweep line, from left to right. An edge is
+    // identified by the index of its upper point; the special index "none" stands
+    // for the current sweep point itself, to look up the edge on its left
+    struct EdgeOrder
+    {
+        float getX(Index edge) const
+        {
+            if (edge == none)
+                return sweep->x;
+
+            const sf::Vector2f& a = points[edge];
+            const sf::Vector2f& b = points[next[edge]];
+            if (a.y == b.y)
+                return std::min(std::max(sweep->x, std::min(a.x, b.x)), std::max(a.x, b.x));
+
+            return a.x + (sweep->y - a.y) * (b.x - a.x) / (b.y - a.y);
+        }
+
+        bool operator()(Index left, Index right) const
+        {
+            float leftX = getX(left);
+            float rightX = getX(right);
+            if (leftX != rightX)
+                return leftX < rightX;
+
+            // Degenerate case: put the sweep point before the edges going through it
+            if ((left == none) || (right == none))
+                return (left == none) && (right != none);
+
+            return left < right;
+        }
+
+        const sf::Vector2f* points;
+        const Index*        next;
+        const sf::Vector2f* sweep;
+    };
+
+    // Append a triangle, with its points in counter-clockwise order so that all the triangles have the same winding
+    void addTriangle(std::vector<unsigned int>& triangles, const std::vector<sf::Vector2f>& points, Index a, Index b, Index c)
+    {
+        if (turn(points[a], points[b], points[c]) < 0)
+            std::swap(b, c);
+
+        triangles.push_back(static_cast<unsigned int>(a));
+        triangles.push_back(static_cast<unsigned int>(b));
+        triangles.push_back(static_cast<unsigned int>(c));
+    }
+
+    // Triangulate a y-monotone polygon whose points are given counter-clockwise
+    void triangulateMonotone(const std::vector<Index>& face, const std::vector<sf::Vector2f>& points, std::vector<unsigned int>& triangles)
+    {
+        std::size_t count = face.size();
+        if (count < 3)
+            return;
+
+        // Find the top and bottom points; going counter-clockwise
+        // from the top leads down the left chain to the bottom
+        std::size_t top = 0;
+        std::size_t bottom = 0;
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            if (isAbove(points[face[i]], points[face[top]]))
+                top = i;
+            if (isAbove(points[face[bottom]], points[face[i]]))
+                bottom = i;
+        }
+
+        std::vector<bool> onLeftChain(count, false);
+        for (std::size_t i = top; i != bottom; i = (i + 1) % count)
+            onLeftChain[i] = true;
+
+        // Merge the two chains in sweep order
+        std::vector<Index> order(count);
+        std::vector<sf::Vector2f> facePoints(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            order[i] = i;
+            facePoints[i] = points[face[i]];
+        }
+        SweepOrder sweepOrder = {&facePoints[0]};
+        std::sort(order.begin(), order.end(), sweepOrder);
+
+        // Cut triangles from the top, keeping the part that
+        // can't be triangulated yet on a stack
+        std::vector<Index> stack;
+        stack.push_back(order[0]);
+        stack.push_back(order[1]);
+
+        for (std::size_t j = 2; j < count - 1; ++j)
+        {
+            Index current = order[j];
+
+            if (onLeftChain[current] != onLeftChain[stack.back()])
+            {
+                // Opposite chain: the current point sees all the points of the stack
+                for (std::size_t k = stack.size() - 1; k > 0; --k)
+                {
+                    addTriangle(triangles, points, face[current], face[stack[k]], face[stack[k - 1]]);
+                }
+
+                stack.clear();
+                stack.push_back(order[j - 1]);
+                stack.push_back(current);
+            }
+            else
+            {
+                // Same chain: cut triangles as long as the diagonals stay inside
+                Index last = stack.back();
+                stack.pop_back();
+
+                while (!stack.empty())
+                {
+                    float direction = turn(facePoints[stack.back()], facePoints[last], facePoints[current]);
+                    if (onLeftChain[current] ? (direction <= 0) : (direction >= 0))
+                        break;
+
+                    addTriangle(triangles, points, face[current], face[last], face[stack.back()]);
+
+                    last = stack.back();
+                    stack.pop_back();
+                }
+
+                stack.push_back(last);
+                stack.push_back(current);
+            }
+        }
+
+        // The bottom point sees all the remaining points
+        Index current = order[count - 1];
+        for (std::size_t k = stack.size() - 1; k > 0; --k)
+        {
+            addTriangle(triangles, points, face[current], face[stack[k]], face[stack[k - 1]]);
+        }
+    }
+
+    // Gather the outer boundary and the holes in a single array
+    void gatherContours(const std::vector<sf::Vector2f>& boundary, const std::vector<std::vector<sf::Vector2f> >& holes,
+                        std::vector<sf::Vector2f>& points, std::vector<std::size_t>& contourSizes)
+    {
+        points = boundary;
+        contourSizes.assign(1, boundary.size());
+        for (std::vector<std::vector<sf::Vector2f> >::const_iterator it = holes.begin(); it != holes.end(); ++it)
+        {
+            points.insert(points.end(), it->begin(), it->end());
+            contourSizes.push_back(it->size());
+        }
+    }
+
+    // Triangulate a polygon made of consecutive contours (the outer boundary first, then the holes)
+    void triangulate(const std::vector<sf::Vector2f>& points, const std::vector<std::size_t>& contourSizes, std::vector<unsigned int>& triangles)
+    {
+        triangles.clear();
+
+        // Link the points of each contour, reversing the holes and the
+        // outer boundary as needed so that the interior is on the left
+        std::vector<Index> next(points.size(), none);
+        std::vector<Index> previous(points.size(), none);
+        std::vector<Index> events;
+        events.reserve(points.size());
+
+        Index first = 0;
+        for (std::size_t c = 0; c < contourSizes.size(); first += contourSizes[c], ++c)
+        {
+            std::size_t size = contourSizes[c];
+            if (size < 3)
+                continue;
+
+            float area = 0;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const sf::Vector2f& a = points[first + i];
+                const sf::Vector2f& b = points[first + (i + 1) % size];
+                area += a.x * b.y - b.x * a.y;
+            }
+
+            if (area == 0)
+            {
+                // A flat outer boundary has no interior at all
+                if (c == 0)
+                    return;
+                continue;
+            }
+
+            bool forward = (c == 0) ? (area > 0) : (area < 0);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                Index after = first + (i + 1) % size;
+                Index before = first + (i + size - 1) % size;
+                next[first + i] = forward ? after : before;
+                previous[first + i] = forward ? before : after;
+                events.push_back(first + i);
+            }
+        }
+
+        if (events.empty())
+            return;
+
+        SweepOrder sweepOrder = {&points[0]};
+        std::sort(events.begin(), events.end(), sweepOrder);
+
+        // Sweep the points from top to bottom, adding the diagonals
+        // that remove split and merge vertices
+        typedef std::set<Index, EdgeOrder> Status;
+
+        sf::Vector2f sweep;
+        EdgeOrder edgeOrder = {&points[0], &next[0], &sweep};
+        Status status(edgeOrder);
+        std::vector<Status::iterator> edges(points.size(), status.end());
+        std::vector<Index> helpers(points.size(), none);
+        std::vector<VertexType> types(points.size(), RegularVertex);
+        std::vector<std::pair<Index, Index> > diagonals;
+
+        for (std::vector<Index>::const_iterator it = events.begin(); it != events.end(); ++it)
+        {
+            Index v = *it;
+            Index before = previous[v];
+            Index after = next[v];
+            sweep = points[v];
+
+            bool beforeIsAbove = isAbove(points[before], sweep);
+            bool afterIsAbove = isAbove(points[after], sweep);
+            bool convex = turn(points[before], sweep, points[after]) > 0;
+
+            VertexType type = RegularVertex;
+            if (!beforeIsAbove && !afterIsAbove)
+                type = convex ? StartVertex : SplitVertex;
+            else if (beforeIsAbove && afterIsAbove)
+                type = convex ? EndVertex : MergeVertex;
+            types[v] = type;
+
+            // Remove the edge ending here, if any
+            if ((type == EndVertex) || (type == MergeVertex) || ((type == RegularVertex) && beforeIsAbove))
+            {
+                Index helper = helpers[before];
+                if ((helper != none) && (types[helper] == MergeVertex))
+                    diagonals.push_back(std::make_pair(v, helper));
+
+                if (edges[before] != status.end())
+                {
+                    status.erase(edges[before]);
+                    edges[before] = status.end();
+                }
+            }
+
+            // Connect to the helper of the edge on the left, if needed
+            if ((type == SplitVertex) || (type == MergeVertex) || ((type == RegularVertex) && !beforeIsAbove))
+            {
+                Status::iterator left = status.lower_bound(none);
+                if (left != status.begin())
+                {
+                    --left;
+                    Index helper = helpers[*left];
+                    if ((type == SplitVertex) || ((helper != none) && (types[helper] == MergeVertex)))
+                        diagonals.push_back(std::make_pair(v, helper));
+                    helpers[*left] = v;
+                }
+            }
+
+            // Insert the edge starting here, if any
+            if ((type == StartVertex) || (type == SplitVertex) || ((type == RegularVertex) && beforeIsAbove))
+            {
+                edges[v] = status.insert(v).first;
+                helpers[v] = v;
+            }
+        }
+
+        // Build the list of outgoing edges of each point: its edge along
+        // the boundary plus both directions of every diagonal
+        std::vector<std::vector<Index> > outgoing(points.size());
+        for (std::vector<Index>::const_iterator it = events.begin(); it != events.end(); ++it)
+            outgoing[*it].push_back(next[*it]);
+        for (std::vector<std::pair<Index, Index> >::const_iterator it = diagonals.begin(); it != diagonals.end(); ++it)
+        {
+            outgoing[it->first].push_back(it->second);
+            outgoing[it->second].push_back(it->first);
+        }
+
+        // Walk around each monotone piece, always taking the next outgoing
+        // edge clockwise from the edge we arrived from, and triangulate it
+        static const double twoPi = 6.283185307179586;
+
+        std::vector<std::vector<bool> > visited(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+            visited[i].resize(outgoing[i].size(), false);
+
+        std::vector<Index> face;
+        for (std::vector<Index>::const_iterator it = events.begin(); it != events.end(); ++it)
+        {
+            for (std::size_t edge = 0; edge < outgoing[*it].size(); ++edge)
+            {
+                face.clear();
+
+                Index from = *it;
+                std::size_t slot = edge;
+                while (!visited[from][slot])
+                {
+                    visited[from][slot] = true;
+                    face.push_back(from);
+
+                    Index to = outgoing[from][slot];
+                    double back = std::atan2(points[from].y - points[to].y, points[from].x - points[to].x);
+
+                    double bestAngle = twoPi + 1;
+                    for (std::size_t i = 0; i < outgoing[to].size(); ++i)
+                    {
+                        const sf::Vector2f& target = points[outgoing[to][i]];
+                        double angle = back - std::atan2(target.y - points[to].y, target.x - points[to].x);
+                        while (angle <= 0)
+                            angle += twoPi;
+                        if (angle < bestAngle)
+                        {
+                            bestAngle = angle;
+                            slot = i;
+                        }
+                    }
+
+                    from = to;
+                }
+
+                triangulateMonotone(face, points, triangles);
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PolygonShape::PolygonShape(std::size_t pointCount) :
+m_points                 (pointCount),
+m_holes                  (),
+m_texture                (NULL),
+m_textureRect            (),
+m_fillColor              (255, 255, 255),
+m_triangles              (),
+m_vertices               (Triangles),
+m_bounds                 (),
+m_triangulationNeedUpdate(true),
+m_geometryNeedUpdate     (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setPointCount(std::size_t count)
+{
+    m_points.resize(count);
+    m_triangulationNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PolygonShape::getPointCount() const
+{
+    return m_points.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setPoint(std::size_t index, const Vector2f& point)
+{
+    m_points[index] = point;
+    m_triangulationNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f PolygonShape::getPoint(std::size_t index) const
+{
+    return m_points[index];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PolygonShape::addHole(const std::vector<Vector2f>& points)
+{
+    m_holes.push_back(points);
+    m_triangulationNeedUpdate = true;
+
+    return m_holes.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PolygonShape::getHoleCount() const
+{
+    return m_holes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Vector2f>& PolygonShape::getHole(std::size_t index) const
+{
+    return m_holes[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::clearHoles()
+{
+    m_holes.clear();
+    m_triangulationNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<unsigned int>& PolygonShape::getTriangles() const
+{
+    ensureTriangulation();
+
+    return m_triangles;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setTexture(const Texture* texture, bool resetRect)
+{
+    if (texture)
+    {
+        // Recompute the texture area if requested, or if there was no texture & rect before
+        if (resetRect || (!m_texture && (m_textureRect == IntRect())))
+            setTextureRect(IntRect(0, 0, texture->getSize().x, texture->getSize().y));
+    }
+
+    // Assign the new texture
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setTextureRect(const IntRect& rect)
+{
+    m_textureRect = rect;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setFillColor(const Color& color)
+{
+    m_fillColor = color;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* PolygonShape::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& PolygonShape::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& PolygonShape::getFillColor() const
+{
+    return m_fillColor;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect PolygonShape::getLocalBounds() const
+{
+    ensureGeometryUpdate();
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect PolygonShape::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::draw(RenderTarget& target, RenderStates states) const
+{
+    ensureGeometryUpdate();
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    target.draw(m_vertices, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::ensureTriangulation() const
+{
+    if (!m_triangulationNeedUpdate)
+        return;
+
+    std::vector<Vector2f> points;
+    std::vector<std::size_t> contourSizes;
+    gatherContours(m_points, m_holes, points, contourSizes);
+
+    triangulate(points, contourSizes, m_triangles);
+
+    m_triangulationNeedUpdate = false;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::ensureGeometryUpdate() const
+{
+    ensureTriangulation();
+
+    if (!m_geometryNeedUpdate)
+        return;
+
+    m_geometryNeedUpdate = false;
+    m_vertices.clear();
+    m_bounds = FloatRect();
+
+    if (m_points.empty())
+        return;
+
+    // Compute the bounding rectangle of the outer boundary
+    float left   = m_points[0].x;
+    float top    = m_points[0].y;
+    float right  = m_points[0].x;
+    float bottom = m_points[0].y;
+    for (std::size_t i = 1; i < m_points.size(); ++i)
+    {
+        left   = std::min(left, m_points[i].x);
+        top    = std::min(top, m_points[i].y);
+        right  = std::max(right, m_points[i].x);
+        bottom = std::max(bottom, m_points[i].y);
+    }
+    m_bounds = FloatRect(left, top, right - left, bottom - top);
+
+    // Expand the indexed triangles, mapping the texture on the bounding rectangle
+    std::vector<Vector2f> points;
+    std::vector<std::size_t> contourSizes;
+    gatherContours(m_points, m_holes, points, contourSizes);
+
+    m_vertices.resize(m_triangles.size());
+    for (std::size_t i = 0; i < m_triangles.size(); ++i)
+    {
+        Vertex& vertex = m_vertices[i];
+        vertex.position = points[m_triangles[i]];
+        vertex.color = m_fillColor;
+
+        float xratio = m_bounds.width > 0 ? (vertex.position.x - m_bounds.left) / m_bounds.width : 0;
+        float yratio = m_bounds.height > 0 ? (vertex.position.y - m_bounds.top) / m_bounds.height : 0;
+        vertex.texCoords.x = m_textureRect.left + m_textureRect.width * xratio;
+        vertex.texCoords.y = m_textureRect.top + m_textureRect.height * yratio;
+    }
+}
+
+} // namespace sf
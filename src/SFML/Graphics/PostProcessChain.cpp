@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PostProcessChain.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cassert>
+
+
+namespace
+{
+    // Draw a texture stretched over the whole target, with a single triangle
+    // that overshoots the target so that its visible part is exactly the target rectangle
+    void drawFullscreen(const sf::Texture& texture, sf::RenderTarget& target, const sf::Shader* shader, const sf::BlendMode& blendMode)
+    {
+        sf::Vector2f targetSize(target.getSize());
+        sf::Vector2f textureSize(texture.getSize());
+
+        sf::Vertex vertices[3] =
+        {
+            sf::Vertex(sf::Vector2f(0, 0),                sf::Vector2f(0, 0)),
+            sf::Vertex(sf::Vector2f(2 * targetSize.x, 0), sf::Vector2f(2 * textureSize.x, 0)),
+            sf::Vertex(sf::Vector2f(0, 2 * targetSize.y), sf::Vector2f(0, 2 * textureSize.y))
+        };
+
+        sf::RenderStates states(blendMode);
+        states.texture = &texture;
+        states.shader = shader;
+
+        // Temporarily map the view to the target pixels
+        sf::View view = target.getView();
+        target.setView(sf::View(sf::FloatRect(0, 0, targetSize.x, targetSize.y)));
+        target.draw(vertices, 3, sf::Triangles, states);
+        target.setView(view);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PostProcessChain::PostProcessChain() :
+m_passes(),
+m_pool  ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::addPass(const Shader& shader, float scale)
+{
+    Pass pass;
+    pass.shader  = &shader;
+    pass.scale   = scale;
+    pass.enabled = true;
+    m_passes.push_back(pass);
+
+    return m_passes.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::setPassEnabled(std::size_t index, bool enabled)
+{
+    assert(index < m_passes.size());
+
+    m_passes[index].enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcessChain::isPassEnabled(std::size_t index) const
+{
+    assert(index < m_passes.size());
+
+    return m_passes[index].enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::setPassScale(std::size_t index, float scale)
+{
+    assert(index < m_passes.size());
+
+    m_passes[index].scale = scale;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::getPassCount() const
+{
+    return m_passes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::clear()
+{
+    m_passes.clear();
+    m_pool.shrink();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::apply(const Texture& source, RenderTarget& target, const BlendMode& blendMode)
+{
+    // Find the last enabled pass, it will draw directly to the target
+    std::size_t last = m_passes.size();
+    for (std::size_t i = m_passes.size(); i > 0; --i)
+    {
+        if (m_passes[i - 1].enabled)
+        {
+            last = i - 1;
+            break;
+        }
+    }
+
+    // Nothing to apply: just copy the source to the target
+    if (last == m_passes.size())
+    {
+        drawFullscreen(source, target, NULL, blendMode);
+        return;
+    }
+
+    // Ping-pong between intermediate render-textures; only the input
+    // and the output of the current pass need to be alive at once
+    const Texture* input = &source;
+    RenderTexture* previous = NULL;
+    for (std::size_t i = 0; i < last; ++i)
+    {
+        const Pass& pass = m_passes[i];
+        if (!pass.enabled)
+            continue;
+
+        unsigned int width  = std::max(static_cast<unsigned int>(source.getSize().x * pass.scale + 0.5f), 1u);
+        unsigned int height = std::max(static_cast<unsigned int>(source.getSize().y * pass.scale + 0.5f), 1u);
+
+        RenderTexture* output = m_pool.acquire(width, height);
+        if (!output)
+        {
+            err() << "Failed to apply post-processing chain (failed to create an intermediate render texture)" << std::endl;
+            if (previous)
+                m_pool.release(previous);
+            return;
+        }
+
+        // The whole output is overwritten, no need to clear it
+        output->setSmooth(true);
+        drawFullscreen(*input, *output, pass.shader, BlendNone);
+        output->display();
+
+        if (previous)
+            m_pool.release(previous);
+
+        previous = output;
+        input = &output->getTexture();
+    }
+
+    drawFullscreen(*input, target, m_passes[last].shader, blendMode);
+
+    if (previous)
+        m_pool.release(previous);
+}
+
+} // namespace sf
@@ -0,0 +1,411 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/QoiCodec.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Tags of the chunks; the 2-bit tags are in the highest bits of the
+    // first byte, the 8-bit ones take precedence over the run tag
+    const sf::Uint8 opIndex = 0x00;
+    const sf::Uint8 opDiff  = 0x40;
+    const sf::Uint8 opLuma  = 0x80;
+    const sf::Uint8 opRun   = 0xC0;
+    const sf::Uint8 opRgb   = 0xFE;
+    const sf::Uint8 opRgba  = 0xFF;
+    const sf::Uint8 tagMask = 0xC0;
+
+    // Size of the file header
+    const std::size_t headerSize = 14;
+
+    // Size of the longest chunk, a RGBA one
+    const std::size_t maxChunkSize = 5;
+
+    // Bytes ending the file
+    const sf::Uint8 endMarker[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+    // Largest image accepted, the same limit as the reference implementation
+    const std::size_t maxPixelCount = 400000000;
+
+    // Size of the blocks read from streams and written to files
+    const std::size_t blockSize = 64 * 1024;
+
+    // Read a 32-bit value stored in big-endian order
+    sf::Uint32 loadBigEndian(const sf::Uint8* bytes)
+    {
+        return (static_cast<sf::Uint32>(bytes[0]) << 24) | (static_cast<sf::Uint32>(bytes[1]) << 16) |
+               (static_cast<sf::Uint32>(bytes[2]) << 8)  | static_cast<sf::Uint32>(bytes[3]);
+    }
+
+    // Append a 32-bit value in big-endian order
+    void appendBigEndian(std::vector<sf::Uint8>& bytes, sf::Uint32 value)
+    {
+        bytes.push_back(static_cast<sf::Uint8>(value >> 24));
+        bytes.push_back(static_cast<sf::Uint8>(value >> 16));
+        bytes.push_back(static_cast<sf::Uint8>(value >> 8));
+        bytes.push_back(static_cast<sf::Uint8>(value));
+    }
+
+    // Position of a pixel in the array of previously seen pixels
+    unsigned int hashPixel(const sf::Uint8* pixel)
+    {
+        return (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64;
+    }
+
+    // Wrap a difference of components around, to the range [-128, 127]
+    int wrapDifference(int difference)
+    {
+        return static_cast<int>(static_cast<sf::Uint8>(difference + 128)) - 128;
+    }
+
+    // Bytes of a QOI file, read from memory or in blocks from a stream
+    class ByteReader
+    {
+    public:
+
+        ByteReader(const sf::Uint8* data, std::size_t size) :
+        m_stream (NULL),
+        m_buffer (),
+        m_current(data),
+        m_end    (data + size)
+        {
+        }
+
+        explicit ByteReader(sf::InputStream& stream) :
+        m_stream (&stream),
+        m_buffer (blockSize),
+        m_current(&m_buffer[0]),
+        m_end    (&m_buffer[0])
+        {
+        }
+
+        // Make at least count bytes available, unless the source ends before
+        bool require(std::size_t count)
+        {
+            if (getAvailable() >= count)
+                return true;
+
+            if (!m_stream)
+                return false;
+
+            // Move the bytes left to the front of the buffer, and fill the rest from the stream
+            std::size_t available = getAvailable();
+            std::memmove(&m_buffer[0], m_current, available);
+            m_current = &m_buffer[0];
+            m_end     = m_current + available;
+
+            while (getAvailable() < count)
+            {
+                sf::Int64 read = m_stream->read(&m_buffer[0] + getAvailable(), static_cast<sf::Int64>(m_buffer.size() - getAvailable()));
+                if (read <= 0)
+                    return false;
+
+                m_end += read;
+            }
+
+            return true;
+        }
+
+        const sf::Uint8* getData() const
+        {
+            return m_current;
+        }
+
+        std::size_t getAvailable() const
+        {
+            return static_cast<std::size_t>(m_end - m_current);
+        }
+
+        void skip(std::size_t count)
+        {
+            m_current += count;
+        }
+
+    private:
+
+        sf::InputStream*       m_stream;  // Stream to read from, NULL when reading from memory
+        std::vector<sf::Uint8> m_buffer;  // Block read from the stream
+        const sf::Uint8*       m_current; // Next byte to read
+        const sf::Uint8*       m_end;     // End of the available bytes
+    };
+
+    // Decode a QOI file to RGBA pixels
+    bool decode(ByteReader& reader, sf::Uint8*& pixels, sf::Vector2u& size, const char*& error)
+    {
+        // Read the header
+        if (!reader.require(headerSize) || !sf::priv::isQoi(reader.getData(), headerSize))
+        {
+            error = "not a QOI file";
+            return false;
+        }
+
+        const sf::Uint8*   header   = reader.getData();
+        const unsigned int width    = loadBigEndian(header + 4);
+        const unsigned int height   = loadBigEndian(header + 8);
+        const sf::Uint8    channels = header[12];
+        if ((width == 0) || (height == 0) || (width > maxPixelCount / height) || ((channels != 3) && (channels != 4)) || (header[13] > 1))
+        {
+            error = "invalid QOI header";
+            return false;
+        }
+        reader.skip(headerSize);
+
+        const std::size_t byteCount = static_cast<std::size_t>(width) * height * 4;
+        sf::Uint8* output = static_cast<sf::Uint8*>(std::malloc(byteCount));
+        if (!output)
+        {
+            error = "out of memory";
+            return false;
+        }
+
+        // Files with 3 channels have no chunk that changes the alpha
+        sf::Uint8 index[64 * 4] = {0};
+        sf::Uint8 pixel[4] = {0, 0, 0, 255};
+
+        sf::Uint8*       current = output;
+        sf::Uint8* const end     = output + byteCount;
+        while (current < end)
+        {
+            // The last chunk is followed by the end marker, so there are
+            // always enough bytes for the longest chunk in valid files
+            if (!reader.require(maxChunkSize))
+            {
+                std::free(output);
+                error = "truncated QOI file";
+                return false;
+            }
+
+            // Decode all the chunks that are entirely available
+            const sf::Uint8* data  = reader.getData();
+            const sf::Uint8* limit = data + reader.getAvailable() - maxChunkSize + 1;
+            while ((data < limit) && (current < end))
+            {
+                const sf::Uint8 tag = *data++;
+                if (tag == opRgb)
+                {
+                    pixel[0] = data[0];
+                    pixel[1] = data[1];
+                    pixel[2] = data[2];
+                    data += 3;
+                }
+                else if (tag == opRgba)
+                {
+                    std::memcpy(pixel, data, 4);
+                    data += 4;
+                }
+                else
+                {
+                    switch (tag & tagMask)
+                    {
+                        case opIndex:
+                        {
+                            std::memcpy(pixel, &index[tag * 4], 4);
+                            break;
+                        }
+
+                        case opDiff:
+                        {
+                            pixel[0] = static_cast<sf::Uint8>(pixel[0] + ((tag >> 4) & 0x03) - 2);
+                            pixel[1] = static_cast<sf::Uint8>(pixel[1] + ((tag >> 2) & 0x03) - 2);
+                            pixel[2] = static_cast<sf::Uint8>(pixel[2] + (tag & 0x03) - 2);
+                            break;
+                        }
+
+                        case opLuma:
+                        {
+                            const int green = (tag & 0x3F) - 32;
+                            const sf::Uint8 next = *data++;
+                            pixel[0] = static_cast<sf::Uint8>(pixel[0] + green - 8 + (next >> 4));
+                            pixel[1] = static_cast<sf::Uint8>(pixel[1] + green);
+                            pixel[2] = static_cast<sf::Uint8>(pixel[2] + green - 8 + (next & 0x0F));
+                            break;
+                        }
+
+                        default:
+                        {
+                            // Repeat the previous pixel; a run that overflows the image is clamped
+                            std::size_t run = std::min<std::size_t>((tag & 0x3F) + 1, (end - current) / 4);
+                            for (; run > 1; --run, current += 4)
+                                std::memcpy(current, pixel, 4);
+                            break;
+                        }
+                    }
+                }
+
+                std::memcpy(&index[hashPixel(pixel) * 4], pixel, 4);
+                std::memcpy(current, pixel, 4);
+                current += 4;
+            }
+
+            reader.skip(static_cast<std::size_t>(data - reader.getData()));
+        }
+
+        pixels = output;
+        size.x = width;
+        size.y = height;
+
+        return true;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isQoi(const void* data, std::size_t size)
+{
+    return (size >= 4) && (std::memcmp(data, "qoif", 4) == 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool decodeQoi(const void* data, std::size_t dataSize, Uint8*& pixels, Vector2u& size, const char*& error)
+{
+    ByteReader reader(static_cast<const Uint8*>(data), dataSize);
+    return decode(reader, pixels, size, error);
+}
+
+
+////////////////////////////////////////////////////////////
+bool decodeQoi(InputStream& stream, Uint8*& pixels, Vector2u& size, const char*& error)
+{
+    ByteReader reader(stream);
+    return decode(reader, pixels, size, error);
+}
+
+
+////////////////////////////////////////////////////////////
+bool writeQoi(const std::string& filename, const Uint8* pixels, const Vector2u& size)
+{
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file)
+        return false;
+
+    // Chunks are encoded to a buffer, written to the file whenever it's full
+    std::vector<Uint8> buffer;
+    buffer.reserve(blockSize + maxChunkSize);
+
+    // Header: 4 channels, sRGB with linear alpha
+    buffer.insert(buffer.end(), "qoif", "qoif" + 4);
+    appendBigEndian(buffer, size.x);
+    appendBigEndian(buffer, size.y);
+    buffer.push_back(4);
+    buffer.push_back(0);
+
+    Uint8 index[64 * 4] = {0};
+    Uint8 previous[4] = {0, 0, 0, 255};
+    unsigned int run = 0;
+
+    bool success = true;
+    const std::size_t count = static_cast<std::size_t>(size.x) * size.y;
+    const Uint8* pixel = pixels;
+    for (std::size_t i = 0; success && (i < count); ++i, pixel += 4)
+    {
+        if (std::memcmp(pixel, previous, 4) == 0)
+        {
+            // Runs are at most 62 pixels long, 63 and 64 would be the RGB and RGBA tags
+            if ((++run == 62) || (i + 1 == count))
+            {
+                buffer.push_back(static_cast<Uint8>(opRun | (run - 1)));
+                run = 0;
+            }
+        }
+        else
+        {
+            if (run > 0)
+            {
+                buffer.push_back(static_cast<Uint8>(opRun | (run - 1)));
+                run = 0;
+            }
+
+            const unsigned int hash = hashPixel(pixel);
+            if (std::memcmp(&index[hash * 4], pixel, 4) == 0)
+            {
+                buffer.push_back(static_cast<Uint8>(opIndex | hash));
+            }
+            else
+            {
+                std::memcpy(&index[hash * 4], pixel, 4);
+
+                if (pixel[3] == previous[3])
+                {
+                    const int red       = wrapDifference(pixel[0] - previous[0]);
+                    const int green     = wrapDifference(pixel[1] - previous[1]);
+                    const int blue      = wrapDifference(pixel[2] - previous[2]);
+                    const int redGreen  = wrapDifference(red - green);
+                    const int blueGreen = wrapDifference(blue - green);
+
+                    if ((red >= -2) && (red <= 1) && (green >= -2) && (green <= 1) && (blue >= -2) && (blue <= 1))
+                    {
+                        buffer.push_back(static_cast<Uint8>(opDiff | ((red + 2) << 4) | ((green + 2) << 2) | (blue + 2)));
+                    }
+                    else if ((green >= -32) && (green <= 31) && (redGreen >= -8) && (redGreen <= 7) && (blueGreen >= -8) && (blueGreen <= 7))
+                    {
+                        buffer.push_back(static_cast<Uint8>(opLuma | (green + 32)));
+                        buffer.push_back(static_cast<Uint8>(((redGreen + 8) << 4) | (blueGreen + 8)));
+                    }
+                    else
+                    {
+                        buffer.push_back(opRgb);
+                        buffer.insert(buffer.end(), pixel, pixel + 3);
+                    }
+                }
+                else
+                {
+                    buffer.push_back(opRgba);
+                    buffer.insert(buffer.end(), pixel, pixel + 4);
+                }
+            }
+
+            std::memcpy(previous, pixel, 4);
+        }
+
+        if (buffer.size() >= blockSize)
+        {
+            success = (std::fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size());
+            buffer.clear();
+        }
+    }
+
+    buffer.insert(buffer.end(), endMarker, endMarker + 8);
+    success = success && (std::fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size());
+
+    return (std::fclose(file) == 0) && success;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_QOICODEC_HPP
+#define SFML_QOICODEC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <string>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Check whether data starts like a QOI file
+///
+/// \param data Pointer to the beginning of the file
+/// \param size Number of bytes available at \a data
+///
+/// \return True if the data starts with the QOI magic bytes
+///
+////////////////////////////////////////////////////////////
+bool isQoi(const void* data, std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Decode a QOI file in memory
+///
+/// On success, \a pixels receives an array of RGBA pixels
+/// allocated with std::malloc, that the caller must free
+/// with std::free. On failure, \a error receives the reason.
+///
+/// \param data     Pointer to the file data in memory
+/// \param dataSize Size of the data, in bytes
+/// \param pixels   Receives the array of decoded pixels
+/// \param size     Receives the size of the image, in pixels
+/// \param error    Receives the reason of the failure
+///
+/// \return True if decoding was successful
+///
+////////////////////////////////////////////////////////////
+bool decodeQoi(const void* data, std::size_t dataSize, Uint8*& pixels, Vector2u& size, const char*& error);
+
+////////////////////////////////////////////////////////////
+/// \brief Decode a QOI file from a stream
+///
+/// The stream is read in blocks as the pixels are decoded,
+/// from its current position.
+///
+/// \param stream Source stream to read from
+/// \param pixels Receives the array of decoded pixels
+/// \param size   Receives the size of the image, in pixels
+/// \param error  Receives the reason of the failure
+///
+/// \return True if decoding was successful
+///
+////////////////////////////////////////////////////////////
+bool decodeQoi(InputStream& stream, Uint8*& pixels, Vector2u& size, const char*& error);
+
+////////////////////////////////////////////////////////////
+/// \brief Save an array of RGBA pixels as a QOI file
+///
+/// \param filename Path of the file to save
+/// \param pixels   Array of pixels to save
+/// \param size     Size of the image, in pixels
+///
+/// \return True if saving was successful
+///
+////////////////////////////////////////////////////////////
+bool writeQoi(const std::string& filename, const Uint8* pixels, const Vector2u& size);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_QOICODEC_HPP
@@ -41,6 +41,9 @@ RectangleShape::RectangleShape(const Vector2f& size)
 ////////////////////////////////////////////////////////////
 void RectangleShape::setSize(const Vector2f& size)
 {
+    if (size == m_size)
+        return;
+
     m_size = size;
     update();
 }
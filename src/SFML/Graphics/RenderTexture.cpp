@@ -29,13 +29,15 @@
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/RenderTextureImplDefault.hpp>
 #include <SFML/System/Err.hpp>
+#include <cassert>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 RenderTexture::RenderTexture() :
-m_impl(NULL)
+m_impl       (NULL),
+m_attachments()
 {
 
 }
@@ -45,12 +47,28 @@ m_impl(NULL)
 RenderTexture::~RenderTexture()
 {
     delete m_impl;
+
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        delete *it;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBuffer)
 {
+    return create(width, height, ContextSettings(depthBuffer ? 32 : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings, unsigned int attachmentCount)
+{
+    if (attachmentCount == 0)
+    {
+        err() << "Impossible to create render texture (at least one color attachment is required)" << std::endl;
+        return false;
+    }
+
     // Create the texture
     if (!m_texture.create(width, height))
     {
@@ -58,6 +76,26 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
         return false;
     }
 
+    // Create the additional textures for multiple render targets
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        delete *it;
+    m_attachments.clear();
+
+    std::vector<unsigned int> textureIds(1, m_texture.m_texture);
+    for (unsigned int i = 1; i < attachmentCount; ++i)
+    {
+        Texture* texture = new Texture;
+        m_attachments.push_back(texture);
+
+        if (!texture->create(width, height))
+        {
+            err() << "Impossible to create render texture (failed to create the target texture for color attachment " << i << ")" << std::endl;
+            return false;
+        }
+
+        textureIds.push_back(texture->m_texture);
+    }
+
     // We disable smoothing by default for render textures
     setSmooth(false);
 
@@ -68,8 +106,10 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
         // Use frame-buffer object (FBO)
         m_impl = new priv::RenderTextureImplFBO;
 
-        // Mark the texture as being a framebuffer object attachment
+        // Mark the textures as being framebuffer object attachments
         m_texture.m_fboAttachment = true;
+        for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+            (*it)->m_fboAttachment = true;
     }
     else
     {
@@ -78,7 +118,7 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
     }
 
     // Initialize the render texture
-    if (!m_impl->create(width, height, m_texture.m_texture, depthBuffer))
+    if (!m_impl->create(width, height, textureIds, settings))
         return false;
 
     // We can now initialize the render target part
@@ -88,10 +128,33 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumAntialiasingLevel()
+{
+    if (priv::RenderTextureImplFBO::isAvailable())
+        return priv::RenderTextureImplFBO::getMaximumAntialiasingLevel();
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumAttachmentCount()
+{
+    if (priv::RenderTextureImplFBO::isAvailable())
+        return priv::RenderTextureImplFBO::getMaximumAttachmentCount();
+
+    return 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTexture::setSmooth(bool smooth)
 {
     m_texture.setSmooth(smooth);
+
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        (*it)->setSmooth(smooth);
 }
 
 
@@ -106,6 +169,9 @@ bool RenderTexture::isSmooth() const
 void RenderTexture::setRepeated(bool repeated)
 {
     m_texture.setRepeated(repeated);
+
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        (*it)->setRepeated(repeated);
 }
 
 
@@ -139,6 +205,12 @@ void RenderTexture::display()
         m_impl->updateTexture(m_texture.m_texture);
         m_texture.m_pixelsFlipped = true;
         m_texture.invalidateMipmap();
+
+        for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        {
+            (*it)->m_pixelsFlipped = true;
+            (*it)->invalidateMipmap();
+        }
     }
 }
 
@@ -151,9 +223,18 @@ Vector2u RenderTexture::getSize() const
 
 
 ////////////////////////////////////////////////////////////
-const Texture& RenderTexture::getTexture() const
+const Texture& RenderTexture::getTexture(unsigned int index) const
+{
+    assert(index <= m_attachments.size());
+
+    return (index == 0) ? m_texture : *m_attachments[index - 1];
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getAttachmentCount() const
 {
-    return m_texture;
+    return m_impl ? static_cast<unsigned int>(m_attachments.size()) + 1 : 0;
 }
 
 } // namespace sf
@@ -55,14 +55,21 @@ RenderTextureImplDefault::~RenderTextureImplDefault()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplDefault::create(unsigned int width, unsigned int height, unsigned int, bool depthBuffer)
+bool RenderTextureImplDefault::create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings)
 {
+    // Multiple render targets require frame buffer objects
+    if (textureIds.size() > 1)
+    {
+        err() << "Impossible to create render texture (multiple color attachments are not supported without frame buffer objects)" << std::endl;
+        return false;
+    }
+
     // Store the dimensions
     m_width = width;
     m_height = height;
 
     // Create the in-memory OpenGL context
-    m_context = new Context(ContextSettings(depthBuffer ? 32 : 0), width, height);
+    m_context = new Context(settings, width, height);
 
     return true;
 }
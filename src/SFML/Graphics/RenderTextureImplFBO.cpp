@@ -29,6 +29,7 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 
 
 namespace sf
@@ -37,9 +38,14 @@ namespace priv
 {
 ////////////////////////////////////////////////////////////
 RenderTextureImplFBO::RenderTextureImplFBO() :
-m_context    (NULL),
-m_frameBuffer(0),
-m_depthBuffer(0)
+m_context               (NULL),
+m_frameBuffer           (0),
+m_multisampleFrameBuffer(0),
+m_colorBuffers          (),
+m_depthBuffer           (0),
+m_width                 (0),
+m_height                (0),
+m_attachmentCount       (0)
 {
 
 }
@@ -50,6 +56,13 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
 {
     m_context->setActive(true);
 
+    // Destroy the color buffers
+    for (std::vector<unsigned int>::const_iterator it = m_colorBuffers.begin(); it != m_colorBuffers.end(); ++it)
+    {
+        GLuint colorBuffer = static_cast<GLuint>(*it);
+        glCheck(GLEXT_glDeleteRenderbuffers(1, &colorBuffer));
+    }
+
     // Destroy the depth buffer
     if (m_depthBuffer)
     {
@@ -57,6 +70,13 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
         glCheck(GLEXT_glDeleteRenderbuffers(1, &depthBuffer));
     }
 
+    // Destroy the multisample frame buffer
+    if (m_multisampleFrameBuffer)
+    {
+        GLuint multisampleFrameBuffer = static_cast<GLuint>(m_multisampleFrameBuffer);
+        glCheck(GLEXT_glDeleteFramebuffers(1, &multisampleFrameBuffer));
+    }
+
     // Destroy the frame buffer
     if (m_frameBuffer)
     {
@@ -82,8 +102,81 @@ bool RenderTextureImplFBO::isAvailable()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer)
+unsigned int RenderTextureImplFBO::getMaximumAntialiasingLevel()
+{
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_multisample || !GLEXT_framebuffer_blit)
+        return 0;
+
+    GLint samples = 0;
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_SAMPLES, &samples));
+
+    return static_cast<unsigned int>(samples);
+
+#else
+
+    return 0;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTextureImplFBO::getMaximumAttachmentCount()
+{
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_object || !GLEXT_draw_buffers)
+        return 1;
+
+    GLint attachments = 0;
+    GLint drawBuffers = 0;
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_COLOR_ATTACHMENTS, &attachments));
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_DRAW_BUFFERS, &drawBuffers));
+
+    GLint count = std::min(attachments, drawBuffers);
+
+    return count > 1 ? static_cast<unsigned int>(count) : 1;
+
+#else
+
+    return 1;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings)
 {
+    // Store the dimensions
+    m_width = width;
+    m_height = height;
+    m_attachmentCount = static_cast<unsigned int>(textureIds.size());
+
+    // Check the number of color attachments against what the system supports
+    if (m_attachmentCount > 1)
+    {
+        unsigned int maxAttachments = getMaximumAttachmentCount();
+        if (m_attachmentCount > maxAttachments)
+        {
+            err() << "Impossible to create render texture (" << m_attachmentCount << " color attachments requested, maximum supported is "
+                  << maxAttachments << ")" << std::endl;
+            return false;
+        }
+    }
+
     // Create the context
     m_context = new Context;
 
@@ -98,36 +191,131 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
     }
     glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_frameBuffer));
 
-    // Create the depth buffer if requested
-    if (depthBuffer)
+    // Link the textures to the frame buffer
+    for (unsigned int i = 0; i < m_attachmentCount; ++i)
+        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, textureIds[i], 0));
+
+    // Clamp the requested anti-aliasing level to what the system supports
+    unsigned int samples = settings.antialiasingLevel;
+    if (samples > 0)
+    {
+        unsigned int maxSamples = getMaximumAntialiasingLevel();
+        if (samples > maxSamples)
+        {
+            err() << "Impossible to create render texture with " << samples << " samples (maximum supported is "
+                  << maxSamples << "), falling back to " << maxSamples << std::endl;
+            samples = maxSamples;
+        }
+    }
+
+    if (samples == 0)
+    {
+        // Create the depth buffer if requested
+        if (settings.depthBits)
+        {
+            GLuint depth = 0;
+            glCheck(GLEXT_glGenRenderbuffers(1, &depth));
+            m_depthBuffer = static_cast<unsigned int>(depth);
+            if (!m_depthBuffer)
+            {
+                err() << "Impossible to create render texture (failed to create the attached depth buffer)" << std::endl;
+                return false;
+            }
+            glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_depthBuffer));
+            glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, GLEXT_GL_DEPTH_COMPONENT, width, height));
+            glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
+        }
+
+        // Draw to all the attached textures at once
+        setDrawBuffers();
+
+        // A final check, just to be sure...
+        GLenum status;
+        glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+        if (status != GLEXT_GL_FRAMEBUFFER_COMPLETE)
+        {
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+            err() << "Impossible to create render texture (failed to link the target texture to the frame buffer)" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // The texture frame buffer only serves as the resolve target, check it before moving on
+    GLenum status;
+    glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+    if (status != GLEXT_GL_FRAMEBUFFER_COMPLETE)
+    {
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+        err() << "Impossible to create render texture (failed to link the target texture to the frame buffer)" << std::endl;
+        return false;
+    }
+
+    // Create the multisample framebuffer object, this is the one we render to
+    GLuint multisampleFrameBuffer = 0;
+    glCheck(GLEXT_glGenFramebuffers(1, &multisampleFrameBuffer));
+    m_multisampleFrameBuffer = static_cast<unsigned int>(multisampleFrameBuffer);
+    if (!m_multisampleFrameBuffer)
+    {
+        err() << "Impossible to create render texture (failed to create the multisample frame buffer object)" << std::endl;
+        return false;
+    }
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_multisampleFrameBuffer));
+
+    // Create one multisample color buffer per target texture
+    for (unsigned int i = 0; i < m_attachmentCount; ++i)
+    {
+        GLuint color = 0;
+        glCheck(GLEXT_glGenRenderbuffers(1, &color));
+        if (!color)
+        {
+            err() << "Impossible to create render texture (failed to create the attached multisample color buffer)" << std::endl;
+            return false;
+        }
+        m_colorBuffers.push_back(static_cast<unsigned int>(color));
+        glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, color));
+        glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, samples, GL_RGBA, width, height));
+        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0 + i, GLEXT_GL_RENDERBUFFER, color));
+    }
+
+    // Create the multisample depth buffer if requested
+    if (settings.depthBits)
     {
         GLuint depth = 0;
         glCheck(GLEXT_glGenRenderbuffers(1, &depth));
         m_depthBuffer = static_cast<unsigned int>(depth);
         if (!m_depthBuffer)
         {
-            err() << "Impossible to create render texture (failed to create the attached depth buffer)" << std::endl;
+            err() << "Impossible to create render texture (failed to create the attached multisample depth buffer)" << std::endl;
             return false;
         }
         glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_depthBuffer));
-        glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, GLEXT_GL_DEPTH_COMPONENT, width, height));
+        glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, samples, GLEXT_GL_DEPTH_COMPONENT, width, height));
         glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
     }
 
-    // Link the texture to the frame buffer
-    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, 0));
+    // Draw to all the attached color buffers at once
+    setDrawBuffers();
 
     // A final check, just to be sure...
-    GLenum status;
     glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
     if (status != GLEXT_GL_FRAMEBUFFER_COMPLETE)
     {
         glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
-        err() << "Impossible to create render texture (failed to link the target texture to the frame buffer)" << std::endl;
+        err() << "Impossible to create render texture (failed to create the multisample frame buffer)" << std::endl;
         return false;
     }
 
     return true;
+
+#else
+
+    return false;
+
+#endif // SFML_OPENGL_ES
 }
 
 
@@ -141,9 +329,52 @@ bool RenderTextureImplFBO::activate(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTextureImplFBO::updateTexture(unsigned int)
 {
+#ifndef SFML_OPENGL_ES
+
+    // Resolve the multisample frame buffer into the target textures, one attachment at a time
+    if (m_multisampleFrameBuffer)
+    {
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, m_multisampleFrameBuffer));
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, m_frameBuffer));
+
+        for (unsigned int i = 0; i < m_attachmentCount; ++i)
+        {
+            if (m_attachmentCount > 1)
+            {
+                glCheck(glReadBuffer(GLEXT_GL_COLOR_ATTACHMENT0 + i));
+                glCheck(glDrawBuffer(GLEXT_GL_COLOR_ATTACHMENT0 + i));
+            }
+
+            glCheck(GLEXT_glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+        }
+
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_multisampleFrameBuffer));
+    }
+
+#endif // SFML_OPENGL_ES
+
     glCheck(glFlush());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderTextureImplFBO::setDrawBuffers()
+{
+#ifndef SFML_OPENGL_ES
+
+    // A single attachment uses the default draw buffer
+    if (m_attachmentCount > 1)
+    {
+        std::vector<GLenum> buffers(m_attachmentCount);
+        for (unsigned int i = 0; i < m_attachmentCount; ++i)
+            buffers[i] = GLEXT_GL_COLOR_ATTACHMENT0 + i;
+
+        glCheck(GLEXT_glDrawBuffers(static_cast<GLsizei>(m_attachmentCount), &buffers[0]));
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
 } // namespace priv
 
 } // namespace sf
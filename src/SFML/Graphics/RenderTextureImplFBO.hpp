@@ -31,6 +31,7 @@
 #include <SFML/Graphics/RenderTextureImpl.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <vector>
 
 
 namespace sf
@@ -66,6 +67,22 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum anti-aliasing level supported by the system
+    ///
+    /// \return The maximum anti-aliasing level supported by the system
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAntialiasingLevel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments that can be drawn to at once
+    ///
+    /// \return The maximum number of simultaneous color attachments
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -73,13 +90,13 @@ private:
     ///
     /// \param width       Width of the texture to render to
     /// \param height      Height of the texture to render to
-    /// \param textureId   OpenGL identifier of the target texture
-    /// \param depthBuffer Is a depth buffer requested?
+    /// \param textureIds  OpenGL identifiers of the target textures, one per color attachment
+    /// \param settings    Context settings (depth bits and antialiasing level)
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer);
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
@@ -94,17 +111,30 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Update the pixels of the target texture
     ///
-    /// \param textureId OpenGL identifier of the target texture
+    /// \param textureId OpenGL identifier of the first target texture
     ///
     ////////////////////////////////////////////////////////////
     virtual void updateTexture(unsigned textureId);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Route fragment outputs to all the color attachments
+    ///
+    /// Applies to the frame buffer currently bound.
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDrawBuffers();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Context*     m_context;     ///< Needs a separate OpenGL context for not messing up the other ones
-    unsigned int m_frameBuffer; ///< OpenGL frame buffer object
-    unsigned int m_depthBuffer; ///< Optional depth buffer attached to the frame buffer
+    Context*                  m_context;                ///< Needs a separate OpenGL context for not messing up the other ones
+    unsigned int              m_frameBuffer;            ///< OpenGL frame buffer object the target textures are attached to
+    unsigned int              m_multisampleFrameBuffer; ///< Optional multisample frame buffer object, resolved into m_frameBuffer
+    std::vector<unsigned int> m_colorBuffers;           ///< Optional multisample color buffers attached to the multisample frame buffer
+    unsigned int              m_depthBuffer;            ///< Optional depth buffer attached to the frame buffer we render to
+    unsigned int              m_width;                  ///< Width of the attachments
+    unsigned int              m_height;                 ///< Height of the attachments
+    unsigned int              m_attachmentCount;        ///< Number of color attachments
 };
 
 } // namespace priv
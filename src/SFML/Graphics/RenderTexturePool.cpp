@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+
+
+namespace
+{
+    // Check whether two settings produce the same render-texture attachments
+    bool isCompatible(const sf::ContextSettings& left, const sf::ContextSettings& right)
+    {
+        return (left.depthBits == right.depthBits) && (left.antialiasingLevel == right.antialiasingLevel);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderTexturePool::RenderTexturePool() :
+m_entries()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::~RenderTexturePool()
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        delete it->renderTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* RenderTexturePool::acquire(unsigned int width, unsigned int height, const ContextSettings& settings, unsigned int attachmentCount)
+{
+    // Look for a compatible render-texture that is not in use
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (!it->inUse && (it->width == width) && (it->height == height) &&
+            (it->attachmentCount == attachmentCount) && isCompatible(it->settings, settings))
+        {
+            it->inUse = true;
+
+            // Reset the states that a previous user may have changed
+            RenderTexture* renderTexture = it->renderTexture;
+            renderTexture->setView(renderTexture->getDefaultView());
+            renderTexture->setSmooth(false);
+            renderTexture->setRepeated(false);
+
+            return renderTexture;
+        }
+    }
+
+    // None found: create a new one
+    RenderTexture* renderTexture = new RenderTexture;
+    if (!renderTexture->create(width, height, settings, attachmentCount))
+    {
+        delete renderTexture;
+        return NULL;
+    }
+
+    Entry entry;
+    entry.renderTexture   = renderTexture;
+    entry.width           = width;
+    entry.height          = height;
+    entry.settings        = settings;
+    entry.attachmentCount = attachmentCount;
+    entry.inUse           = true;
+    m_entries.push_back(entry);
+
+    return renderTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::release(RenderTexture* renderTexture)
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->renderTexture == renderTexture)
+        {
+            it->inUse = false;
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::shrink()
+{
+    std::vector<Entry>::iterator end = m_entries.begin();
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->inUse)
+            *end++ = *it;
+        else
+            delete it->renderTexture;
+    }
+
+    m_entries.erase(end, m_entries.end());
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getSize() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getAvailableCount() const
+{
+    std::size_t count = 0;
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (!it->inUse)
+            ++count;
+    }
+
+    return count;
+}
+
+} // namespace sf
@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SceneNode.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SceneNode::SceneNode() :
+m_parent                  (NULL),
+m_children                (),
+m_drawable                (NULL),
+m_visible                 (true),
+m_worldTransform          (),
+m_worldTransformNeedUpdate(true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode::~SceneNode()
+{
+    if (m_parent)
+        m_parent->detachChild(*this);
+
+    for (std::vector<SceneNode*>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+    {
+        (*it)->m_parent = NULL;
+        (*it)->invalidateWorldTransform();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::attachChild(SceneNode& child)
+{
+    // Refuse to create cycles
+    for (const SceneNode* node = this; node; node = node->m_parent)
+    {
+        if (node == &child)
+        {
+            err() << "Failed to attach scene node (a node cannot be attached to itself or to one of its descendants)" << std::endl;
+            return;
+        }
+    }
+
+    if (child.m_parent)
+        child.m_parent->detachChild(child);
+
+    m_children.push_back(&child);
+    child.m_parent = this;
+    child.invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::detachChild(SceneNode& child)
+{
+    std::vector<SceneNode*>::iterator it = std::find(m_children.begin(), m_children.end(), &child);
+    if (it == m_children.end())
+        return;
+
+    m_children.erase(it);
+    child.m_parent = NULL;
+    child.invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode* SceneNode::getParent() const
+{
+    return m_parent;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneNode::getChildCount() const
+{
+    return m_children.size();
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode& SceneNode::getChild(std::size_t index) const
+{
+    return *m_children[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setDrawable(const Drawable* drawable)
+{
+    m_drawable = drawable;
+}
+
+
+////////////////////////////////////////////////////////////
+const Drawable* SceneNode::getDrawable() const
+{
+    return m_drawable;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setVisible(bool visible)
+{
+    m_visible = visible;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SceneNode::isVisible() const
+{
+    return m_visible;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setPosition(float x, float y)
+{
+    Transformable::setPosition(x, y);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setPosition(const Vector2f& position)
+{
+    Transformable::setPosition(position);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setRotation(float angle)
+{
+    Transformable::setRotation(angle);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setScale(float factorX, float factorY)
+{
+    Transformable::setScale(factorX, factorY);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setScale(const Vector2f& factors)
+{
+    Transformable::setScale(factors);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setOrigin(float x, float y)
+{
+    Transformable::setOrigin(x, y);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setOrigin(const Vector2f& origin)
+{
+    Transformable::setOrigin(origin);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::move(float offsetX, float offsetY)
+{
+    Transformable::move(offsetX, offsetY);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::move(const Vector2f& offset)
+{
+    Transformable::move(offset);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::rotate(float angle)
+{
+    Transformable::rotate(angle);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::scale(float factorX, float factorY)
+{
+    Transformable::scale(factorX, factorY);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::scale(const Vector2f& factor)
+{
+    Transformable::scale(factor);
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+const Transform& SceneNode::getWorldTransform() const
+{
+    if (m_worldTransformNeedUpdate)
+    {
+        if (m_parent)
+            m_worldTransform = m_parent->getWorldTransform() * getTransform();
+        else
+            m_worldTransform = getTransform();
+
+        m_worldTransformNeedUpdate = false;
+    }
+
+    return m_worldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::flatten(std::vector<DrawItem>& items) const
+{
+    if (!m_visible)
+        return;
+
+    if (m_drawable)
+    {
+        DrawItem item;
+        item.drawable = m_drawable;
+        item.transform = getWorldTransform();
+        items.push_back(item);
+    }
+
+    for (std::vector<SceneNode*>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+        (*it)->flatten(items);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_visible)
+        return;
+
+    if (m_drawable)
+    {
+        RenderStates nodeStates(states);
+        nodeStates.transform *= getWorldTransform();
+        target.draw(*m_drawable, nodeStates);
+    }
+
+    for (std::vector<SceneNode*>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+        (*it)->draw(target, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::invalidateWorldTransform()
+{
+    // A node with an outdated world transform always has outdated
+    // descendants, so there's no need to go further down
+    if (m_worldTransformNeedUpdate)
+        return;
+
+    m_worldTransformNeedUpdate = true;
+
+    for (std::vector<SceneNode*>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+        (*it)->invalidateWorldTransform();
+}
+
+} // namespace sf
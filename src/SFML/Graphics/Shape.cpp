@@ -34,6 +34,17 @@
 
 namespace
 {
+    // Parts of the geometry of a shape that can be invalidated
+    enum DirtyFlags
+    {
+        PointsDirty        = 1 << 0,
+        FillColorsDirty    = 1 << 1,
+        TexCoordsDirty     = 1 << 2,
+        OutlineDirty       = 1 << 3,
+        OutlineColorsDirty = 1 << 4,
+        AllDirty           = PointsDirty | FillColorsDirty | TexCoordsDirty | OutlineDirty | OutlineColorsDirty
+    };
+
     // Compute the normal of a segment
     sf::Vector2f computeNormal(const sf::Vector2f& p1, const sf::Vector2f& p2)
     {
@@ -85,8 +96,11 @@ const Texture* Shape::getTexture() const
 ////////////////////////////////////////////////////////////
 void Shape::setTextureRect(const IntRect& rect)
 {
+    if (rect == m_textureRect)
+        return;
+
     m_textureRect = rect;
-    updateTexCoords();
+    m_dirty |= TexCoordsDirty;
 }
 
 
@@ -100,8 +114,11 @@ const IntRect& Shape::getTextureRect() const
 ////////////////////////////////////////////////////////////
 void Shape::setFillColor(const Color& color)
 {
+    if (color == m_fillColor)
+        return;
+
     m_fillColor = color;
-    updateFillColors();
+    m_dirty |= FillColorsDirty;
 }
 
 
@@ -115,8 +132,11 @@ const Color& Shape::getFillColor() const
 ////////////////////////////////////////////////////////////
 void Shape::setOutlineColor(const Color& color)
 {
+    if (color == m_outlineColor)
+        return;
+
     m_outlineColor = color;
-    updateOutlineColors();
+    m_dirty |= OutlineColorsDirty;
 }
 
 
@@ -130,8 +150,12 @@ const Color& Shape::getOutlineColor() const
 ////////////////////////////////////////////////////////////
 void Shape::setOutlineThickness(float thickness)
 {
+    if (thickness == m_outlineThickness)
+        return;
+
+    // The fill doesn't depend on the thickness, only the outline must be recomputed
     m_outlineThickness = thickness;
-    update(); // recompute everything because the whole shape must be offset
+    m_dirty |= OutlineDirty;
 }
 
 
@@ -145,6 +169,8 @@ float Shape::getOutlineThickness() const
 ////////////////////////////////////////////////////////////
 FloatRect Shape::getLocalBounds() const
 {
+    ensureGeometryUpdate();
+
     return m_bounds;
 }
 
@@ -166,20 +192,92 @@ m_outlineThickness(0),
 m_vertices        (TriangleFan),
 m_outlineVertices (TriangleStrip),
 m_insideBounds    (),
-m_bounds          ()
+m_bounds          (),
+m_dirty           (AllDirty)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shape::update()
+{
+    m_dirty = AllDirty;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::draw(RenderTarget& target, RenderStates states) const
+{
+    ensureGeometryUpdate();
+
+    states.transform *= getTransform();
+
+    // Render the inside
+    states.texture = m_texture;
+    target.draw(m_vertices, states);
+
+    // Render the outline
+    if (m_outlineThickness != 0)
+    {
+        states.texture = NULL;
+        target.draw(m_outlineVertices, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::ensureGeometryUpdate() const
+{
+    if (!m_dirty)
+        return;
+
+    // Moving the points invalidates everything else
+    if (m_dirty & PointsDirty)
+    {
+        updatePoints();
+        m_dirty = AllDirty & ~PointsDirty;
+    }
+
+    if (m_vertices.getVertexCount() == 0)
+    {
+        m_outlineVertices.resize(0);
+        m_bounds = FloatRect();
+        m_dirty = 0;
+        return;
+    }
+
+    if (m_dirty & FillColorsDirty)
+        updateFillColors();
+
+    if (m_dirty & TexCoordsDirty)
+        updateTexCoords();
+
+    // The outline is not drawn when its thickness is 0: don't compute it
+    // until it becomes visible, the bounds are then those of the fill
+    if (m_outlineThickness == 0)
+    {
+        m_bounds = m_insideBounds;
+        m_dirty &= OutlineDirty | OutlineColorsDirty;
+        return;
+    }
+
+    if (m_dirty & OutlineDirty)
+        updateOutline();
+    else if (m_dirty & OutlineColorsDirty)
+        updateOutlineColors();
+
+    m_dirty = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updatePoints() const
 {
     // Get the total number of points of the shape
     std::size_t count = getPointCount();
     if (count < 3)
     {
         m_vertices.resize(0);
-        m_outlineVertices.resize(0);
         return;
     }
 
@@ -197,38 +295,11 @@ void Shape::update()
     // Compute the center and make it the first vertex
     m_vertices[0].position.x = m_insideBounds.left + m_insideBounds.width / 2;
     m_vertices[0].position.y = m_insideBounds.top + m_insideBounds.height / 2;
-
-    // Color
-    updateFillColors();
-
-    // Texture coordinates
-    updateTexCoords();
-
-    // Outline
-    updateOutline();
-}
-
-
-////////////////////////////////////////////////////////////
-void Shape::draw(RenderTarget& target, RenderStates states) const
-{
-    states.transform *= getTransform();
-
-    // Render the inside
-    states.texture = m_texture;
-    target.draw(m_vertices, states);
-
-    // Render the outline
-    if (m_outlineThickness != 0)
-    {
-        states.texture = NULL;
-        target.draw(m_outlineVertices, states);
-    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateFillColors()
+void Shape::updateFillColors() const
 {
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
         m_vertices[i].color = m_fillColor;
@@ -236,7 +307,7 @@ void Shape::updateFillColors()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateTexCoords()
+void Shape::updateTexCoords() const
 {
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
     {
@@ -249,29 +320,34 @@ void Shape::updateTexCoords()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateOutline()
+void Shape::updateOutline() const
 {
     std::size_t count = m_vertices.getVertexCount() - 2;
     m_outlineVertices.resize((count + 1) * 2);
 
+    // Each segment is shared by two consecutive points: compute its
+    // normal once and carry it over to the next point
+    Vector2f center = m_vertices[0].position;
+    Vector2f nextNormal = computeNormal(m_vertices[count].position, m_vertices[1].position);
+
     for (std::size_t i = 0; i < count; ++i)
     {
         std::size_t index = i + 1;
 
         // Get the two segments shared by the current point
-        Vector2f p0 = (i == 0) ? m_vertices[count].position : m_vertices[index - 1].position;
         Vector2f p1 = m_vertices[index].position;
         Vector2f p2 = m_vertices[index + 1].position;
 
-        // Compute their normal
-        Vector2f n1 = computeNormal(p0, p1);
+        // Get their normal
+        Vector2f n1 = nextNormal;
         Vector2f n2 = computeNormal(p1, p2);
+        nextNormal = n2;
 
         // Make sure that the normals point towards the outside of the shape
         // (this depends on the order in which the points were defined)
-        if (dotProduct(n1, m_vertices[0].position - p1) > 0)
+        if (dotProduct(n1, center - p1) > 0)
             n1 = -n1;
-        if (dotProduct(n2, m_vertices[0].position - p1) > 0)
+        if (dotProduct(n2, center - p1) > 0)
             n2 = -n2;
 
         // Combine them to get the extrusion direction
@@ -296,7 +372,7 @@ void Shape::updateOutline()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateOutlineColors()
+void Shape::updateOutlineColors() const
 {
     for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
         m_outlineVertices[i].color = m_outlineColor;
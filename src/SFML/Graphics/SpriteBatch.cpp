@@ -0,0 +1,446 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/ParallelFor.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+
+namespace
+{
+    // Attributes of a sprite that can be invalidated
+    enum DirtyFlags
+    {
+        PositionsDirty = 1 << 0,
+        TexCoordsDirty = 1 << 1,
+        ColorsDirty    = 1 << 2,
+        AllDirty       = PositionsDirty | TexCoordsDirty | ColorsDirty
+    };
+
+    // Minimum number of sprites worth handing to a separate thread
+    const std::size_t updateGrain = 4096;
+
+    // Regenerates the vertices of the modified sprites of a batch
+    struct VertexUpdater
+    {
+        void operator()(std::size_t begin, std::size_t end) const
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                sf::Uint8 flags = dirty[i];
+                if (!flags)
+                    continue;
+
+                sf::Vertex* quad = vertices + i * 6;
+                const sf::IntRect& rect = textureRects[i];
+
+                if (flags & PositionsDirty)
+                {
+                    // Same computation as sf::Transformable, applied to the corners directly
+                    float angle  = -rotations[i] * 3.141592654f / 180.f;
+                    float cosine = static_cast<float>(std::cos(angle));
+                    float sine   = static_cast<float>(std::sin(angle));
+                    float sxc    = scales[i].x * cosine;
+                    float syc    = scales[i].y * cosine;
+                    float sxs    = scales[i].x * sine;
+                    float sys    = scales[i].y * sine;
+                    float tx     = -origins[i].x * sxc - origins[i].y * sys + positions[i].x;
+                    float ty     =  origins[i].x * sxs - origins[i].y * syc + positions[i].y;
+
+                    float width  = static_cast<float>(std::abs(rect.width));
+                    float height = static_cast<float>(std::abs(rect.height));
+
+                    sf::Vector2f topLeft(tx, ty);
+                    sf::Vector2f bottomLeft(sys * height + tx, syc * height + ty);
+                    sf::Vector2f topRight(sxc * width + tx, -sxs * width + ty);
+                    sf::Vector2f bottomRight(bottomLeft + topRight - topLeft);
+
+                    quad[0].position = topLeft;
+                    quad[1].position = bottomLeft;
+                    quad[2].position = topRight;
+                    quad[3].position = topRight;
+                    quad[4].position = bottomLeft;
+                    quad[5].position = bottomRight;
+                }
+
+                if (flags & TexCoordsDirty)
+                {
+                    float left   = static_cast<float>(rect.left);
+                    float right  = left + rect.width;
+                    float top    = static_cast<float>(rect.top);
+                    float bottom = top + rect.height;
+
+                    quad[0].texCoords = sf::Vector2f(left, top);
+                    quad[1].texCoords = sf::Vector2f(left, bottom);
+                    quad[2].texCoords = sf::Vector2f(right, top);
+                    quad[3].texCoords = sf::Vector2f(right, top);
+                    quad[4].texCoords = sf::Vector2f(left, bottom);
+                    quad[5].texCoords = sf::Vector2f(right, bottom);
+                }
+
+                if (flags & ColorsDirty)
+                {
+                    for (int j = 0; j < 6; ++j)
+                        quad[j].color = colors[i];
+                }
+
+                dirty[i] = 0;
+            }
+        }
+
+        const sf::Vector2f* positions;
+        const float*        rotations;
+        const sf::Vector2f* scales;
+        const sf::Vector2f* origins;
+        const sf::IntRect*  textureRects;
+        const sf::Color*    colors;
+        sf::Uint8*          dirty;
+        sf::Vertex*         vertices;
+    };
+
+    // Remove the element at the given index by moving the last one in its place
+    template <typename T>
+    void swapRemove(std::vector<T>& array, std::size_t index)
+    {
+        array[index] = array.back();
+        array.pop_back();
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_batches    (),
+m_locations  (),
+m_freeIds    (),
+m_spriteCount(0),
+m_threadCount(1)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const Texture& texture, const Vector2f& position)
+{
+    return add(texture, IntRect(0, 0, texture.getSize().x, texture.getSize().y), position);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const Texture& texture, const IntRect& textureRect, const Vector2f& position)
+{
+    // Find the batch of the texture, or create it
+    std::size_t batchIndex = 0;
+    while ((batchIndex < m_batches.size()) && (m_batches[batchIndex].texture != &texture))
+        ++batchIndex;
+
+    if (batchIndex == m_batches.size())
+    {
+        m_batches.push_back(Batch());
+        m_batches.back().texture = &texture;
+        m_batches.back().needsUpdate = false;
+    }
+
+    Batch& batch = m_batches[batchIndex];
+
+    // Allocate an identifier
+    std::size_t id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = m_locations.size();
+        m_locations.push_back(Location());
+    }
+
+    m_locations[id].batch = batchIndex;
+    m_locations[id].index = batch.positions.size();
+
+    // Append the sprite to the batch
+    batch.positions.push_back(position);
+    batch.rotations.push_back(0.f);
+    batch.scales.push_back(Vector2f(1.f, 1.f));
+    batch.origins.push_back(Vector2f(0.f, 0.f));
+    batch.textureRects.push_back(textureRect);
+    batch.colors.push_back(Color::White);
+    batch.ids.push_back(id);
+    batch.dirty.push_back(AllDirty);
+    batch.vertices.resize(batch.vertices.size() + 6);
+    batch.needsUpdate = true;
+
+    ++m_spriteCount;
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::remove(std::size_t sprite)
+{
+    assert(sprite < m_locations.size());
+
+    Location location = m_locations[sprite];
+    Batch& batch = m_batches[location.batch];
+    std::size_t index = location.index;
+    std::size_t last = batch.positions.size() - 1;
+
+    // Move the last sprite of the batch in place of the removed one
+    if (index != last)
+    {
+        for (int j = 0; j < 6; ++j)
+            batch.vertices[index * 6 + j] = batch.vertices[last * 6 + j];
+
+        m_locations[batch.ids[last]].index = index;
+    }
+
+    swapRemove(batch.positions, index);
+    swapRemove(batch.rotations, index);
+    swapRemove(batch.scales, index);
+    swapRemove(batch.origins, index);
+    swapRemove(batch.textureRects, index);
+    swapRemove(batch.colors, index);
+    swapRemove(batch.ids, index);
+    swapRemove(batch.dirty, index);
+    batch.vertices.resize(batch.vertices.size() - 6);
+
+    m_freeIds.push_back(sprite);
+    --m_spriteCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_batches.clear();
+    m_locations.clear();
+    m_freeIds.clear();
+    m_spriteCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getSpriteCount() const
+{
+    return m_spriteCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setPosition(std::size_t sprite, const Vector2f& position)
+{
+    const Location& location = m_locations[sprite];
+    m_batches[location.batch].positions[location.index] = position;
+    invalidate(sprite, PositionsDirty);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setRotation(std::size_t sprite, float angle)
+{
+    angle = static_cast<float>(std::fmod(angle, 360));
+    if (angle < 0)
+        angle += 360.f;
+
+    const Location& location = m_locations[sprite];
+    m_batches[location.batch].rotations[location.index] = angle;
+    invalidate(sprite, PositionsDirty);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setScale(std::size_t sprite, const Vector2f& factors)
+{
+    const Location& location = m_locations[sprite];
+    m_batches[location.batch].scales[location.index] = factors;
+    invalidate(sprite, PositionsDirty);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setOrigin(std::size_t sprite, const Vector2f& origin)
+{
+    const Location& location = m_locations[sprite];
+    m_batches[location.batch].origins[location.index] = origin;
+    invalidate(sprite, PositionsDirty);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTextureRect(std::size_t sprite, const IntRect& textureRect)
+{
+    const Location& location = m_locations[sprite];
+    m_batches[location.batch].textureRects[location.index] = textureRect;
+    invalidate(sprite, PositionsDirty | TexCoordsDirty);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setColor(std::size_t sprite, const Color& color)
+{
+    const Location& location = m_locations[sprite];
+    m_batches[location.batch].colors[location.index] = color;
+    invalidate(sprite, ColorsDirty);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::move(std::size_t sprite, const Vector2f& offset)
+{
+    setPosition(sprite, getPosition(sprite) + offset);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::rotate(std::size_t sprite, float angle)
+{
+    setRotation(sprite, getRotation(sprite) + angle);
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getPosition(std::size_t sprite) const
+{
+    const Location& location = m_locations[sprite];
+    return m_batches[location.batch].positions[location.index];
+}
+
+
+////////////////////////////////////////////////////////////
+float SpriteBatch::getRotation(std::size_t sprite) const
+{
+    const Location& location = m_locations[sprite];
+    return m_batches[location.batch].rotations[location.index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getScale(std::size_t sprite) const
+{
+    const Location& location = m_locations[sprite];
+    return m_batches[location.batch].scales[location.index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getOrigin(std::size_t sprite) const
+{
+    const Location& location = m_locations[sprite];
+    return m_batches[location.batch].origins[location.index];
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& SpriteBatch::getTextureRect(std::size_t sprite) const
+{
+    const Location& location = m_locations[sprite];
+    return m_batches[location.batch].textureRects[location.index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& SpriteBatch::getColor(std::size_t sprite) const
+{
+    const Location& location = m_locations[sprite];
+    return m_batches[location.batch].colors[location.index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& SpriteBatch::getTexture(std::size_t sprite) const
+{
+    return *m_batches[m_locations[sprite].batch].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setThreadCount(unsigned int count)
+{
+    m_threadCount = count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SpriteBatch::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    for (std::vector<Batch>::const_iterator it = m_batches.begin(); it != m_batches.end(); ++it)
+    {
+        const Batch& batch = *it;
+        if (batch.vertices.empty())
+            continue;
+
+        // Regenerate the vertices of the sprites that changed
+        if (batch.needsUpdate)
+        {
+            VertexUpdater updater;
+            updater.positions    = &batch.positions[0];
+            updater.rotations    = &batch.rotations[0];
+            updater.scales       = &batch.scales[0];
+            updater.origins      = &batch.origins[0];
+            updater.textureRects = &batch.textureRects[0];
+            updater.colors       = &batch.colors[0];
+            updater.dirty        = &batch.dirty[0];
+            updater.vertices     = &batch.vertices[0];
+
+            priv::parallelFor(batch.positions.size(), updateGrain, m_threadCount, updater);
+
+            batch.needsUpdate = false;
+        }
+
+        states.texture = batch.texture;
+        target.draw(&batch.vertices[0], batch.vertices.size(), Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::invalidate(std::size_t sprite, Uint8 flags)
+{
+    const Location& location = m_locations[sprite];
+    Batch& batch = m_batches[location.batch];
+
+    batch.dirty[location.index] |= flags;
+    batch.needsUpdate = true;
+}
+
+} // namespace sf
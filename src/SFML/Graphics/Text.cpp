@@ -28,11 +28,63 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 
 namespace
 {
+    // Fragment shader drawing distance field glyphs: the fill, the outline and the shadow
+    // are all derived from the distance to the glyph edge stored in the texture alpha channel
+    const char* distanceFieldShaderSource =
+        "uniform sampler2D texture;\n"
+        "uniform vec4 outlineColor;\n"
+        "uniform float outlineWidth;\n"
+        "uniform vec4 shadowColor;\n"
+        "uniform vec2 shadowOffset;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    // 0.5 on the glyph edge, more inside, less outside\n"
+        "    float distance = texture2D(texture, gl_TexCoord[0].xy).a;\n"
+        "\n"
+        "    // Antialias over about one pixel on screen, whatever the scale\n"
+        "    float smoothing = max(fwidth(distance) * 0.7, 0.0001);\n"
+        "    float edge = 0.5 - outlineWidth;\n"
+        "    float fill = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);\n"
+        "    float body = smoothstep(edge - smoothing, edge + smoothing, distance);\n"
+        "\n"
+        "    vec4 color = mix(outlineColor, gl_Color, fill);\n"
+        "    color.a *= body;\n"
+        "\n"
+        "    // The shadow is the outlined glyph, shifted and drawn behind it\n"
+        "    float shadowDistance = texture2D(texture, gl_TexCoord[0].xy - shadowOffset).a;\n"
+        "    float shadow = smoothstep(edge - smoothing, edge + smoothing, shadowDistance) * shadowColor.a;\n"
+        "\n"
+        "    float alpha = color.a + shadow * (1.0 - color.a);\n"
+        "    vec3 rgb = (color.rgb * color.a + shadowColor.rgb * shadow * (1.0 - color.a)) / max(alpha, 0.0001);\n"
+        "    gl_FragColor = vec4(rgb, alpha);\n"
+        "}\n";
+
+    // Get the shader that draws distance field glyphs, compiled on first use
+    // (returns NULL if shaders are not supported)
+    sf::Shader* getDistanceFieldShader()
+    {
+        static bool loaded = false;
+        static bool valid = false;
+        static sf::Shader shader;
+
+        if (!loaded)
+        {
+            loaded = true;
+            valid = sf::Shader::isAvailable() && shader.loadFromMemory(distanceFieldShaderSource, sf::Shader::Fragment);
+        }
+
+        return valid ? &shader : NULL;
+    }
+
     // Add an underline or strikethrough line to the vertex array
     void addLine(sf::VertexArray& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness, float outlineThickness = 0)
     {
@@ -47,6 +99,29 @@ namespace
         vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
     }
 
+    // Replace a range of vertices with new ones, moving the vertices that follow the range
+    void replaceVertices(sf::VertexArray& vertices, std::size_t begin, std::size_t count, const sf::VertexArray& replacement)
+    {
+        std::size_t size = vertices.getVertexCount();
+        std::size_t newCount = replacement.getVertexCount();
+
+        if (newCount > count)
+        {
+            vertices.resize(size + newCount - count);
+            sf::Vertex* data = &vertices[0];
+            std::copy_backward(data + begin + count, data + size, data + size + newCount - count);
+        }
+        else if (newCount < count)
+        {
+            sf::Vertex* data = &vertices[0];
+            std::copy(data + begin + count, data + size, data + begin + newCount);
+            vertices.resize(size + newCount - count);
+        }
+
+        if (newCount > 0)
+            std::copy(&replacement[0], &replacement[0] + newCount, &vertices[begin]);
+    }
+
     // Add a glyph quad to the vertex array
     void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italic, float outlineThickness = 0)
     {
@@ -74,17 +149,26 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Text::Text() :
-m_string            (),
-m_font              (NULL),
-m_characterSize     (30),
-m_style             (Regular),
-m_fillColor         (255, 255, 255),
-m_outlineColor      (0, 0, 0),
-m_outlineThickness  (0),
-m_vertices          (Triangles),
-m_outlineVertices   (Triangles),
-m_bounds            (),
-m_geometryNeedUpdate(false)
+m_string               (),
+m_font                 (NULL),
+m_characterSize        (30),
+m_style                (Regular),
+m_fillColor            (255, 255, 255),
+m_outlineColor         (0, 0, 0),
+m_outlineThickness     (0),
+m_distanceField        (false),
+m_shadowColor          (0, 0, 0),
+m_shadowOffset         (0, 0),
+m_vertices             (Triangles),
+m_outlineVertices      (Triangles),
+m_bounds               (),
+m_geometryNeedUpdate   (false),
+m_lines                (),
+m_positions            (),
+m_layoutSize           (0),
+m_unchangedPrefix      (0),
+m_unchangedSuffix      (0),
+m_fontTextureGeneration(0)
 {
 
 }
@@ -92,17 +176,26 @@ m_geometryNeedUpdate(false)
 
 ////////////////////////////////////////////////////////////
 Text::Text(const String& string, const Font& font, unsigned int characterSize) :
-m_string            (string),
-m_font              (&font),
-m_characterSize     (characterSize),
-m_style             (Regular),
-m_fillColor         (255, 255, 255),
-m_outlineColor      (0, 0, 0),
-m_outlineThickness  (0),
-m_vertices          (Triangles),
-m_outlineVertices   (Triangles),
-m_bounds            (),
-m_geometryNeedUpdate(true)
+m_string               (string),
+m_font                 (&font),
+m_characterSize        (characterSize),
+m_style                (Regular),
+m_fillColor            (255, 255, 255),
+m_outlineColor         (0, 0, 0),
+m_outlineThickness     (0),
+m_distanceField        (false),
+m_shadowColor          (0, 0, 0),
+m_shadowOffset         (0, 0),
+m_vertices             (Triangles),
+m_outlineVertices      (Triangles),
+m_bounds               (),
+m_geometryNeedUpdate   (true),
+m_lines                (),
+m_positions            (),
+m_layoutSize           (0),
+m_unchangedPrefix      (0),
+m_unchangedSuffix      (0),
+m_fontTextureGeneration(0)
 {
 
 }
@@ -113,8 +206,26 @@ void Text::setString(const String& string)
 {
     if (m_string != string)
     {
+        // Find the part of the string that changed, so that only the lines it covers are laid out again
+        std::size_t oldSize = m_string.getSize();
+        std::size_t newSize = string.getSize();
+        std::size_t maxSize = std::min(oldSize, newSize);
+        const Uint32* oldData = m_string.getData();
+        const Uint32* newData = string.getData();
+
+        std::size_t prefix = 0;
+        while ((prefix < maxSize) && (oldData[prefix] == newData[prefix]))
+            ++prefix;
+
+        std::size_t suffix = 0;
+        while ((suffix < maxSize - prefix) && (oldData[oldSize - suffix - 1] == newData[newSize - suffix - 1]))
+            ++suffix;
+
+        // Several changes may happen before the next update: keep the part that none of them touched
+        m_unchangedPrefix = std::min(m_unchangedPrefix, prefix);
+        m_unchangedSuffix = std::min(m_unchangedSuffix, suffix);
+
         m_string = string;
-        m_geometryNeedUpdate = true;
     }
 }
 
@@ -206,6 +317,31 @@ void Text::setOutlineThickness(float thickness)
 }
 
 
+////////////////////////////////////////////////////////////
+void Text::setDistanceFieldEnabled(bool enabled)
+{
+    if (enabled != m_distanceField)
+    {
+        m_distanceField = enabled;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setShadowColor(const Color& color)
+{
+    m_shadowColor = color;
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setShadowOffset(const Vector2f& offset)
+{
+    m_shadowOffset = offset;
+}
+
+
 ////////////////////////////////////////////////////////////
 const String& Text::getString() const
 {
@@ -262,6 +398,27 @@ float Text::getOutlineThickness() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Text::isDistanceFieldEnabled() const
+{
+    return m_distanceField;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& Text::getShadowColor() const
+{
+    return m_shadowColor;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& Text::getShadowOffset() const
+{
+    return m_shadowOffset;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2f Text::findCharacterPos(std::size_t index) const
 {
@@ -269,36 +426,19 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (!m_font)
         return Vector2f();
 
-    // Adjust the index if it's out of range
-    if (index > m_string.getSize())
-        index = m_string.getSize();
-
-    // Precompute the variables needed by the algorithm
-    bool  bold   = (m_style & Bold) != 0;
-    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
-    float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
+    // The positions are computed by the layout
+    ensureGeometryUpdate();
 
     // Compute the position
     Vector2f position;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < index; ++i)
+    if (!m_lines.empty())
     {
-        Uint32 curChar = m_string[i];
-
-        // Apply the kerning offset
-        position.x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
-        prevChar = curChar;
+        // Adjust the index if it's out of range
+        if (index > m_string.getSize())
+            index = m_string.getSize();
 
-        // Handle special characters
-        switch (curChar)
-        {
-            case ' ':  position.x += hspace;                 continue;
-            case '\t': position.x += hspace * 4;             continue;
-            case '\n': position.y += vspace; position.x = 0; continue;
-        }
-
-        // For regular characters, add the advance offset of the glyph
-        position.x += static_cast<float>(m_font->getGlyph(curChar, m_characterSize, bold).advance);
+        position.x = m_positions[index];
+        position.y = static_cast<float>(findLine(index)) * getLineSpacing();
     }
 
     // Transform the position to global coordinates
@@ -308,6 +448,41 @@ Vector2f Text::findCharacterPos(std::size_t index) const
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t Text::findCharacterIndex(const Vector2f& point) const
+{
+    // Make sure that we have a valid font
+    if (!m_font)
+        return 0;
+
+    // The positions are computed by the layout
+    ensureGeometryUpdate();
+
+    if (m_lines.empty())
+        return 0;
+
+    // Transform the point to local coordinates
+    Vector2f position = getInverseTransform().transformPoint(point);
+
+    // Find the line under the point
+    float lineNumber = std::floor(position.y / getLineSpacing());
+    lineNumber = std::max(0.f, std::min(lineNumber, static_cast<float>(m_lines.size() - 1)));
+    const Line& line = m_lines[static_cast<std::size_t>(lineNumber)];
+
+    // Find the first position of the line on the right of the point (the line break
+    // ending the line is the last candidate, as the caret can't go past it)
+    std::size_t last = ((line.end > line.begin) && (m_string[line.end - 1] == '\n')) ? line.end - 1 : line.end;
+    std::size_t index = std::upper_bound(m_positions.begin() + line.begin, m_positions.begin() + last + 1, position.x) - m_positions.begin();
+
+    // Take the closest of this position and the previous one
+    if (index > last)
+        return last;
+    if ((index > line.begin) && (position.x - m_positions[index - 1] < m_positions[index] - position.x))
+        return index - 1;
+    return index;
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Text::getLocalBounds() const
 {
@@ -334,6 +509,31 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         states.transform *= getTransform();
         states.texture = &m_font->getTexture(m_characterSize);
 
+        if (usesDistanceField())
+        {
+            // Convert the outline and shadow to distance field units: pixels at the font's
+            // reference size, limited to the range of the field
+            float scale  = static_cast<float>(m_font->getDistanceFieldSize()) / static_cast<float>(m_characterSize);
+            float spread = m_font->getDistanceFieldSpread();
+            float outline = std::min(std::abs(m_outlineThickness) * scale, spread);
+            Vector2f shadowOffset(std::max(-spread, std::min(m_shadowOffset.x * scale, spread)),
+                                  std::max(-spread, std::min(m_shadowOffset.y * scale, spread)));
+
+            Vector2u textureSize = states.texture->getSize();
+            bool hasShadow = (m_shadowOffset.x != 0) || (m_shadowOffset.y != 0);
+
+            Shader* shader = getDistanceFieldShader();
+            shader->setUniform("texture", Shader::CurrentTexture);
+            shader->setUniform("outlineColor", Glsl::Vec4(outline > 0 ? m_outlineColor : m_fillColor));
+            shader->setUniform("outlineWidth", outline / (2.f * spread));
+            shader->setUniform("shadowColor", Glsl::Vec4(hasShadow ? m_shadowColor : Color::Transparent));
+            shader->setUniform("shadowOffset", Glsl::Vec2(shadowOffset.x / textureSize.x, shadowOffset.y / textureSize.y));
+            states.shader = shader;
+
+            target.draw(m_vertices, states);
+            return;
+        }
+
         // Only draw the outline if there is something to draw
         if (m_outlineThickness != 0)
             target.draw(m_outlineVertices, states);
@@ -343,167 +543,385 @@ void Text::draw(RenderTarget& target, RenderStates states) const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Text::usesDistanceField() const
+{
+    return m_distanceField && m_font && getDistanceFieldShader();
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Text::getDisplayGlyph(Uint32 codePoint, bool bold) const
+{
+    if (!usesDistanceField())
+        return m_font->getGlyph(codePoint, m_characterSize, bold);
+
+    // Scale the glyph from the reference size to the character size
+    Glyph glyph = m_font->getDistanceFieldGlyph(codePoint, bold);
+    float scale = static_cast<float>(m_characterSize) / static_cast<float>(m_font->getDistanceFieldSize());
+    glyph.advance       *= scale;
+    glyph.bounds.left   *= scale;
+    glyph.bounds.top    *= scale;
+    glyph.bounds.width  *= scale;
+    glyph.bounds.height *= scale;
+
+    return glyph;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Text::ensureGeometryUpdate() const
 {
-    // Do nothing, if geometry has not changed
-    if (!m_geometryNeedUpdate)
+    // Glyphs may have moved in the font texture since the last update
+    if (m_font && (m_font->getTextureGeneration() != m_fontTextureGeneration))
+        m_geometryNeedUpdate = true;
+
+    // Do nothing, if neither the geometry nor the string have changed
+    bool stringChanged = (m_unchangedPrefix < m_layoutSize) || (m_string.getSize() != m_layoutSize);
+    if (!m_geometryNeedUpdate && !stringChanged)
         return;
 
+    // If only the string changed, we can lay out again just the lines that changed
+    bool incremental = !m_geometryNeedUpdate && !m_lines.empty();
+
     // Mark geometry as updated
     m_geometryNeedUpdate = false;
+    if (m_font)
+        m_fontTextureGeneration = m_font->getTextureGeneration();
 
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_outlineVertices.clear();
-    m_bounds = FloatRect();
+    std::size_t layoutSize = m_layoutSize;
+    std::size_t prefix     = m_unchangedPrefix;
+    std::size_t suffix     = m_unchangedSuffix;
+    m_layoutSize      = m_string.getSize();
+    m_unchangedPrefix = m_layoutSize;
+    m_unchangedSuffix = m_layoutSize;
 
     // No font or text: nothing to draw
     if (!m_font || m_string.isEmpty())
+    {
+        m_vertices.clear();
+        m_outlineVertices.clear();
+        m_lines.clear();
+        m_positions.clear();
+        m_bounds = FloatRect();
         return;
+    }
+
+    if (incremental)
+    {
+        // Find the lines covered by the part of the string that changed
+        std::size_t first = findLine(prefix);
+        std::size_t last  = findLine(layoutSize - suffix);
+
+        // The empty line that follows a final line break is laid out along with the line before it
+        if (m_lines[last].end == layoutSize)
+            last = m_lines.size() - 1;
+
+        std::size_t begin = m_lines[first].begin;
+        std::size_t end   = m_lines[last].end + m_layoutSize - layoutSize;
+
+        // Lay them out again
+        std::vector<Line> lines;
+        VertexArray vertices(Triangles);
+        VertexArray outlineVertices(Triangles);
+        std::vector<float> positions;
+        layoutLines(begin, end, first, lines, vertices, outlineVertices, positions);
+
+        // Replace the positions of their characters (the end of the string has one too)
+        std::size_t positionCount = m_lines[last].end - begin + (m_lines[last].end == layoutSize ? 1 : 0);
+        m_positions.erase(m_positions.begin() + begin, m_positions.begin() + begin + positionCount);
+        m_positions.insert(m_positions.begin() + begin, positions.begin(), positions.end());
+
+        // Replace their geometry
+        std::size_t vertexBegin        = m_lines[first].vertexBegin;
+        std::size_t vertexCount        = m_lines[last].vertexBegin + m_lines[last].vertexCount - vertexBegin;
+        std::size_t outlineVertexBegin = m_lines[first].outlineVertexBegin;
+        std::size_t outlineVertexCount = m_lines[last].outlineVertexBegin + m_lines[last].outlineVertexCount - outlineVertexBegin;
+        replaceVertices(m_vertices, vertexBegin, vertexCount, vertices);
+        replaceVertices(m_outlineVertices, outlineVertexBegin, outlineVertexCount, outlineVertices);
+
+        for (std::vector<Line>::iterator line = lines.begin(); line != lines.end(); ++line)
+        {
+            line->vertexBegin += vertexBegin;
+            line->outlineVertexBegin += outlineVertexBegin;
+        }
+
+        // Move the following lines down or up if line breaks were added or removed
+        // (unsigned arithmetic wraps around, so adding the size difference works for both)
+        float offset = (static_cast<float>(lines.size()) - static_cast<float>(last + 1 - first)) * getLineSpacing();
+        for (std::size_t i = last + 1; i < m_lines.size(); ++i)
+        {
+            Line& line = m_lines[i];
+            line.begin              += m_layoutSize - layoutSize;
+            line.end                += m_layoutSize - layoutSize;
+            line.vertexBegin        += vertices.getVertexCount() - vertexCount;
+            line.outlineVertexBegin += outlineVertices.getVertexCount() - outlineVertexCount;
+            line.minY               += offset;
+            line.maxY               += offset;
+        }
+
+        if (offset != 0)
+        {
+            for (std::size_t i = vertexBegin + vertices.getVertexCount(); i < m_vertices.getVertexCount(); ++i)
+                m_vertices[i].position.y += offset;
+            for (std::size_t i = outlineVertexBegin + outlineVertices.getVertexCount(); i < m_outlineVertices.getVertexCount(); ++i)
+                m_outlineVertices[i].position.y += offset;
+        }
+
+        m_lines.erase(m_lines.begin() + first, m_lines.begin() + last + 1);
+        m_lines.insert(m_lines.begin() + first, lines.begin(), lines.end());
+    }
+    else
+    {
+        // Lay out the whole string
+        m_vertices.clear();
+        m_outlineVertices.clear();
+        m_lines.clear();
+        m_positions.clear();
+        layoutLines(0, m_string.getSize(), 0, m_lines, m_vertices, m_outlineVertices, m_positions);
+    }
+
+    // Update the bounding rectangle
+    float minX = static_cast<float>(m_characterSize);
+    float minY = static_cast<float>(m_characterSize);
+    float maxX = 0.f;
+    float maxY = 0.f;
+    for (std::vector<Line>::const_iterator line = m_lines.begin(); line != m_lines.end(); ++line)
+    {
+        minX = std::min(minX, line->minX);
+        minY = std::min(minY, line->minY);
+        maxX = std::max(maxX, line->maxX);
+        maxY = std::max(maxY, line->maxY);
+    }
+
+    m_bounds.left = minX;
+    m_bounds.top = minY;
+    m_bounds.width = maxX - minX;
+    m_bounds.height = maxY - minY;
 
+    // Loading new glyphs may have evicted others and moved the ones we already used: start over
+    if (m_font->getTextureGeneration() != m_fontTextureGeneration)
+        ensureGeometryUpdate();
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::layoutLines(std::size_t begin, std::size_t end, std::size_t firstLine, std::vector<Line>& lines, VertexArray& vertices, VertexArray& outlineVertices, std::vector<float>& positions) const
+{
     // Compute values related to the text style
     bool  bold               = (m_style & Bold) != 0;
     bool  underlined         = (m_style & Underlined) != 0;
     bool  strikeThrough      = (m_style & StrikeThrough) != 0;
     float italic             = (m_style & Italic) ? 0.208f : 0.f; // 12 degrees
-    float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
-    float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
+
+    // Distance field glyphs are measured at the reference size of the font, then scaled;
+    // their quads have a margin where the field fades out, and their outline is drawn by the shader
+    bool         distanceField    = usesDistanceField();
+    unsigned int metricsSize      = distanceField ? m_font->getDistanceFieldSize() : m_characterSize;
+    float        scale            = static_cast<float>(m_characterSize) / static_cast<float>(metricsSize);
+    float        margin           = distanceField ? m_font->getDistanceFieldSpread() * scale : 0.f;
+    float        outlineThickness = distanceField ? 0.f : m_outlineThickness;
+
+    float underlineOffset    = m_font->getUnderlinePosition(metricsSize) * scale;
+    float underlineThickness = m_font->getUnderlineThickness(metricsSize) * scale;
 
     // Compute the location of the strike through dynamically
     // We use the center point of the lowercase 'x' glyph as the reference
     // We reuse the underline thickness as the thickness of the strike through as well
-    FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, bold).bounds;
+    FloatRect xBounds = getDisplayGlyph(L'x', bold).bounds;
     float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
 
     // Precompute the variables needed by the algorithm
-    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
-    float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
-    float x      = 0.f;
-    float y      = static_cast<float>(m_characterSize);
+    float hspace = getDisplayGlyph(L' ', bold).advance;
+    float vspace = getLineSpacing();
 
-    // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    // Lay out the lines one after the other
+    std::size_t i = begin;
+    std::size_t lineNumber = firstLine;
+    for (;;)
     {
-        Uint32 curChar = m_string[i];
+        float x = 0.f;
+        float y = static_cast<float>(m_characterSize) + static_cast<float>(lineNumber) * vspace;
+
+        Line line;
+        line.begin              = i;
+        line.vertexBegin        = vertices.getVertexCount();
+        line.outlineVertexBegin = outlineVertices.getVertexCount();
+        line.minX               = std::numeric_limits<float>::max();
+        line.minY               = std::numeric_limits<float>::max();
+        line.maxX               = -std::numeric_limits<float>::max();
+        line.maxY               = -std::numeric_limits<float>::max();
+
+        // Create one quad for each character
+        bool lineBreak = false;
+        Uint32 prevChar = (i > 0) ? m_string[i - 1] : 0;
+        for (; (i < end) && !lineBreak; ++i)
+        {
+            Uint32 curChar = m_string[i];
 
-        // Apply the kerning offset
-        x += m_font->getKerning(prevChar, curChar, m_characterSize);
-        prevChar = curChar;
+            // Remember the position of the character, for findCharacterPos
+            positions.push_back(x);
 
-        // If we're using the underlined style and there's a new line, draw a line
-        if (underlined && (curChar == L'\n'))
-        {
-            addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+            // Apply the kerning offset
+            x += m_font->getKerning(prevChar, curChar, metricsSize) * scale;
+            prevChar = curChar;
 
-            if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
-        }
+            // If we're using the underlined style and there's a new line, draw a line
+            if (underlined && (curChar == L'\n'))
+            {
+                addLine(vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
 
-        // If we're using the strike through style and there's a new line, draw a line across all characters
-        if (strikeThrough && (curChar == L'\n'))
-        {
-            addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+                if (outlineThickness != 0)
+                    addLine(outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, outlineThickness);
+            }
 
-            if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
-        }
+            // If we're using the strike through style and there's a new line, draw a line across all characters
+            if (strikeThrough && (curChar == L'\n'))
+            {
+                addLine(vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
 
-        // Handle special characters
-        if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
-        {
-            // Update the current bounds (min coordinates)
-            minX = std::min(minX, x);
-            minY = std::min(minY, y);
+                if (outlineThickness != 0)
+                    addLine(outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, outlineThickness);
+            }
 
-            switch (curChar)
+            // Handle special characters
+            if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
             {
-                case ' ':  x += hspace;        break;
-                case '\t': x += hspace * 4;    break;
-                case '\n': y += vspace; x = 0; break;
+                // Update the current bounds (min coordinates)
+                line.minX = std::min(line.minX, x);
+                line.minY = std::min(line.minY, y);
+
+                switch (curChar)
+                {
+                    case ' ':  x += hspace;                           break;
+                    case '\t': x += hspace * 4;                       break;
+                    case '\n': y += vspace; x = 0; lineBreak = true; break;
+                }
+
+                // Update the current bounds (max coordinates)
+                line.maxX = std::max(line.maxX, x);
+                line.maxY = std::max(line.maxY, y);
+
+                // Next glyph, no need to create a quad for whitespace
+                continue;
             }
 
-            // Update the current bounds (max coordinates)
-            maxX = std::max(maxX, x);
-            maxY = std::max(maxY, y);
+            // Apply the outline
+            if (outlineThickness != 0)
+            {
+                const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold, outlineThickness);
 
-            // Next glyph, no need to create a quad for whitespace
-            continue;
-        }
+                float left   = glyph.bounds.left;
+                float top    = glyph.bounds.top;
+                float right  = glyph.bounds.left + glyph.bounds.width;
+                float bottom = glyph.bounds.top  + glyph.bounds.height;
 
-        
-        // Apply the outline
-        if (m_outlineThickness != 0)
-        {
-            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold, m_outlineThickness);
+                // Add the outline glyph to the vertices
+                addGlyphQuad(outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italic, outlineThickness);
 
-            float left   = glyph.bounds.left;
-            float top    = glyph.bounds.top;
-            float right  = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top  + glyph.bounds.height;
+                // Update the current bounds with the outlined glyph bounds
+                line.minX = std::min(line.minX, x + left   - italic * bottom - outlineThickness);
+                line.maxX = std::max(line.maxX, x + right  - italic * top    - outlineThickness);
+                line.minY = std::min(line.minY, y + top    - outlineThickness);
+                line.maxY = std::max(line.maxY, y + bottom - outlineThickness);
+            }
 
-            // Add the outline glyph to the vertices
-            addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italic, m_outlineThickness);
+            // Extract the current glyph's description
+            Glyph glyph = getDisplayGlyph(curChar, bold);
 
-            // Update the current bounds with the outlined glyph bounds
-            minX = std::min(minX, x + left   - italic * bottom - m_outlineThickness);
-            maxX = std::max(maxX, x + right  - italic * top    - m_outlineThickness);
-            minY = std::min(minY, y + top    - m_outlineThickness);
-            maxY = std::max(maxY, y + bottom - m_outlineThickness);
-        }
+            // Add the glyph to the vertices
+            addGlyphQuad(vertices, Vector2f(x, y), m_fillColor, glyph, italic);
 
-        // Extract the current glyph's description
-        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
+            // Update the current bounds with the non outlined glyph bounds
+            if (outlineThickness == 0)
+            {
+                // The outline drawn by the distance field shader extends into the margin
+                float inset = distanceField ? margin - std::min(std::abs(m_outlineThickness), margin) : 0.f;
+
+                float left   = glyph.bounds.left + inset;
+                float top    = glyph.bounds.top  + inset;
+                float right  = glyph.bounds.left + glyph.bounds.width  - inset;
+                float bottom = glyph.bounds.top  + glyph.bounds.height - inset;
+
+                line.minX = std::min(line.minX, x + left  - italic * bottom);
+                line.maxX = std::max(line.maxX, x + right - italic * top);
+                line.minY = std::min(line.minY, y + top);
+                line.maxY = std::max(line.maxY, y + bottom);
+            }
 
-        // Add the glyph to the vertices
-        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italic);
+            // Advance to the next character
+            x += glyph.advance;
+        }
 
-        // Update the current bounds with the non outlined glyph bounds
-        if (m_outlineThickness == 0)
+        // The last line of the string has no line break: draw its underline and strike through here
+        if (!lineBreak)
         {
-            float left   = glyph.bounds.left;
-            float top    = glyph.bounds.top;
-            float right  = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top  + glyph.bounds.height;
-
-            minX = std::min(minX, x + left  - italic * bottom);
-            maxX = std::max(maxX, x + right - italic * top);
-            minY = std::min(minY, y + top);
-            maxY = std::max(maxY, y + bottom);
+            // Remember the position of the end of the string
+            positions.push_back(x);
+
+            // If we're using the underlined style, add the last line
+            if (underlined && (x > 0))
+            {
+                addLine(vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+
+                if (outlineThickness != 0)
+                    addLine(outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, outlineThickness);
+            }
+
+            // If we're using the strike through style, add the last line across all characters
+            if (strikeThrough && (x > 0))
+            {
+                addLine(vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+
+                if (outlineThickness != 0)
+                    addLine(outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, outlineThickness);
+            }
         }
 
-        // Advance to the next character
-        x += glyph.advance;
+        line.end                = i;
+        line.vertexCount        = vertices.getVertexCount() - line.vertexBegin;
+        line.outlineVertexCount = outlineVertices.getVertexCount() - line.outlineVertexBegin;
+        lines.push_back(line);
+        ++lineNumber;
+
+        // Stop at the end of the range, unless the string ends with a line break: it is followed by an empty line
+        if ((i == end) && (!lineBreak || (end < m_string.getSize())))
+            break;
     }
+}
 
-    // If we're using the underlined style, add the last line
-    if (underlined && (x > 0))
-    {
-        addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+////////////////////////////////////////////////////////////
+std::size_t Text::findLine(std::size_t index) const
+{
+    // Find the last line that starts before the character
+    std::size_t first = 0;
+    std::size_t count = m_lines.size();
+    while (count > 1)
+    {
+        std::size_t half = count / 2;
+        if (m_lines[first + half].begin <= index)
+        {
+            first += half;
+            count -= half;
+        }
+        else
+        {
+            count = half;
+        }
     }
 
-    // If we're using the strike through style, add the last line across all characters
-    if (strikeThrough && (x > 0))
-    {
-        addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+    return first;
+}
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
-    }
 
-    // Update the bounding rectangle
-    m_bounds.left = minX;
-    m_bounds.top = minY;
-    m_bounds.width = maxX - minX;
-    m_bounds.height = maxY - minY;
+////////////////////////////////////////////////////////////
+float Text::getLineSpacing() const
+{
+    unsigned int metricsSize = usesDistanceField() ? m_font->getDistanceFieldSize() : m_characterSize;
+    float        scale       = static_cast<float>(m_characterSize) / static_cast<float>(metricsSize);
+
+    return m_font->getLineSpacing(metricsSize) * scale;
 }
 
 } // namespace sf
@@ -53,6 +53,81 @@ namespace
 
         return id++;
     }
+
+    // Get the OpenGL extension that a pixel format requires and
+    // that is unavailable, or NULL if the format is supported
+    const char* getMissingExtension(sf::Image::PixelFormat format)
+    {
+        bool rg        = GLEXT_texture_rg;
+        bool floats    = GLEXT_texture_float;
+        bool halfFloat = GLEXT_half_float_pixel;
+
+        switch (format)
+        {
+            case sf::Image::R8:
+            case sf::Image::RG8:
+                return rg ? NULL : "ARB_texture_rg";
+
+            case sf::Image::R16F:
+                if (!rg)
+                    return "ARB_texture_rg";
+                return floats ? (halfFloat ? NULL : "ARB_half_float_pixel") : "ARB_texture_float";
+
+            case sf::Image::RGBA16F:
+                return floats ? (halfFloat ? NULL : "ARB_half_float_pixel") : "ARB_texture_float";
+
+            case sf::Image::RGBA32F:
+                return floats ? NULL : "ARB_texture_float";
+
+            default:
+                return NULL;
+        }
+    }
+
+    // Get the OpenGL internal format, format and type of a pixel format;
+    // sRGB internal formats only exist for RGBA8 and RGB8
+    void getGlFormat(sf::Image::PixelFormat format, bool sRgb, GLint& internalFormat, GLenum& pixelFormat, GLenum& type)
+    {
+        switch (format)
+        {
+            case sf::Image::R8:       internalFormat = GLEXT_GL_R8;      pixelFormat = GLEXT_GL_RED; type = GL_UNSIGNED_BYTE;                 break;
+            case sf::Image::RG8:      internalFormat = GLEXT_GL_RG8;     pixelFormat = GLEXT_GL_RG;  type = GL_UNSIGNED_BYTE;                 break;
+            case sf::Image::RGB8:     internalFormat = sRgb ? GLEXT_GL_SRGB8 : GLEXT_GL_RGB8;
+                                                                         pixelFormat = GL_RGB;       type = GL_UNSIGNED_BYTE;                 break;
+            case sf::Image::RGB565:   internalFormat = GLEXT_GL_RGB5;    pixelFormat = GL_RGB;       type = GLEXT_GL_UNSIGNED_SHORT_5_6_5;    break;
+            case sf::Image::RGBA4444: internalFormat = GLEXT_GL_RGBA4;   pixelFormat = GL_RGBA;      type = GLEXT_GL_UNSIGNED_SHORT_4_4_4_4;  break;
+            case sf::Image::R16F:     internalFormat = GLEXT_GL_R16F;    pixelFormat = GLEXT_GL_RED; type = GLEXT_GL_HALF_FLOAT;              break;
+            case sf::Image::RGBA16F:  internalFormat = GLEXT_GL_RGBA16F; pixelFormat = GL_RGBA;      type = GLEXT_GL_HALF_FLOAT;              break;
+            case sf::Image::RGBA32F:  internalFormat = GLEXT_GL_RGBA32F; pixelFormat = GL_RGBA;      type = GL_FLOAT;                         break;
+            default:                  internalFormat = sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA;
+                                                                         pixelFormat = GL_RGBA;      type = GL_UNSIGNED_BYTE;                 break;
+        }
+    }
+
+    // Make pixel transfers use tightly packed rows, as in sf::Image,
+    // and restore the previous row alignment when going out of scope
+    class RowAlignmentSaver
+    {
+    public:
+
+        explicit RowAlignmentSaver(GLenum parameter) :
+        m_parameter(parameter),
+        m_alignment(4)
+        {
+            glCheck(glGetIntegerv(m_parameter, &m_alignment));
+            glCheck(glPixelStorei(m_parameter, 1));
+        }
+
+        ~RowAlignmentSaver()
+        {
+            glCheck(glPixelStorei(m_parameter, m_alignment));
+        }
+
+    private:
+
+        GLenum m_parameter;
+        GLint  m_alignment;
+    };
 }
 
 
@@ -62,6 +137,7 @@ namespace sf
 Texture::Texture() :
 m_size         (0, 0),
 m_actualSize   (0, 0),
+m_format       (Image::RGBA8),
 m_texture      (0),
 m_isSmooth     (false),
 m_sRgb         (false),
@@ -78,6 +154,7 @@ m_cacheId      (getUniqueId())
 Texture::Texture(const Texture& copy) :
 m_size         (0, 0),
 m_actualSize   (0, 0),
+m_format       (Image::RGBA8),
 m_texture      (0),
 m_isSmooth     (copy.m_isSmooth),
 m_sRgb         (copy.m_sRgb),
@@ -89,7 +166,7 @@ m_cacheId      (getUniqueId())
 {
     if (copy.m_texture)
     {
-        if (create(copy.getSize().x, copy.getSize().y))
+        if (create(copy.getSize().x, copy.getSize().y, copy.m_format))
         {
             update(copy);
 
@@ -120,7 +197,7 @@ Texture::~Texture()
 
 
 ////////////////////////////////////////////////////////////
-bool Texture::create(unsigned int width, unsigned int height)
+bool Texture::create(unsigned int width, unsigned int height, Image::PixelFormat format)
 {
     // Check if texture parameters are valid before creating it
     if ((width == 0) || (height == 0))
@@ -143,15 +220,28 @@ bool Texture::create(unsigned int width, unsigned int height)
         return false;
     }
 
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    // Check that the pixel format is supported
+    const char* missingExtension = getMissingExtension(format);
+    if (missingExtension)
+    {
+        err() << "Failed to create texture, its pixel format is unsupported "
+              << "(OpenGL extension " << missingExtension << " unavailable)" << std::endl;
+        return false;
+    }
+
     // All the validity checks passed, we can store the new texture settings
     m_size.x        = width;
     m_size.y        = height;
     m_actualSize    = actualSize;
+    m_format        = format;
     m_pixelsFlipped = false;
     m_fboAttachment = false;
 
-    TransientContextLock lock;
-
     // Create the OpenGL texture if it doesn't exist yet
     if (!m_texture)
     {
@@ -160,9 +250,6 @@ bool Texture::create(unsigned int width, unsigned int height)
         m_texture = static_cast<unsigned int>(texture);
     }
 
-    // Make sure that extensions are initialized
-    priv::ensureExtensionsInit();
-
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
@@ -204,8 +291,12 @@ bool Texture::create(unsigned int width, unsigned int height)
     }
 
     // Initialize the texture
+    GLint  internalFormat;
+    GLenum pixelFormat;
+    GLenum type;
+    getGlFormat(m_format, m_sRgb, internalFormat, pixelFormat, type);
     glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA), m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_actualSize.x, m_actualSize.y, 0, pixelFormat, type, NULL));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
@@ -254,7 +345,7 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
        ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
     {
         // Load the entire image
-        if (create(image.getSize().x, image.getSize().y))
+        if (create(image.getSize().x, image.getSize().y, image.getPixelFormat()))
         {
             update(image);
 
@@ -277,20 +368,26 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
         if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
 
         // Create the texture and upload the pixels
-        if (create(rectangle.width, rectangle.height))
+        if (create(rectangle.width, rectangle.height, image.getPixelFormat()))
         {
             TransientContextLock lock;
 
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
+            GLint  internalFormat;
+            GLenum pixelFormat;
+            GLenum type;
+            getGlFormat(m_format, m_sRgb, internalFormat, pixelFormat, type);
+
             // Copy the pixels to the texture, row by row
-            const Uint8* pixels = image.getPixelsPtr() + 4 * (rectangle.left + (width * rectangle.top));
+            std::size_t  pixelSize = Image::getPixelSize(m_format);
+            const Uint8* pixels    = image.getPixelsPtr() + pixelSize * (rectangle.left + (width * rectangle.top));
             glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
             for (int i = 0; i < rectangle.height; ++i)
             {
-                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-                pixels += 4 * width;
+                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, pixelFormat, type, pixels));
+                pixels += pixelSize * width;
             }
 
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
@@ -317,6 +414,13 @@ Vector2u Texture::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+Image::PixelFormat Texture::getPixelFormat() const
+{
+    return m_format;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image Texture::copyToImage() const
 {
@@ -329,11 +433,11 @@ Image Texture::copyToImage() const
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
+#ifdef SFML_OPENGL_ES
+
     // Create an array of pixels
     std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
 
-#ifdef SFML_OPENGL_ES
-
     // OpenGL ES doesn't have the glGetTexImage function, the only way to read
     // from a texture is to bind it to a FBO and use glReadPixels
     GLuint frameBuffer = 0;
@@ -351,28 +455,47 @@ Image Texture::copyToImage() const
         glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
     }
 
+    // Only RGBA8 is guaranteed to be readable, convert to the format of the texture
+    Image image;
+    image.create(m_size.x, m_size.y, &pixels[0]);
+    image.convert(m_format);
+
+    return image;
+
 #else
 
+    GLint  internalFormat;
+    GLenum pixelFormat;
+    GLenum type;
+    getGlFormat(m_format, m_sRgb, internalFormat, pixelFormat, type);
+
+    // Create an array of pixels
+    std::size_t pixelSize = Image::getPixelSize(m_format);
+    std::vector<Uint8> pixels(m_size.x * m_size.y * pixelSize);
+
+    // Read tightly packed rows
+    RowAlignmentSaver alignment(GL_PACK_ALIGNMENT);
+
     if ((m_size == m_actualSize) && !m_pixelsFlipped)
     {
         // Texture is not padded nor flipped, we can use a direct copy
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, pixelFormat, type, &pixels[0]));
     }
     else
     {
         // Texture is either padded or flipped, we have to use a slower algorithm
 
         // All the pixels will first be copied to a temporary array
-        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * 4);
+        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * pixelSize);
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &allPixels[0]));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, pixelFormat, type, &allPixels[0]));
 
         // Then we copy the useful pixels from the temporary array to the final one
         const Uint8* src = &allPixels[0];
         Uint8* dst = &pixels[0];
-        int srcPitch = m_actualSize.x * 4;
-        int dstPitch = m_size.x * 4;
+        int srcPitch = m_actualSize.x * static_cast<int>(pixelSize);
+        int dstPitch = m_size.x * static_cast<int>(pixelSize);
 
         // Handle the case where source pixels are flipped vertically
         if (m_pixelsFlipped)
@@ -389,13 +512,13 @@ Image Texture::copyToImage() const
         }
     }
 
-#endif // SFML_OPENGL_ES
-
     // Create the image
     Image image;
-    image.create(m_size.x, m_size.y, &pixels[0]);
+    image.create(m_size.x, m_size.y, &pixels[0], m_format);
 
     return image;
+
+#endif // SFML_OPENGL_ES
 }
 
 
@@ -420,9 +543,15 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
-        // Copy pixels from the given array to the texture
+        GLint  internalFormat;
+        GLenum pixelFormat;
+        GLenum type;
+        getGlFormat(m_format, m_sRgb, internalFormat, pixelFormat, type);
+
+        // Copy pixels from the given array to the texture, its rows being tightly packed
+        RowAlignmentSaver alignment(GL_UNPACK_ALIGNMENT);
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, pixelFormat, type, pixels));
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
         m_hasMipmap = false;
         m_pixelsFlipped = false;
@@ -530,14 +659,24 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
 void Texture::update(const Image& image)
 {
     // Update the whole texture
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, 0, 0);
+    update(image, 0, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Texture::update(const Image& image, unsigned int x, unsigned int y)
 {
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
+    if (image.getPixelFormat() != m_format)
+    {
+        // Convert the pixels to the format of the texture
+        Image converted(image);
+        converted.convert(m_format);
+        update(converted.getPixelsPtr(), converted.getSize().x, converted.getSize().y, x, y);
+    }
+    else
+    {
+        update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
+    }
 }
 
 
@@ -699,6 +838,80 @@ bool Texture::generateMipmap()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::updateMipmap(const std::vector<Image>& levels)
+{
+    if (!m_texture)
+        return false;
+
+    // Levels are computed for the actual content, not for a padded texture
+    if (m_actualSize != m_size)
+    {
+        err() << "Failed to upload mipmap, the texture size is not a power of two and "
+              << "non power of two textures are not supported" << std::endl;
+        return false;
+    }
+
+    // Check that the levels form the whole chain of the texture
+    Vector2u size = m_size;
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        size = Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+        if (levels[i].getSize() != size)
+        {
+            err() << "Failed to upload mipmap, level " << (i + 1) << " should be "
+                  << size.x << "x" << size.y << " but is "
+                  << levels[i].getSize().x << "x" << levels[i].getSize().y << std::endl;
+            return false;
+        }
+    }
+
+    if ((size.x != 1) || (size.y != 1))
+    {
+        err() << "Failed to upload mipmap, levels are missing after " << size.x << "x" << size.y << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    GLint  internalFormat;
+    GLenum pixelFormat;
+    GLenum type;
+    getGlFormat(m_format, m_sRgb, internalFormat, pixelFormat, type);
+
+    // Levels are uploaded in the format of the texture, with tightly packed rows
+    RowAlignmentSaver alignment(GL_UNPACK_ALIGNMENT);
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        Image converted;
+        const Image* level = &levels[i];
+        if (level->getPixelFormat() != m_format)
+        {
+            converted = *level;
+            converted.convert(m_format);
+            level = &converted;
+        }
+
+        Vector2u levelSize = level->getSize();
+        glCheck(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i + 1), internalFormat,
+                             levelSize.x, levelSize.y, 0, pixelFormat, type, level->getPixelsPtr()));
+    }
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+
+    m_hasMipmap = true;
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::invalidateMipmap()
 {
@@ -810,6 +1023,7 @@ void Texture::swap(Texture& right)
 {
     std::swap(m_size,          right.m_size);
     std::swap(m_actualSize,    right.m_actualSize);
+    std::swap(m_format,        right.m_format);
     std::swap(m_texture,       right.m_texture);
     std::swap(m_isSmooth,      right.m_isSmooth);
     std::swap(m_sRgb,          right.m_sRgb);
@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Convert a local coordinate to a chunk index, clamped to [0, count)
+    unsigned int toChunk(float coordinate, float chunkLength, unsigned int count)
+    {
+        float index = std::floor(coordinate / chunkLength);
+        if (index < 0)
+            return 0;
+        if (index >= static_cast<float>(count))
+            return count - 1;
+        return static_cast<unsigned int>(index);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_tileset    (NULL),
+m_tileSize   (0, 0),
+m_width      (0),
+m_height     (0),
+m_chunkSize  (0),
+m_chunkCountX(0),
+m_chunkCountY(0),
+m_tiles      (),
+m_chunks     ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::create(const Texture& tileset, const Vector2u& tileSize, unsigned int width, unsigned int height, unsigned int chunkSize)
+{
+    m_tileset     = &tileset;
+    m_tileSize    = tileSize;
+    m_width       = width;
+    m_height      = height;
+    m_chunkSize   = std::max(chunkSize, 1u);
+    m_chunkCountX = (width + m_chunkSize - 1) / m_chunkSize;
+    m_chunkCountY = (height + m_chunkSize - 1) / m_chunkSize;
+
+    m_tiles.assign(width * height, -1);
+
+    Chunk empty;
+    empty.dirty = false;
+    m_chunks.assign(m_chunkCountX * m_chunkCountY, empty);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int x, unsigned int y, int tile)
+{
+    if ((x >= m_width) || (y >= m_height))
+        return;
+
+    int& current = m_tiles[x + y * m_width];
+    if (current == tile)
+        return;
+
+    current = tile;
+    m_chunks[x / m_chunkSize + (y / m_chunkSize) * m_chunkCountX].dirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTiles(const int* tiles)
+{
+    if (m_tiles.empty())
+        return;
+
+    std::copy(tiles, tiles + m_tiles.size(), m_tiles.begin());
+
+    for (std::vector<Chunk>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        it->dirty = true;
+}
+
+
+////////////////////////////////////////////////////////////
+int TileMap::getTile(unsigned int x, unsigned int y) const
+{
+    if ((x >= m_width) || (y >= m_height))
+        return -1;
+
+    return m_tiles[x + y * m_width];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getSize() const
+{
+    return Vector2u(m_width, m_height);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TileMap::getChunkSize() const
+{
+    return m_chunkSize;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTileset() const
+{
+    return m_tileset;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_width * m_tileSize.x), static_cast<float>(m_height * m_tileSize.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_chunks.empty() || (m_tileSize.x == 0) || (m_tileSize.y == 0))
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_tileset;
+
+    // Find the area of the map covered by the view: map the corners of the
+    // view from normalized device coordinates back to the local coordinates
+    // of the map, so that rotated views and transformed maps are handled too
+    Transform toLocal = states.transform.getInverse() * target.getView().getInverseTransform();
+    Vector2f corners[4] =
+    {
+        toLocal.transformPoint(-1.f, -1.f),
+        toLocal.transformPoint( 1.f, -1.f),
+        toLocal.transformPoint(-1.f,  1.f),
+        toLocal.transformPoint( 1.f,  1.f)
+    };
+
+    float left   = corners[0].x;
+    float top    = corners[0].y;
+    float right  = corners[0].x;
+    float bottom = corners[0].y;
+    for (int i = 1; i < 4; ++i)
+    {
+        left   = std::min(left, corners[i].x);
+        top    = std::min(top, corners[i].y);
+        right  = std::max(right, corners[i].x);
+        bottom = std::max(bottom, corners[i].y);
+    }
+
+    // Skip the map entirely if it is out of sight
+    FloatRect bounds = getLocalBounds();
+    if ((right < 0) || (bottom < 0) || (left > bounds.width) || (top > bounds.height))
+        return;
+
+    // Draw the visible chunks, rebuilding the modified ones on the way
+    float chunkWidth  = static_cast<float>(m_chunkSize * m_tileSize.x);
+    float chunkHeight = static_cast<float>(m_chunkSize * m_tileSize.y);
+    unsigned int firstX = toChunk(left, chunkWidth, m_chunkCountX);
+    unsigned int firstY = toChunk(top, chunkHeight, m_chunkCountY);
+    unsigned int lastX  = toChunk(right, chunkWidth, m_chunkCountX);
+    unsigned int lastY  = toChunk(bottom, chunkHeight, m_chunkCountY);
+
+    for (unsigned int y = firstY; y <= lastY; ++y)
+    {
+        for (unsigned int x = firstX; x <= lastX; ++x)
+        {
+            Chunk& chunk = m_chunks[x + y * m_chunkCountX];
+            if (chunk.dirty)
+                updateChunk(x, y);
+
+            if (!chunk.vertices.empty())
+                target.draw(&chunk.vertices[0], chunk.vertices.size(), Triangles, states);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::updateChunk(unsigned int x, unsigned int y) const
+{
+    Chunk& chunk = m_chunks[x + y * m_chunkCountX];
+    chunk.vertices.clear();
+    chunk.dirty = false;
+
+    unsigned int columns = m_tileSize.x > 0 ? m_tileset->getSize().x / m_tileSize.x : 0;
+    if (columns == 0)
+        return;
+
+    float tileWidth  = static_cast<float>(m_tileSize.x);
+    float tileHeight = static_cast<float>(m_tileSize.y);
+
+    unsigned int beginX = x * m_chunkSize;
+    unsigned int beginY = y * m_chunkSize;
+    unsigned int endX   = std::min(beginX + m_chunkSize, m_width);
+    unsigned int endY   = std::min(beginY + m_chunkSize, m_height);
+
+    for (unsigned int j = beginY; j < endY; ++j)
+    {
+        for (unsigned int i = beginX; i < endX; ++i)
+        {
+            int tile = m_tiles[i + j * m_width];
+            if (tile < 0)
+                continue;
+
+            float left   = i * tileWidth;
+            float top    = j * tileHeight;
+            float right  = left + tileWidth;
+            float bottom = top + tileHeight;
+
+            float u = static_cast<float>((tile % columns) * m_tileSize.x);
+            float v = static_cast<float>((tile / columns) * m_tileSize.y);
+
+            chunk.vertices.push_back(Vertex(Vector2f(left, top), Vector2f(u, v)));
+            chunk.vertices.push_back(Vertex(Vector2f(right, top), Vector2f(u + tileWidth, v)));
+            chunk.vertices.push_back(Vertex(Vector2f(left, bottom), Vector2f(u, v + tileHeight)));
+            chunk.vertices.push_back(Vertex(Vector2f(left, bottom), Vector2f(u, v + tileHeight)));
+            chunk.vertices.push_back(Vertex(Vector2f(right, top), Vector2f(u + tileWidth, v)));
+            chunk.vertices.push_back(Vertex(Vector2f(right, bottom), Vector2f(u + tileWidth, v + tileHeight)));
+        }
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,480 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VirtualText.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Number of lines whose geometry is built and drawn together
+    const std::size_t linesPerBlock = 16;
+
+    // Add an underline or strike through line to the vertex array
+    void addLine(std::vector<sf::Vertex>& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness)
+    {
+        float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
+        float bottom = top + std::floor(thickness + 0.5f);
+
+        vertices.push_back(sf::Vertex(sf::Vector2f(0,          top),    color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength, top),    color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(0,          bottom), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(0,          bottom), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength, top),    color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength, bottom), color, sf::Vector2f(1, 1)));
+    }
+
+    // Add a glyph quad to the vertex array
+    void addGlyphQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italic)
+    {
+        float left   = glyph.bounds.left;
+        float top    = glyph.bounds.top;
+        float right  = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+        float u1 = static_cast<float>(glyph.textureRect.left);
+        float v1 = static_cast<float>(glyph.textureRect.top);
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
+
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italic * top,    position.y + top),    color, sf::Vector2f(u1, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italic * top,    position.y + top),    color, sf::Vector2f(u2, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italic * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italic * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italic * top,    position.y + top),    color, sf::Vector2f(u2, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italic * bottom, position.y + bottom), color, sf::Vector2f(u2, v2)));
+    }
+
+    // Convert a local vertical coordinate to a line index, clamped to [0, count)
+    std::size_t toLine(float coordinate, float lineSpacing, std::size_t count)
+    {
+        float index = std::floor(coordinate / lineSpacing);
+        if (index < 0)
+            return 0;
+        if (index >= static_cast<float>(count))
+            return count - 1;
+        return static_cast<std::size_t>(index);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VirtualText::VirtualText() :
+m_string               (),
+m_font                 (NULL),
+m_characterSize        (30),
+m_style                (Text::Regular),
+m_fillColor            (255, 255, 255),
+m_clipRect             (),
+m_lineStarts           (1, 0),
+m_blocks               (1),
+m_builtBlocks          (),
+m_fontTextureGeneration(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VirtualText::VirtualText(const String& string, const Font& font, unsigned int characterSize) :
+m_string               (string),
+m_font                 (&font),
+m_characterSize        (characterSize),
+m_style                (Text::Regular),
+m_fillColor            (255, 255, 255),
+m_clipRect             (),
+m_lineStarts           (1, 0),
+m_blocks               (),
+m_builtBlocks          (),
+m_fontTextureGeneration(0)
+{
+    indexLines(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::setString(const String& string)
+{
+    m_string = string;
+
+    releaseBlocks();
+    m_lineStarts.assign(1, 0);
+    indexLines(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::append(const String& string)
+{
+    if (string.isEmpty())
+        return;
+
+    std::size_t begin = m_string.getSize();
+    m_string += string;
+
+    // The last line may continue in the new characters
+    m_blocks[(m_lineStarts.size() - 1) / linesPerBlock].built = false;
+
+    indexLines(begin);
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::setFont(const Font& font)
+{
+    if (m_font != &font)
+    {
+        m_font = &font;
+        releaseBlocks();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::setCharacterSize(unsigned int size)
+{
+    if (m_characterSize != size)
+    {
+        m_characterSize = size;
+        releaseBlocks();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::setStyle(Uint32 style)
+{
+    if (m_style != style)
+    {
+        m_style = style;
+        releaseBlocks();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::setFillColor(const Color& color)
+{
+    if (color != m_fillColor)
+    {
+        m_fillColor = color;
+
+        // Change vertex colors directly, no need to rebuild the blocks
+        for (std::vector<std::size_t>::const_iterator it = m_builtBlocks.begin(); it != m_builtBlocks.end(); ++it)
+        {
+            std::vector<Vertex>& vertices = m_blocks[*it].vertices;
+            for (std::size_t i = 0; i < vertices.size(); ++i)
+                vertices[i].color = m_fillColor;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::setClipRect(const FloatRect& rect)
+{
+    m_clipRect = rect;
+}
+
+
+////////////////////////////////////////////////////////////
+const String& VirtualText::getString() const
+{
+    return m_string;
+}
+
+
+////////////////////////////////////////////////////////////
+const Font* VirtualText::getFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VirtualText::getCharacterSize() const
+{
+    return m_characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 VirtualText::getStyle() const
+{
+    return m_style;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& VirtualText::getFillColor() const
+{
+    return m_fillColor;
+}
+
+
+////////////////////////////////////////////////////////////
+const FloatRect& VirtualText::getClipRect() const
+{
+    return m_clipRect;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VirtualText::getLineCount() const
+{
+    return m_lineStarts.size();
+}
+
+
+////////////////////////////////////////////////////////////
+float VirtualText::getLineSpacing() const
+{
+    return m_font ? m_font->getLineSpacing(m_characterSize) : 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::draw(RenderTarget& target, RenderStates states) const
+{
+    float lineSpacing = getLineSpacing();
+    if (lineSpacing <= 0)
+        return;
+
+    states.transform *= getTransform();
+    states.texture = &m_font->getTexture(m_characterSize);
+
+    // Find the vertical range to display
+    float top;
+    float bottom;
+    if ((m_clipRect.width > 0) && (m_clipRect.height > 0))
+    {
+        top    = m_clipRect.top;
+        bottom = m_clipRect.top + m_clipRect.height;
+    }
+    else
+    {
+        // Map the corners of the view from normalized device coordinates back to
+        // the local coordinates of the text, so that rotated views are handled too
+        Transform toLocal = states.transform.getInverse() * target.getView().getInverseTransform();
+        Vector2f corners[4] =
+        {
+            toLocal.transformPoint(-1.f, -1.f),
+            toLocal.transformPoint( 1.f, -1.f),
+            toLocal.transformPoint(-1.f,  1.f),
+            toLocal.transformPoint( 1.f,  1.f)
+        };
+
+        top    = corners[0].y;
+        bottom = corners[0].y;
+        for (int i = 1; i < 4; ++i)
+        {
+            top    = std::min(top, corners[i].y);
+            bottom = std::max(bottom, corners[i].y);
+        }
+    }
+
+    // Glyphs can overflow their line a little (accents, descenders): extend the range by a character size
+    float characterSize = static_cast<float>(m_characterSize);
+    top    -= characterSize;
+    bottom += characterSize;
+
+    // Skip the text entirely if it is out of sight
+    std::size_t lineCount = m_lineStarts.size();
+    if ((bottom < 0) || (top > static_cast<float>(lineCount) * lineSpacing))
+        return;
+
+    // Find the visible blocks
+    std::size_t firstBlock = toLine(top, lineSpacing, lineCount) / linesPerBlock;
+    std::size_t lastBlock  = toLine(bottom, lineSpacing, lineCount) / linesPerBlock;
+
+    // Glyphs may have moved in the font texture since the blocks were built
+    if (m_font->getTextureGeneration() != m_fontTextureGeneration)
+        releaseBlocks();
+
+    // Build the visible blocks that are not built yet; if this moves the glyphs
+    // of the font texture (glyphs had to be evicted), start over
+    for (;;)
+    {
+        m_fontTextureGeneration = m_font->getTextureGeneration();
+
+        for (std::size_t i = firstBlock; i <= lastBlock; ++i)
+        {
+            if (!m_blocks[i].built)
+                buildBlock(i);
+        }
+
+        if (m_font->getTextureGeneration() == m_fontTextureGeneration)
+            break;
+
+        releaseBlocks();
+    }
+
+    // Draw them
+    for (std::size_t i = firstBlock; i <= lastBlock; ++i)
+    {
+        const std::vector<Vertex>& vertices = m_blocks[i].vertices;
+        if (!vertices.empty())
+            target.draw(&vertices[0], vertices.size(), Triangles, states);
+    }
+
+    // Release the blocks that are more than one screen away from the visible ones,
+    // keeping the others for when the text is scrolled
+    std::size_t margin = lastBlock - firstBlock + 1;
+    for (std::size_t i = 0; i < m_builtBlocks.size();)
+    {
+        std::size_t index = m_builtBlocks[i];
+        if ((index + margin < firstBlock) || (index > lastBlock + margin))
+        {
+            m_blocks[index].built = false;
+            std::vector<Vertex>().swap(m_blocks[index].vertices);
+            m_builtBlocks[i] = m_builtBlocks.back();
+            m_builtBlocks.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::buildBlock(std::size_t index) const
+{
+    Block& block = m_blocks[index];
+    block.vertices.clear();
+    block.built = true;
+
+    // Blocks are built only when visible, so keep track of them to release them later
+    if (std::find(m_builtBlocks.begin(), m_builtBlocks.end(), index) == m_builtBlocks.end())
+        m_builtBlocks.push_back(index);
+
+    // Compute values related to the text style
+    bool  bold          = (m_style & Text::Bold) != 0;
+    bool  underlined    = (m_style & Text::Underlined) != 0;
+    bool  strikeThrough = (m_style & Text::StrikeThrough) != 0;
+    float italic        = (m_style & Text::Italic) ? 0.208f : 0.f; // 12 degrees
+
+    float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
+    float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
+
+    // Compute the location of the strike through from the center of the lowercase 'x' glyph, like sf::Text
+    FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, bold).bounds;
+    float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+
+    // Precompute the variables needed by the algorithm
+    float hspace = m_font->getGlyph(L' ', m_characterSize, bold).advance;
+    float vspace = m_font->getLineSpacing(m_characterSize);
+
+    std::size_t firstLine = index * linesPerBlock;
+    std::size_t lastLine  = std::min(firstLine + linesPerBlock, m_lineStarts.size());
+    for (std::size_t line = firstLine; line < lastLine; ++line)
+    {
+        // Lines don't include their line break
+        std::size_t begin = m_lineStarts[line];
+        std::size_t end   = (line + 1 < m_lineStarts.size()) ? m_lineStarts[line + 1] - 1 : m_string.getSize();
+
+        float x = 0.f;
+        float y = static_cast<float>(m_characterSize) + static_cast<float>(line) * vspace;
+
+        // Create one quad for each character
+        Uint32 prevChar = 0;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            Uint32 curChar = m_string[i];
+
+            // Apply the kerning offset
+            x += m_font->getKerning(prevChar, curChar, m_characterSize);
+            prevChar = curChar;
+
+            // Handle special characters
+            if (curChar == ' ')
+            {
+                x += hspace;
+                continue;
+            }
+            else if (curChar == '\t')
+            {
+                x += hspace * 4;
+                continue;
+            }
+
+            // Add the glyph to the vertices
+            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
+            addGlyphQuad(block.vertices, Vector2f(x, y), m_fillColor, glyph, italic);
+
+            // Advance to the next character
+            x += glyph.advance;
+        }
+
+        // Add the underline and strike through of the line
+        if (x > 0)
+        {
+            if (underlined)
+                addLine(block.vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+
+            if (strikeThrough)
+                addLine(block.vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::releaseBlocks() const
+{
+    for (std::vector<std::size_t>::const_iterator it = m_builtBlocks.begin(); it != m_builtBlocks.end(); ++it)
+    {
+        m_blocks[*it].built = false;
+        std::vector<Vertex>().swap(m_blocks[*it].vertices);
+    }
+
+    m_builtBlocks.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void VirtualText::indexLines(std::size_t begin)
+{
+    const Uint32* data = m_string.getData();
+    std::size_t size = m_string.getSize();
+
+    for (std::size_t i = begin; i < size; ++i)
+    {
+        if (data[i] == '\n')
+            m_lineStarts.push_back(i + 1);
+    }
+
+    m_blocks.resize((m_lineStarts.size() + linesPerBlock - 1) / linesPerBlock);
+}
+
+} // namespace sf